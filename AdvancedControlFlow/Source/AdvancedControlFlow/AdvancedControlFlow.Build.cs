@@ -22,9 +22,13 @@ public class AdvancedControlFlow : ModuleRules
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[]{
+			"AdvancedControlFlowRuntime",
+			"AssetRegistry",
 			"BlueprintGraph",
 			"EditorStyle",
 			"GraphEditor",
+			"Json",
+			"Kismet",
 			"KismetCompiler",
 			"Slate",
 			"SlateCore",
@@ -32,6 +36,12 @@ public class AdvancedControlFlow : ModuleRules
 			"UnrealEd",
 		});
 
+		// Multi-Branch on Change checks the source class on compile.
+		if ((Target.Version.MajorVersion > 5) || ((Target.Version.MajorVersion == 5) && (Target.Version.MinorVersion >= 1)))
+		{
+			PrivateDependencyModuleNames.Add("FieldNotification");
+		}
+
 		// @remove-start FULL_VERSION=true
 		PublicDefinitions.Add("ACF_FREE_VERSION");
 		// @remove-end
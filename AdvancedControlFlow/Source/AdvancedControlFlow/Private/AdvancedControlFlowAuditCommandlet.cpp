@@ -0,0 +1,273 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowAuditCommandlet.h"
+
+#include "AdvancedControlFlowAuditCompilerExtension.h"
+#include "AdvancedControlFlowCompilerUtils.h"
+#include "AdvancedControlFlowRuntimeModule.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "K2Node_ConditionalSequence.h"
+#include "K2Node_MultiBranch.h"
+#include "K2Node_MultiConditionalSelect.h"
+#include "K2Node_ParallelConditionalSequence.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UnrealType.h"
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+#include "AssetRegistryModule.h"
+#else
+#include "AssetRegistry/AssetRegistryModule.h"
+#endif
+
+static UEdGraphPin* GetConditionPin(const UK2Node_CasePairedPinsNode* Node, const CasePinPair& Pair)
+{
+	// The condition is the value pin on Multi-Conditional Select, and the key pin on the nodes which branch on the bool
+	// conditions (including Multi-Branch on Change). The keys of the nodes which branch on a value (ex. Multi-Branch on Value)
+	// are the literals to compare with, so they have no condition.
+	if (Node->IsA<UK2Node_MultiConditionalSelect>())
+	{
+		return Pair.Value;
+	}
+	if (Node->IsA<UK2Node_MultiBranch>() || Node->IsA<UK2Node_ConditionalSequence>() ||
+		Node->IsA<UK2Node_ParallelConditionalSequence>())
+	{
+		return Pair.Key;
+	}
+
+	return nullptr;
+}
+
+// Sum up the bytes of the bytecode per node.
+// Each byte is counted for the node of the last debug site before it, so the result is an approximation by the debug data.
+// Only the bytes from the debug sites of the nodes to the next debug site are walked, instead of looking up every byte.
+static void CountBytecodeSizes(
+	UBlueprint* Blueprint, const TArray<UK2Node_CasePairedPinsNode*>& Nodes, TMap<const UEdGraphNode*, int32>& OutSizes)
+{
+	UBlueprintGeneratedClass* GeneratedClass = Cast<UBlueprintGeneratedClass>(Blueprint->GeneratedClass);
+	if (GeneratedClass == nullptr)
+	{
+		return;
+	}
+
+	const FBlueprintDebugData& DebugData = GeneratedClass->GetDebugData();
+	TArray<int32> Sites;
+	for (TFieldIterator<UFunction> It(GeneratedClass, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+	{
+		UFunction* Function = *It;
+		for (UK2Node_CasePairedPinsNode* Node : Nodes)
+		{
+			Sites.Reset();
+			DebugData.FindAllCodeLocationsFromSourceNode(Node, Function, Sites);
+			for (const int32 Site : Sites)
+			{
+				int32 End = Site + 1;
+				while (
+					(End < Function->Script.Num()) && (DebugData.FindSourceNodeFromCodeLocation(Function, End, false) == nullptr))
+				{
+					++End;
+				}
+				OutSizes.FindOrAdd(Node) += End - Site;
+			}
+		}
+	}
+}
+
+static FString QuoteCSV(const FString& Value)
+{
+	return FString::Printf(TEXT("\"%s\""), *Value.Replace(TEXT("\""), TEXT("\"\"")));
+}
+
+UAdvancedControlFlowAuditCommandlet::UAdvancedControlFlowAuditCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAdvancedControlFlowAuditCommandlet::Main(const FString& Params)
+{
+	FString PathsString = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Path="), PathsString, false);
+	TArray<FString> Paths;
+	PathsString.ParseIntoArray(Paths, TEXT(","));
+
+	int32 BatchSize = 16;
+	FParse::Value(*Params, TEXT("BatchSize="), BatchSize);
+	BatchSize = FMath::Max(BatchSize, 1);
+
+	FString OutputDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Audit"), TEXT("AdvancedControlFlow"));
+	FParse::Value(*Params, TEXT("Output="), OutputDir);
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+	Filter.ClassNames.Add(UBlueprint::StaticClass()->GetFName());
+#else
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+#endif
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+	for (const FString& Path : Paths)
+	{
+		Filter.PackagePaths.Add(FName(*Path.TrimStartAndEnd()));
+	}
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+	Assets.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+
+	UE_LOG(LogAdvancedControlFlow, Display, TEXT("Auditing %d Blueprints in batches of %d"), Assets.Num(), BatchSize);
+
+	// The packages of a batch are loaded in parallel by the async loading, and released by GC after they are audited.
+	TArray<FAdvancedControlFlowAuditEntry> Entries;
+	for (int32 BatchStart = 0; BatchStart < Assets.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, Assets.Num());
+		for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
+		{
+			LoadPackageAsync(Assets[Index].PackageName.ToString());
+		}
+		FlushAsyncLoading();
+
+		for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
+		{
+			UBlueprint* Blueprint = Cast<UBlueprint>(Assets[Index].GetAsset());
+			if (Blueprint == nullptr)
+			{
+				UE_LOG(LogAdvancedControlFlow, Warning, TEXT("Failed to load %s"), *Assets[Index].PackageName.ToString());
+				continue;
+			}
+			AuditBlueprint(Blueprint, Entries);
+		}
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		UE_LOG(LogAdvancedControlFlow, Display, TEXT("Audited %d/%d Blueprints"), BatchEnd, Assets.Num());
+	}
+
+	Entries.StableSort([](const FAdvancedControlFlowAuditEntry& A, const FAdvancedControlFlowAuditEntry& B)
+		{ return A.BytecodeSize > B.BytecodeSize; });
+
+	const FString JsonPath = FPaths::Combine(OutputDir, TEXT("AdvancedControlFlowAudit.json"));
+	const FString CSVPath = FPaths::Combine(OutputDir, TEXT("AdvancedControlFlowAudit.csv"));
+	if (!FFileHelper::SaveStringToFile(ToJson(Entries), *JsonPath) || !FFileHelper::SaveStringToFile(ToCSV(Entries), *CSVPath))
+	{
+		UE_LOG(LogAdvancedControlFlow, Error, TEXT("Failed to write the audit report to %s"), *OutputDir);
+		return 1;
+	}
+
+	UE_LOG(LogAdvancedControlFlow, Display, TEXT("Audit report of %d nodes is written to %s"), Entries.Num(), *OutputDir);
+
+	return 0;
+}
+
+void UAdvancedControlFlowAuditCommandlet::AuditBlueprint(UBlueprint* Blueprint, TArray<FAdvancedControlFlowAuditEntry>& OutEntries)
+{
+	TArray<UK2Node_CasePairedPinsNode*> Nodes;
+	FBlueprintEditorUtils::GetAllNodesOfClass(Blueprint, Nodes);
+	if (Nodes.Num() == 0)
+	{
+		return;
+	}
+
+	// Compile to update the bytecode, and count the intermediate nodes on the compile.
+	TMap<const UEdGraphNode*, int32> IntermediateNodeCounts;
+	{
+		TGuardValue<TMap<const UEdGraphNode*, int32>*> CountsGuard(
+			UAdvancedControlFlowAuditCompilerExtension::Get()->IntermediateNodeCounts, &IntermediateNodeCounts);
+		FCompilerResultsLog Results;
+		Results.bSilentMode = true;
+		FKismetEditorUtilities::CompileBlueprint(
+			Blueprint, EBlueprintCompileOptions::SkipGarbageCollection | EBlueprintCompileOptions::SkipSave, &Results);
+	}
+
+	TMap<const UEdGraphNode*, int32> BytecodeSizes;
+	CountBytecodeSizes(Blueprint, Nodes, BytecodeSizes);
+
+	for (UK2Node_CasePairedPinsNode* Node : Nodes)
+	{
+		FAdvancedControlFlowAuditEntry& Entry = OutEntries.AddDefaulted_GetRef();
+		Entry.BlueprintPath = Blueprint->GetPathName();
+		Entry.GraphName = (Node->GetGraph() != nullptr) ? Node->GetGraph()->GetName() : FString();
+		Entry.NodeClass = Node->GetClass()->GetName();
+		Entry.NodeGuid = Node->NodeGuid;
+		Entry.IntermediateNodeCount = IntermediateNodeCounts.FindRef(Node);
+		Entry.BytecodeSize = BytecodeSizes.FindRef(Node);
+
+		const TArray<CasePinPair> Pairs = Node->GetCasePinPairs();
+		Entry.CaseCount = Pairs.Num();
+		for (const CasePinPair& Pair : Pairs)
+		{
+			const UEdGraphPin* CondPin = GetConditionPin(Node, Pair);
+			bool bLiteralValue = false;
+			if ((CondPin != nullptr) && IsLiteralCondition(CondPin, bLiteralValue))
+			{
+				Entry.UnconnectedConditionCount++;
+				(bLiteralValue ? Entry.AlwaysTrueConditionCount : Entry.AlwaysFalseConditionCount)++;
+			}
+		}
+	}
+}
+
+FString UAdvancedControlFlowAuditCommandlet::ToJson(const TArray<FAdvancedControlFlowAuditEntry>& Entries)
+{
+	TArray<TSharedPtr<FJsonValue>> NodeValues;
+	for (const FAdvancedControlFlowAuditEntry& Entry : Entries)
+	{
+		TSharedRef<FJsonObject> NodeObject = MakeShared<FJsonObject>();
+		NodeObject->SetStringField(TEXT("Blueprint"), Entry.BlueprintPath);
+		NodeObject->SetStringField(TEXT("Graph"), Entry.GraphName);
+		NodeObject->SetStringField(TEXT("NodeClass"), Entry.NodeClass);
+		NodeObject->SetStringField(TEXT("NodeGuid"), Entry.NodeGuid.ToString());
+		NodeObject->SetNumberField(TEXT("CaseCount"), Entry.CaseCount);
+		NodeObject->SetNumberField(TEXT("UnconnectedConditions"), Entry.UnconnectedConditionCount);
+		NodeObject->SetNumberField(TEXT("AlwaysTrueConditions"), Entry.AlwaysTrueConditionCount);
+		NodeObject->SetNumberField(TEXT("AlwaysFalseConditions"), Entry.AlwaysFalseConditionCount);
+		NodeObject->SetNumberField(TEXT("BytecodeSize"), Entry.BytecodeSize);
+		NodeObject->SetNumberField(TEXT("IntermediateNodes"), Entry.IntermediateNodeCount);
+		NodeValues.Add(MakeShared<FJsonValueObject>(NodeObject));
+	}
+
+	TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+	RootObject->SetArrayField(TEXT("Nodes"), NodeValues);
+
+	FString Output;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	FJsonSerializer::Serialize(RootObject, Writer);
+
+	return Output;
+}
+
+FString UAdvancedControlFlowAuditCommandlet::ToCSV(const TArray<FAdvancedControlFlowAuditEntry>& Entries)
+{
+	FString Output = TEXT("Blueprint,Graph,NodeClass,NodeGuid,CaseCount,UnconnectedConditions,AlwaysTrueConditions,")
+					 TEXT("AlwaysFalseConditions,BytecodeSize,IntermediateNodes\n");
+	for (const FAdvancedControlFlowAuditEntry& Entry : Entries)
+	{
+		Output += FString::Printf(TEXT("%s,%s,%s,%s,%d,%d,%d,%d,%d,%d\n"), *QuoteCSV(Entry.BlueprintPath),
+			*QuoteCSV(Entry.GraphName), *QuoteCSV(Entry.NodeClass), *Entry.NodeGuid.ToString(), Entry.CaseCount,
+			Entry.UnconnectedConditionCount, Entry.AlwaysTrueConditionCount, Entry.AlwaysFalseConditionCount, Entry.BytecodeSize,
+			Entry.IntermediateNodeCount);
+	}
+
+	return Output;
+}
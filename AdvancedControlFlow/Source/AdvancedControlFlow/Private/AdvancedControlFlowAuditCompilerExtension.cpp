@@ -0,0 +1,53 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowAuditCompilerExtension.h"
+
+#include "BlueprintCompilationManager.h"
+#include "Engine/Blueprint.h"
+#include "K2Node_CasePairedPinsNode.h"
+#include "KismetCompiler.h"
+
+UAdvancedControlFlowAuditCompilerExtension* UAdvancedControlFlowAuditCompilerExtension::Get()
+{
+	// The compiler extension can not be unregistered, so one extension is kept for all audits.
+	static UAdvancedControlFlowAuditCompilerExtension* Extension = nullptr;
+	if (Extension == nullptr)
+	{
+		Extension = NewObject<UAdvancedControlFlowAuditCompilerExtension>();
+		Extension->AddToRoot();
+		FBlueprintCompilationManager::RegisterCompilerExtension(UBlueprint::StaticClass(), Extension);
+	}
+
+	return Extension;
+}
+
+void UAdvancedControlFlowAuditCompilerExtension::ProcessBlueprintCompiled(
+	const FKismetCompilerContext& CompilationContext, const FBlueprintCompiledData& Data)
+{
+	if (IntermediateNodeCounts == nullptr)
+	{
+		return;
+	}
+
+	// The message log maps the intermediate nodes (including the ones spawned by the other intermediate nodes) to the node on
+	// the source graph. The copy of the source node is also mapped to it, but it is not counted.
+	for (const UEdGraph* Graph : Data.IntermediateGraphs)
+	{
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			const UK2Node_CasePairedPinsNode* SourceNode =
+				Cast<UK2Node_CasePairedPinsNode>(CompilationContext.MessageLog.FindSourceObject(Node));
+			if ((SourceNode != nullptr) && !Node->IsA(SourceNode->GetClass()))
+			{
+				IntermediateNodeCounts->FindOrAdd(SourceNode)++;
+			}
+		}
+	}
+}
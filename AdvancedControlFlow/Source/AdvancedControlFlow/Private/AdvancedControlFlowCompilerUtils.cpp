@@ -0,0 +1,304 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowCompilerUtils.h"
+
+#include "AdvancedControlFlowLibrary.h"
+#include "EdGraphSchema_K2.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiledFunctionContext.h"
+
+const FString ScratchBoolTerminalName(TEXT("ACF_CmpSuccess"));
+const FString ScratchIntTerminalName(TEXT("ACF_Scratch"));
+
+static TAutoConsoleVariable<bool> CVarRecordCaseHits(TEXT("acf.RecordCaseHits"), false,
+	TEXT("If true, Multi-Branch, Conditional Sequence and Multi-Conditional Select nodes record the case hits.\n")
+		TEXT("Blueprints must be recompiled after this is changed. The hits are exported by acf.CaseHits.Export."));
+
+static TAutoConsoleVariable<bool> CVarTraceCases(TEXT("acf.TraceCases"), false,
+	TEXT("If true, Multi-Branch, Conditional Sequence and Multi-Conditional Select nodes trace the taken cases to ")
+		TEXT("AdvancedControlFlowChannel.\nBlueprints must be recompiled after this is changed. ")
+		TEXT("The events are captured only while the channel is enabled (ex. -trace=AdvancedControlFlow)."));
+
+// The cases less than or equal to this count are tested one by one instead of splitting to the binary decision tree.
+static const int32 LinearSearchCaseCount = 3;
+
+FBPTerminal* CreateLiteralTerminal(
+	FKismetFunctionContext& Context, UEdGraphNode* SourceNode, const FName& PinCategory, const FString& Value)
+{
+	FBPTerminal* Term = Context.CreateLocalTerminal(ETerminalSpecification::TS_Literal);
+	Term->Type.PinCategory = PinCategory;
+	Term->Source = SourceNode;
+	Term->Name = Value;
+
+	return Term;
+}
+
+bool IsLiteralCondition(const UEdGraphPin* CondPin, bool& bOutValue)
+{
+	if (CondPin->LinkedTo.Num() > 0)
+	{
+		return false;
+	}
+
+	bOutValue = CondPin->GetDefaultAsString().ToBool();
+
+	return true;
+}
+
+bool ShouldRecordCaseHits()
+{
+	return CVarRecordCaseHits.GetValueOnGameThread() && !IsRunningCommandlet();
+}
+
+bool ShouldTraceCases()
+{
+	return CVarTraceCases.GetValueOnGameThread() && !IsRunningCommandlet();
+}
+
+FName GetCaseHitCounterKey(const UEdGraphNode* Node)
+{
+	const UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForNode(Node);
+
+	return *FString::Printf(
+		TEXT("%s:%s"), (Blueprint != nullptr) ? *Blueprint->GetPathName() : TEXT("None"), *Node->NodeGuid.ToString());
+}
+
+FBPTerminal* CreateLibraryTerminal(FKismetFunctionContext& Context, UEdGraphNode* SourceNode)
+{
+	UClass* LibraryClass = UAdvancedControlFlowLibrary::StaticClass();
+	FBPTerminal* LibraryTerm = Context.CreateLocalTerminal(ETerminalSpecification::TS_Literal);
+	LibraryTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Object;
+	LibraryTerm->Type.PinSubCategoryObject = LibraryClass;
+	LibraryTerm->Source = SourceNode;
+	LibraryTerm->ObjectLiteral = LibraryClass->GetDefaultObject();
+
+	return LibraryTerm;
+}
+
+FBlueprintCompiledStatement& EmitRecordCaseHit(
+	FKismetFunctionContext& Context, UEdGraphNode* Node, int32 CaseIndex, int32 EvaluatedConditionCount)
+{
+	// The node on the compiled graph is the copy, so the key is made from the node on the source graph.
+	const UEdGraphNode* SourceNode = Cast<UEdGraphNode>(Context.MessageLog.FindSourceObject(Node));
+
+	FBlueprintCompiledStatement& CallFuncStatement = Context.AppendStatementForNode(Node);
+	CallFuncStatement.Type = KCST_CallFunction;
+	CallFuncStatement.FunctionToCall = FindUField<UFunction>(
+		UAdvancedControlFlowLibrary::StaticClass(), GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowLibrary, RecordCaseHit));
+	CallFuncStatement.FunctionContext = CreateLibraryTerminal(Context, Node);
+	CallFuncStatement.bIsParentContext = false;
+	CallFuncStatement.RHS.Add(CreateLiteralTerminal(Context, Node, UEdGraphSchema_K2::PC_Name,
+		GetCaseHitCounterKey((SourceNode != nullptr) ? SourceNode : Node).ToString()));
+	CallFuncStatement.RHS.Add(CreateLiteralTerminal(Context, Node, UEdGraphSchema_K2::PC_Int, FString::FromInt(CaseIndex)));
+	CallFuncStatement.RHS.Add(
+		CreateLiteralTerminal(Context, Node, UEdGraphSchema_K2::PC_Int, FString::FromInt(EvaluatedConditionCount)));
+
+	return CallFuncStatement;
+}
+
+static FBPTerminal* FindOrCreateScratchTerminal(
+	FKismetFunctionContext& Context, UEdGraphNode* SourceNode, const FString& Name, const FName& PinCategory)
+{
+	// Same as FKismetFunctionContext::CreateLocalTerminal, the terminal is added to the event graph locals on ubergraph.
+	TIndirectArray<FBPTerminal>& Terms = Context.IsEventGraph() ? Context.EventGraphLocals : Context.Locals;
+	for (FBPTerminal& Term : Terms)
+	{
+		if ((Term.Name == Name) && (Term.Type.PinCategory == PinCategory))
+		{
+			return &Term;
+		}
+	}
+
+	FBPTerminal* Term = Context.CreateLocalTerminal();
+	Term->Type.PinCategory = PinCategory;
+	Term->Source = SourceNode;
+	Term->Name = Name;
+
+	return Term;
+}
+
+FBPTerminal* FindOrCreateScratchBoolTerminal(FKismetFunctionContext& Context, UEdGraphNode* SourceNode)
+{
+	return FindOrCreateScratchTerminal(Context, SourceNode, ScratchBoolTerminalName, UEdGraphSchema_K2::PC_Boolean);
+}
+
+FBPTerminal* FindOrCreateScratchIntTerminal(FKismetFunctionContext& Context, UEdGraphNode* SourceNode)
+{
+	return FindOrCreateScratchTerminal(Context, SourceNode, ScratchIntTerminalName, UEdGraphSchema_K2::PC_Int);
+}
+
+FBPTerminal* FindOrCreateTraceStartTerminal(FKismetFunctionContext& Context, UEdGraphNode* Node)
+{
+	return FindOrCreateScratchTerminal(
+		Context, Node, FString::Printf(TEXT("ACF_TraceStart_%s"), *Node->GetName()), UEdGraphSchema_K2::PC_Int64);
+}
+
+FBPTerminal* FindOrCreateTraceCaseTerminal(FKismetFunctionContext& Context, UEdGraphNode* Node)
+{
+	return FindOrCreateScratchTerminal(
+		Context, Node, FString::Printf(TEXT("ACF_TraceCase_%s"), *Node->GetName()), UEdGraphSchema_K2::PC_Int);
+}
+
+FBlueprintCompiledStatement& EmitBeginTraceCase(FKismetFunctionContext& Context, UEdGraphNode* Node, FBPTerminal* StartTerm)
+{
+	FBlueprintCompiledStatement& CallFuncStatement = Context.AppendStatementForNode(Node);
+	CallFuncStatement.Type = KCST_CallFunction;
+	CallFuncStatement.FunctionToCall = FindUField<UFunction>(
+		UAdvancedControlFlowLibrary::StaticClass(), GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowLibrary, BeginTraceCase));
+	CallFuncStatement.FunctionContext = CreateLibraryTerminal(Context, Node);
+	CallFuncStatement.bIsParentContext = false;
+	CallFuncStatement.LHS = StartTerm;
+
+	return CallFuncStatement;
+}
+
+FBlueprintCompiledStatement& EmitTraceCaseTaken(
+	FKismetFunctionContext& Context, UEdGraphNode* Node, FBPTerminal* CaseIndexTerm, FBPTerminal* StartTerm)
+{
+	// Same key as the case hits, so that the traced node can be found in the same way.
+	const UEdGraphNode* SourceNode = Cast<UEdGraphNode>(Context.MessageLog.FindSourceObject(Node));
+
+	FBlueprintCompiledStatement& CallFuncStatement = Context.AppendStatementForNode(Node);
+	CallFuncStatement.Type = KCST_CallFunction;
+	CallFuncStatement.FunctionToCall = FindUField<UFunction>(
+		UAdvancedControlFlowLibrary::StaticClass(), GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowLibrary, TraceCaseTaken));
+	CallFuncStatement.FunctionContext = CreateLibraryTerminal(Context, Node);
+	CallFuncStatement.bIsParentContext = false;
+	CallFuncStatement.LHS = StartTerm;
+	CallFuncStatement.RHS.Add(CreateLiteralTerminal(Context, Node, UEdGraphSchema_K2::PC_Name,
+		GetCaseHitCounterKey((SourceNode != nullptr) ? SourceNode : Node).ToString()));
+	CallFuncStatement.RHS.Add(CaseIndexTerm);
+	CallFuncStatement.RHS.Add(StartTerm);
+
+	return CallFuncStatement;
+}
+
+FBlueprintCompiledStatement& EmitTraceCaseTaken(
+	FKismetFunctionContext& Context, UEdGraphNode* Node, int32 CaseIndex, FBPTerminal* StartTerm)
+{
+	return EmitTraceCaseTaken(
+		Context, Node, CreateLiteralTerminal(Context, Node, UEdGraphSchema_K2::PC_Int, FString::FromInt(CaseIndex)), StartTerm);
+}
+
+// BoolTerm = Function(Selection, Key)
+// GotoIfNot BoolTerm -> (Set by the caller)
+static FBlueprintCompiledStatement& EmitCompare(FKismetFunctionContext& Context, const FDispatchTreeContext& TreeContext,
+	UFunction* Function, FBPTerminal* KeyTerm, FBlueprintCompiledStatement*& OutGotoIfNotStatement)
+{
+	FBlueprintCompiledStatement& CallFuncStatement = Context.AppendStatementForNode(TreeContext.Node);
+	CallFuncStatement.Type = KCST_CallFunction;
+	CallFuncStatement.FunctionToCall = Function;
+	CallFuncStatement.FunctionContext = TreeContext.FunctionContext;
+	CallFuncStatement.bIsParentContext = false;
+	CallFuncStatement.LHS = TreeContext.BoolTerm;
+	CallFuncStatement.RHS.Add(TreeContext.SelectionTerm);
+	CallFuncStatement.RHS.Add(KeyTerm);
+
+	FBlueprintCompiledStatement& GotoIfNotStatement = Context.AppendStatementForNode(TreeContext.Node);
+	GotoIfNotStatement.Type = KCST_GotoIfNot;
+	GotoIfNotStatement.LHS = TreeContext.BoolTerm;
+	OutGotoIfNotStatement = &GotoIfNotStatement;
+
+	return CallFuncStatement;
+}
+
+static FBlueprintCompiledStatement& EmitGoto(
+	FKismetFunctionContext& Context, const FDispatchTreeContext& TreeContext, UEdGraphPin* ExecPin)
+{
+	FBlueprintCompiledStatement& GotoStatement = Context.AppendStatementForNode(TreeContext.Node);
+	GotoStatement.Type = KCST_UnconditionalGoto;
+	Context.GotoFixupRequestMap.Add(&GotoStatement, ExecPin);
+
+	return GotoStatement;
+}
+
+static void SetJumpTarget(FBlueprintCompiledStatement* GotoIfNotStatement, FBlueprintCompiledStatement& TargetStatement)
+{
+	GotoIfNotStatement->TargetLabel = &TargetStatement;
+	TargetStatement.bIsJumpTarget = true;
+}
+
+// The result is the first case in [Begin, End) whose threshold is greater than the value, or default (End == Cases.Num()).
+static FBlueprintCompiledStatement& EmitLessThanTree(FKismetFunctionContext& Context, const FDispatchTreeContext& TreeContext,
+	const TArray<FDispatchTreeCase>& Cases, int32 Begin, int32 End)
+{
+	if (Begin == End)
+	{
+		UEdGraphPin* ExecPin = Cases.IsValidIndex(Begin) ? Cases[Begin].ExecPin : TreeContext.DefaultExecPin;
+		return EmitGoto(Context, TreeContext, ExecPin);
+	}
+
+	const int32 Mid = (Begin + End) / 2;
+	FBlueprintCompiledStatement* GotoIfNotStatement = nullptr;
+	FBlueprintCompiledStatement& FirstStatement =
+		EmitCompare(Context, TreeContext, TreeContext.LessFunction, Cases[Mid].KeyTerm, GotoIfNotStatement);
+	EmitLessThanTree(Context, TreeContext, Cases, Begin, Mid);
+	SetJumpTarget(GotoIfNotStatement, EmitLessThanTree(Context, TreeContext, Cases, Mid + 1, End));
+
+	return FirstStatement;
+}
+
+// The result is the case in [Begin, End) whose key is equal to the value, or default.
+static FBlueprintCompiledStatement& EmitEqualTree(FKismetFunctionContext& Context, const FDispatchTreeContext& TreeContext,
+	const TArray<FDispatchTreeCase>& Cases, int32 Begin, int32 End)
+{
+	if (End - Begin <= LinearSearchCaseCount)
+	{
+		FBlueprintCompiledStatement* FirstStatement = nullptr;
+		FBlueprintCompiledStatement* PrevGotoIfNotStatement = nullptr;
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			FBlueprintCompiledStatement* GotoIfNotStatement = nullptr;
+			FBlueprintCompiledStatement& CompareStatement =
+				EmitCompare(Context, TreeContext, TreeContext.EqualFunction, Cases[Index].KeyTerm, GotoIfNotStatement);
+			if (PrevGotoIfNotStatement != nullptr)
+			{
+				SetJumpTarget(PrevGotoIfNotStatement, CompareStatement);
+			}
+			if (FirstStatement == nullptr)
+			{
+				FirstStatement = &CompareStatement;
+			}
+			EmitGoto(Context, TreeContext, Cases[Index].ExecPin);
+
+			PrevGotoIfNotStatement = GotoIfNotStatement;
+		}
+
+		FBlueprintCompiledStatement& DefaultStatement = EmitGoto(Context, TreeContext, TreeContext.DefaultExecPin);
+		if (PrevGotoIfNotStatement != nullptr)
+		{
+			SetJumpTarget(PrevGotoIfNotStatement, DefaultStatement);
+		}
+
+		return (FirstStatement != nullptr) ? *FirstStatement : DefaultStatement;
+	}
+
+	const int32 Mid = (Begin + End) / 2;
+	FBlueprintCompiledStatement* GotoIfNotStatement = nullptr;
+	FBlueprintCompiledStatement& FirstStatement =
+		EmitCompare(Context, TreeContext, TreeContext.LessFunction, Cases[Mid].KeyTerm, GotoIfNotStatement);
+	EmitEqualTree(Context, TreeContext, Cases, Begin, Mid);
+	SetJumpTarget(GotoIfNotStatement, EmitEqualTree(Context, TreeContext, Cases, Mid, End));
+
+	return FirstStatement;
+}
+
+FBlueprintCompiledStatement& EmitLessThanDispatchTree(
+	FKismetFunctionContext& Context, const FDispatchTreeContext& TreeContext, const TArray<FDispatchTreeCase>& Cases)
+{
+	return EmitLessThanTree(Context, TreeContext, Cases, 0, Cases.Num());
+}
+
+FBlueprintCompiledStatement& EmitEqualDispatchTree(
+	FKismetFunctionContext& Context, const FDispatchTreeContext& TreeContext, const TArray<FDispatchTreeCase>& Cases)
+{
+	return EmitEqualTree(Context, TreeContext, Cases, 0, Cases.Num());
+}
@@ -0,0 +1,86 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowEditorUtils.h"
+
+#include "Containers/Ticker.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/EngineVersionComparison.h"
+
+static TArray<TWeakObjectPtr<UBlueprint>> PendingModifiedBlueprints;
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+static FDelegateHandle PendingModifiedTickerHandle;
+#else
+static FTSTicker::FDelegateHandle PendingModifiedTickerHandle;
+#endif
+
+static bool TickDeferredBlueprintModified(float DeltaTime)
+{
+	PendingModifiedTickerHandle.Reset();
+	FlushDeferredBlueprintModified();
+
+	// One-shot ticker.
+	return false;
+}
+
+void RequestDeferredBlueprintModified(UBlueprint* Blueprint)
+{
+	check(IsInGameThread());
+
+	if (Blueprint == nullptr)
+	{
+		return;
+	}
+
+	PendingModifiedBlueprints.AddUnique(Blueprint);
+
+	if (!PendingModifiedTickerHandle.IsValid())
+	{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+		PendingModifiedTickerHandle =
+			FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&TickDeferredBlueprintModified));
+#else
+		PendingModifiedTickerHandle =
+			FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&TickDeferredBlueprintModified));
+#endif
+	}
+}
+
+void FlushDeferredBlueprintModified()
+{
+	check(IsInGameThread());
+
+	// The broadcast may request the update again.
+	TArray<TWeakObjectPtr<UBlueprint>> Blueprints = MoveTemp(PendingModifiedBlueprints);
+	PendingModifiedBlueprints.Reset();
+
+	for (const TWeakObjectPtr<UBlueprint>& Blueprint : Blueprints)
+	{
+		if (Blueprint.IsValid())
+		{
+			FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint.Get());
+			Blueprint->BroadcastChanged();
+		}
+	}
+}
+
+void CancelDeferredBlueprintModified()
+{
+	if (PendingModifiedTickerHandle.IsValid())
+	{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+		FTicker::GetCoreTicker().RemoveTicker(PendingModifiedTickerHandle);
+#else
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingModifiedTickerHandle);
+#endif
+		PendingModifiedTickerHandle.Reset();
+	}
+	PendingModifiedBlueprints.Reset();
+}
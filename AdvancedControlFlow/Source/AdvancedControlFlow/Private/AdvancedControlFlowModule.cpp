@@ -9,13 +9,20 @@
 
 #include "AdvancedControlFlowModule.h"
 
+#include "AdvancedControlFlowEditorUtils.h"
 #include "EdGraphUtilities.h"
 #include "K2Node_ConditionalSequence.h"
 #include "K2Node_MultiBranch.h"
+#include "K2Node_MultiBranchOnBitmask.h"
+#include "K2Node_MultiBranchOnName.h"
+#include "K2Node_MultiBranchOnValue.h"
 #include "K2Node_MultiConditionalSelect.h"
+#include "K2Node_ParallelConditionalSequence.h"
 #include "SGraphNodeConditionalSequence.h"
 #include "SGraphNodeMultiBranch.h"
+#include "SGraphNodeMultiBranchOnSelection.h"
 #include "SGraphNodeMultiConditionalSelect.h"
+#include "SGraphNodeParallelConditionalSequence.h"
 
 #define LOCTEXT_NAMESPACE "AdvancedControlFlow"
 
@@ -27,10 +34,20 @@ class FGraphPanelNodeFactory_AdvancedControlFlow : public FGraphPanelNodeFactory
 		{
 			return SNew(SGraphNodeMultiBranch, MultiBranch);
 		}
+		else if (Node->IsA<UK2Node_MultiBranchOnValue>() || Node->IsA<UK2Node_MultiBranchOnBitmask>() ||
+				 Node->IsA<UK2Node_MultiBranchOnName>())
+		{
+			return SNew(SGraphNodeMultiBranchOnSelection, CastChecked<UK2Node_CasePairedPinsNode>(Node));
+		}
 		else if (UK2Node_ConditionalSequence* ConditionalSequence = Cast<UK2Node_ConditionalSequence>(Node))
 		{
 			return SNew(SGraphNodeConditionalSequence, ConditionalSequence);
 		}
+		else if (UK2Node_ParallelConditionalSequence* ParallelConditionalSequence =
+					 Cast<UK2Node_ParallelConditionalSequence>(Node))
+		{
+			return SNew(SGraphNodeParallelConditionalSequence, ParallelConditionalSequence);
+		}
 		else if (UK2Node_MultiConditionalSelect* MultiConditionalSelect = Cast<UK2Node_MultiConditionalSelect>(Node))
 		{
 			return SNew(SGraphNodeMultiConditionalSelect, MultiConditionalSelect);
@@ -48,6 +65,8 @@ void FAdvancedControlFlowModule::StartupModule()
 
 void FAdvancedControlFlowModule::ShutdownModule()
 {
+	CancelDeferredBlueprintModified();
+
 	if (GraphPanelNodeFactory_AdvancedControlFlow.IsValid())
 	{
 		FEdGraphUtilities::UnregisterVisualNodeFactory(GraphPanelNodeFactory_AdvancedControlFlow);
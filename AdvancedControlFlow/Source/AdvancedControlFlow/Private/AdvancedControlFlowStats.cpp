@@ -0,0 +1,24 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowStats.h"
+
+DEFINE_STAT(STAT_AdvancedControlFlow_ExpandNode);
+DEFINE_STAT(STAT_AdvancedControlFlow_RegisterNets);
+DEFINE_STAT(STAT_AdvancedControlFlow_Compile);
+DEFINE_STAT(STAT_AdvancedControlFlow_ReallocatePins);
+DEFINE_STAT(STAT_AdvancedControlFlow_PinConnectionListChanged);
+DEFINE_STAT(STAT_AdvancedControlFlow_EditCasePins);
+DEFINE_STAT(STAT_AdvancedControlFlow_CreatePinWidgets);
+
+DEFINE_STAT(STAT_AdvancedControlFlow_CompiledCasePairs);
+DEFINE_STAT(STAT_AdvancedControlFlow_ReallocatedCasePairs);
+DEFINE_STAT(STAT_AdvancedControlFlow_KeptCaseLayouts);
+DEFINE_STAT(STAT_AdvancedControlFlow_EditedCasePairs);
+DEFINE_STAT(STAT_AdvancedControlFlow_CreatedPinWidgets);
@@ -9,8 +9,11 @@
 
 #include "K2Node_CasePairedPinsNode.h"
 
-#include "Internationalization/Regex.h"
+#include "AdvancedControlFlowStats.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/Change.h"
+#include "Misc/ITransaction.h"
+#include "ScopedTransaction.h"
 #include "ToolMenu.h"
 
 #define LOCTEXT_NAMESPACE "AdvancedControlFlow"
@@ -18,7 +21,84 @@
 const FName DefaultExecPinName(TEXT("DefaultExec"));
 const FName DefaultExecPinFriendlyName(TEXT("Default"));
 
-UK2Node_CasePairedPinsNode::UK2Node_CasePairedPinsNode(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+#ifdef ACF_FREE_VERSION
+static const int32 FreeVersionMaxCaseCount = 3;
+#endif
+
+// Undo record of the cases inserted to or removed from the node.
+// This holds only the case range and the pin data which is not recreated by AddCasePinPair, so the size does not depend on the
+// number of the other pins on the node. The cases which have any link must be recorded by the snapshot (Modify) instead.
+class FCasePinsChange : public FCommandChange
+{
+public:
+	struct FCasePinState
+	{
+		FGuid KeyPinId;
+		FGuid ValuePinId;
+		FString KeyDefaultValue;
+		FString ValueDefaultValue;
+	};
+
+	FCasePinsChange(bool bInInserted, int32 InCaseIndex, TArray<FCasePinState>&& InStates)
+		: bInserted(bInInserted), CaseIndex(InCaseIndex), States(MoveTemp(InStates))
+	{
+	}
+
+	virtual void Apply(UObject* Object) override
+	{
+		bInserted ? Insert(Object) : Remove(Object);
+	}
+
+	virtual void Revert(UObject* Object) override
+	{
+		bInserted ? Remove(Object) : Insert(Object);
+	}
+
+	virtual FString ToString() const override
+	{
+		return FString::Printf(
+			TEXT("%s %d case pins at %d"), bInserted ? TEXT("Insert") : TEXT("Remove"), States.Num(), CaseIndex);
+	}
+
+private:
+	void Insert(UObject* Object) const
+	{
+		UK2Node_CasePairedPinsNode* Node = CastChecked<UK2Node_CasePairedPinsNode>(Object);
+		Node->InsertCasePairs(CaseIndex, States.Num());
+		for (int32 Index = 0; Index < States.Num(); ++Index)
+		{
+			const CasePinPair& Pair = Node->CasePinPairCache[CaseIndex + Index];
+			Pair.Key->PinId = States[Index].KeyPinId;
+			Pair.Key->DefaultValue = States[Index].KeyDefaultValue;
+			Pair.Value->PinId = States[Index].ValuePinId;
+			Pair.Value->DefaultValue = States[Index].ValueDefaultValue;
+		}
+		NotifyNodeChanged(Node);
+	}
+
+	void Remove(UObject* Object) const
+	{
+		UK2Node_CasePairedPinsNode* Node = CastChecked<UK2Node_CasePairedPinsNode>(Object);
+		Node->RemoveCasePairs(CaseIndex, States.Num());
+		NotifyNodeChanged(Node);
+	}
+
+	static void NotifyNodeChanged(UK2Node_CasePairedPinsNode* Node)
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Node->GetBlueprint());
+		if (UEdGraph* Graph = Node->GetGraph())
+		{
+			Graph->NotifyGraphChanged();
+		}
+	}
+
+	bool bInserted;
+	int32 CaseIndex;
+	TArray<FCasePinState> States;
+};
+
+UK2Node_CasePairedPinsNode::UK2Node_CasePairedPinsNode(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer), CasePinCachePinCount(0), bCasePinCacheValid(false)
 {
 }
 
@@ -30,13 +110,16 @@ void UK2Node_CasePairedPinsNode::GetNodeContextMenuActions(class UToolMenu* Menu
 	{
 		FToolMenuSection& Section = Menu->AddSection(NodeContextMenuSectionName, NodeContextMenuSectionLabel);
 
+#ifdef ACF_FREE_VERSION
+		const bool bCanAddCasePins = GetCasePinCount() < FreeVersionMaxCaseCount;
+#else
+		const bool bCanAddCasePins = true;
+#endif
+
 		if (Context->Pin != nullptr && IsCasePin(Context->Pin))
 		{
-#ifdef ACF_FREE_VERSION
-			const UK2Node_CasePairedPinsNode* CasePairedPinsNode = CastChecked<UK2Node_CasePairedPinsNode>(Context->Node);
-			if (CasePairedPinsNode->GetCasePinCount() < 3)
+			if (bCanAddCasePins)
 			{
-#endif
 				Section.AddMenuEntry("AddCasePinBefore", LOCTEXT("AddCasePinBefore", "Add case pin before"),
 					LOCTEXT("AddCasePinBeforeTooltip", "Add case pin before this pin on this node"), FSlateIcon(),
 					FUIAction(FExecuteAction::CreateUObject(const_cast<UK2Node_CasePairedPinsNode*>(this),
@@ -45,15 +128,26 @@ void UK2Node_CasePairedPinsNode::GetNodeContextMenuActions(class UToolMenu* Menu
 					LOCTEXT("AddCasePinAfterTooltip", "Add case pin after this pin on this node"), FSlateIcon(),
 					FUIAction(FExecuteAction::CreateUObject(const_cast<UK2Node_CasePairedPinsNode*>(this),
 						&UK2Node_CasePairedPinsNode::AddCasePinAfter, const_cast<UEdGraphPin*>(Context->Pin))));
-#ifdef ACF_FREE_VERSION
+				Section.AddSubMenu("AddCasePinsAfter", LOCTEXT("AddCasePinsAfter", "Add N case pins after"),
+					LOCTEXT("AddCasePinsAfterTooltip", "Add multiple case pins after this pin on this node at once"),
+					FNewToolMenuDelegate::CreateUObject(const_cast<UK2Node_CasePairedPinsNode*>(this),
+						&UK2Node_CasePairedPinsNode::GetInsertCasesSubMenu,
+						GetCaseIndexFromCasePin(const_cast<UEdGraphPin*>(Context->Pin)) + 1));
 			}
-#endif
 			Section.AddMenuEntry("RemoveThisCasePin", LOCTEXT("RemoveThisCasePin", "Remove this case pin"),
 				LOCTEXT("RemoveThisCasePinTooltip", "Remove this case pin on this node"), FSlateIcon(),
 				FUIAction(FExecuteAction::CreateUObject(const_cast<UK2Node_CasePairedPinsNode*>(this),
 					&UK2Node_CasePairedPinsNode::RemoveCasePinAt, const_cast<UEdGraphPin*>(Context->Pin))));
 		}
 
+		if (bCanAddCasePins)
+		{
+			Section.AddSubMenu("AddCasePinsLast", LOCTEXT("AddCasePinsLast", "Add N case pins"),
+				LOCTEXT("AddCasePinsLastTooltip", "Add multiple case pins to the end of this node at once"),
+				FNewToolMenuDelegate::CreateUObject(const_cast<UK2Node_CasePairedPinsNode*>(this),
+					&UK2Node_CasePairedPinsNode::GetInsertCasesSubMenu, GetCasePinCount()));
+		}
+
 		if (Context->Node->Pins.Num() >= 1)
 		{
 			Section.AddMenuEntry("RemoveFirstCasePin", LOCTEXT("RemoveFirstCasePin", "Remove first case pin"),
@@ -68,22 +162,89 @@ void UK2Node_CasePairedPinsNode::GetNodeContextMenuActions(class UToolMenu* Menu
 	}
 }
 
+void UK2Node_CasePairedPinsNode::GetInsertCasesSubMenu(UToolMenu* Menu, int32 CaseIndex)
+{
+	FToolMenuSection& Section = Menu->AddSection("AddCasePins");
+
+	for (int32 Count : {2, 5, 10, 20})
+	{
+		Section.AddMenuEntry(*FString::Printf(TEXT("AddCasePins_%d"), Count),
+			FText::Format(LOCTEXT("AddCasePins", "Add {0} case pins"), FText::AsNumber(Count)),
+			FText::Format(LOCTEXT("AddCasePinsTooltip", "Add {0} case pins on this node at once"), FText::AsNumber(Count)),
+			FSlateIcon(),
+			FUIAction(FExecuteAction::CreateUObject(this, &UK2Node_CasePairedPinsNode::InsertCases, CaseIndex, Count)));
+	}
+}
+
 void UK2Node_CasePairedPinsNode::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
 {
+	SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_ReallocatePins);
+
 	Super::AllocateDefaultPins();
 
+	// Old pins are not owned by the cache any more.
+	InvalidateCasePinCache();
+
+	// Collect the old case pins by the case index in one pass.
+	TArray<CasePinPair> OldCasePairs;
 	int32 CasePinCount = 0;
-	for (auto& Pin : OldPins)
+	for (UEdGraphPin* Pin : OldPins)
 	{
-		if (IsCaseKeyPin(Pin))
+		int32 CaseIndex;
+		bool bIsCaseKey = true;
+		if (!ParseCasePinName(Pin->PinName, CaseKeyPinNamePrefix, CaseIndex))
+		{
+			if (!ParseCasePinName(Pin->PinName, CaseValuePinNamePrefix, CaseIndex))
+			{
+				continue;
+			}
+			bIsCaseKey = false;
+		}
+
+		if (CaseIndex >= OldCasePairs.Num())
+		{
+			OldCasePairs.SetNumZeroed(CaseIndex + 1);
+		}
+		if (bIsCaseKey)
 		{
+			OldCasePairs[CaseIndex].Key = Pin;
 			++CasePinCount;
 		}
+		else
+		{
+			OldCasePairs[CaseIndex].Value = Pin;
+		}
 	}
 
+	Pins.Reserve(Pins.Num() + CasePinCount * 2);
 	for (int32 Index = 0; Index < CasePinCount; ++Index)
 	{
-		AddCasePinPair(Index);
+		CasePinPair NewPair = AddCasePinPair(Index);
+		if (OldCasePairs.IsValidIndex(Index))
+		{
+			RestoreCasePinPair(NewPair, OldCasePairs[Index]);
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_AdvancedControlFlow_ReallocatedCasePairs, CasePinCount);
+}
+
+void UK2Node_CasePairedPinsNode::RestoreCasePinPair(const CasePinPair& NewPair, const CasePinPair& OldPair)
+{
+	for (const CasePinPair& NewAndOldPins : {CasePinPair(NewPair.Key, OldPair.Key), CasePinPair(NewPair.Value, OldPair.Value)})
+	{
+		UEdGraphPin* NewPin = NewAndOldPins.Key;
+		const UEdGraphPin* OldPin = NewAndOldPins.Value;
+
+		// The default value is meaningless for the pin whose type was changed.
+		if ((NewPin == nullptr) || (OldPin == nullptr) || (NewPin->PinType != OldPin->PinType))
+		{
+			continue;
+		}
+
+		NewPin->DefaultValue = OldPin->DefaultValue;
+		NewPin->DefaultObject = OldPin->DefaultObject;
+		NewPin->DefaultTextValue = OldPin->DefaultTextValue;
 	}
 }
 
@@ -98,36 +259,11 @@ void UK2Node_CasePairedPinsNode::AddCasePinAfter(UEdGraphPin* Pin)
 
 	if (OwnerNode)
 	{
-		Modify();
-
 		CasePinPair Pair = GetCasePinPair(Pin);
+		int32 CaseIndexAfter = GetCaseIndexFromCaseKeyPin(Pair.Key);
+		check(CaseIndexAfter == GetCaseIndexFromCaseValuePin(Pair.Value));
 
-		UEdGraphPin* CaseKeyAfterPin = Pair.Key;
-		UEdGraphPin* CaseValueAfterPin = Pair.Value;
-		int32 CaseIndexAfter = GetCaseIndexFromCaseKeyPin(CaseKeyAfterPin);
-		check(CaseIndexAfter == GetCaseIndexFromCaseValuePin(CaseValueAfterPin));
-
-		// Get current key-value pin pair.
-		TArray<CasePinPair> CasePairs = GetCasePinPairs();
-
-		// Add new pin pair.
-		AddCasePinPair(CaseIndexAfter + 1);
-
-		// Restore key-value pin pair name.
-		for (int32 Index = CaseIndexAfter + 1; Index < CasePairs.Num(); ++Index)
-		{
-			UEdGraphPin* CaseKeyPin = CasePairs[Index].Key;
-			UEdGraphPin* CaseValuePin = CasePairs[Index].Value;
-
-			CaseValuePin->PinName = *GetCasePinName(CaseValuePinNamePrefix.ToString(), Index + 1);
-			CaseValuePin->PinFriendlyName =
-				FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), Index + 1));
-			CaseKeyPin->PinName = *GetCasePinName(CaseKeyPinNamePrefix.ToString(), Index + 1);
-			CaseKeyPin->PinFriendlyName =
-				FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), Index + 1));
-		}
-
-		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
+		InsertCases(CaseIndexAfter + 1, 1);
 	}
 }
 
@@ -142,36 +278,11 @@ void UK2Node_CasePairedPinsNode::AddCasePinBefore(UEdGraphPin* Pin)
 
 	if (OwnerNode)
 	{
-		Modify();
-
 		CasePinPair Pair = GetCasePinPair(Pin);
+		int32 CaseIndexBefore = GetCaseIndexFromCaseKeyPin(Pair.Key);
+		check(CaseIndexBefore == GetCaseIndexFromCaseValuePin(Pair.Value));
 
-		UEdGraphPin* CaseKeyBeforePin = Pair.Key;
-		UEdGraphPin* CaseValueBeforePin = Pair.Value;
-		int32 CaseIndexBefore = GetCaseIndexFromCaseKeyPin(CaseKeyBeforePin);
-		check(CaseIndexBefore == GetCaseIndexFromCaseValuePin(CaseValueBeforePin));
-
-		// Get current key-value pin pair.
-		TArray<CasePinPair> CasePairs = GetCasePinPairs();
-
-		// Add new pin pair.
-		AddCasePinPair(CaseIndexBefore);
-
-		// Restore key-value pin pair name.
-		for (int32 Index = CaseIndexBefore; Index < CasePairs.Num(); ++Index)
-		{
-			UEdGraphPin* CaseKeyPin = CasePairs[Index].Key;
-			UEdGraphPin* CaseValuePin = CasePairs[Index].Value;
-
-			CaseValuePin->PinName = *GetCasePinName(CaseValuePinNamePrefix.ToString(), Index + 1);
-			CaseValuePin->PinFriendlyName =
-				FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), Index + 1));
-			CaseKeyPin->PinName = *GetCasePinName(CaseKeyPinNamePrefix.ToString(), Index + 1);
-			CaseKeyPin->PinFriendlyName =
-				FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), Index + 1));
-		}
-
-		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
+		InsertCases(CaseIndexBefore, 1);
 	}
 }
 
@@ -186,8 +297,6 @@ void UK2Node_CasePairedPinsNode::RemoveCasePinAt(UEdGraphPin* Pin)
 
 	if (OwnerNode)
 	{
-		Modify();
-
 		int32 CaseIndex = GetCaseIndexFromCasePin(Pin);
 		RemoveCasePinAt(CaseIndex);
 	}
@@ -195,52 +304,36 @@ void UK2Node_CasePairedPinsNode::RemoveCasePinAt(UEdGraphPin* Pin)
 
 void UK2Node_CasePairedPinsNode::RemoveFirstCasePin()
 {
-	Modify();
-
 	RemoveCasePinAt(0);
 }
 
 void UK2Node_CasePairedPinsNode::RemoveLastCasePin()
 {
-	Modify();
-
 	RemoveCasePinAt(GetCasePinCount() - 1);
 }
 
 UEdGraphPin* UK2Node_CasePairedPinsNode::GetCaseKeyPinFromCaseIndex(int32 CaseIndex) const
 {
-	for (auto& P : Pins)
-	{
-		if (IsCaseKeyPin(P))
-		{
-			int32 ActualIndex = GetCaseIndexFromCaseKeyPin(P);
+	EnsureCasePinCache();
 
-			if ((ActualIndex != -1) && (ActualIndex == CaseIndex))
-			{
-				return P;
-			}
-		}
+	if (!CasePinPairCache.IsValidIndex(CaseIndex))
+	{
+		return nullptr;
 	}
 
-	return nullptr;
+	return CasePinPairCache[CaseIndex].Key;
 }
 
 UEdGraphPin* UK2Node_CasePairedPinsNode::GetCaseValuePinFromCaseIndex(int32 CaseIndex) const
 {
-	for (auto& P : Pins)
-	{
-		if (IsCaseValuePin(P))
-		{
-			int32 ActualIndex = GetCaseIndexFromCaseValuePin(P);
+	EnsureCasePinCache();
 
-			if ((ActualIndex != -1) && (ActualIndex == CaseIndex))
-			{
-				return P;
-			}
-		}
+	if (!CasePinPairCache.IsValidIndex(CaseIndex))
+	{
+		return nullptr;
 	}
 
-	return nullptr;
+	return CasePinPairCache[CaseIndex].Value;
 }
 
 CasePinPair UK2Node_CasePairedPinsNode::GetCasePinPair(UEdGraphPin* Pin) const
@@ -282,21 +375,25 @@ int32 UK2Node_CasePairedPinsNode::GetCaseIndexFromCasePin(const FString& Prefix,
 {
 	check(IsCasePin(Pin));
 
-	FString PinName = Pin->GetFName().ToString();
-	FString Dummy;
-	FString IndexStr;
-	if (!PinName.Split(Prefix + "_", &Dummy, &IndexStr, ESearchCase::CaseSensitive))
+	int32 CaseIndex;
+	if (!ParseCasePinName(Pin->PinName, FName(*Prefix), CaseIndex))
 	{
 		return -1;
 	}
 
-	return FCString::Atoi(*IndexStr);
+	return CaseIndex;
 }
 
 int32 UK2Node_CasePairedPinsNode::GetCaseIndexFromCaseValuePin(UEdGraphPin* Pin) const
 {
 	check(IsCaseValuePin(Pin));
 
+	const FCasePinIndexEntry* Entry = FindCasePinIndexEntry(Pin);
+	if (Entry != nullptr)
+	{
+		return Entry->CaseIndex;
+	}
+
 	return GetCaseIndexFromCasePin(CaseValuePinNamePrefix.ToString(), Pin);
 }
 
@@ -304,81 +401,201 @@ int32 UK2Node_CasePairedPinsNode::GetCaseIndexFromCaseKeyPin(UEdGraphPin* Pin) c
 {
 	check(IsCaseKeyPin(Pin));
 
+	const FCasePinIndexEntry* Entry = FindCasePinIndexEntry(Pin);
+	if (Entry != nullptr)
+	{
+		return Entry->CaseIndex;
+	}
+
 	return GetCaseIndexFromCasePin(CaseKeyPinNamePrefix.ToString(), Pin);
 }
 
 void UK2Node_CasePairedPinsNode::RemoveCasePinAt(int32 CaseIndex)
 {
-	UEdGraphPin* CaseValuePinToRemove = GetCaseValuePinFromCaseIndex(CaseIndex);
-	UEdGraphPin* CaseKeyPinToRemove = GetCaseKeyPinFromCaseIndex(CaseIndex);
-	check(CaseValuePinToRemove);
-	check(CaseKeyPinToRemove);
+	RemoveCases(CaseIndex, 1);
+}
+
+void UK2Node_CasePairedPinsNode::InsertCases(int32 CaseIndex, int32 Count)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_EditCasePins);
 
-	Pins.Remove(CaseValuePinToRemove);
-	Pins.Remove(CaseKeyPinToRemove);
-#if UE_VERSION_OLDER_THAN(5, 0, 0)
-	CaseValuePinToRemove->MarkPendingKill();
-	CaseKeyPinToRemove->MarkPendingKill();
-#else
-	CaseValuePinToRemove->MarkAsGarbage();
-	CaseKeyPinToRemove->MarkAsGarbage();
+	const int32 CasePinCount = GetCasePinCount();
+#ifdef ACF_FREE_VERSION
+	Count = FMath::Min(Count, FreeVersionMaxCaseCount - CasePinCount);
 #endif
-
-	int32 Index = 0;
-	for (auto& P : Pins)
+	if ((Count <= 0) || (CaseIndex < 0) || (CaseIndex > CasePinCount))
 	{
-		if (IsCaseValuePin(P))
-		{
-			UEdGraphPin* CaseValuePin = P;
-			UEdGraphPin* CaseKeyPin = GetCaseKeyPinFromCaseValuePin(CaseValuePin);
+		return;
+	}
 
-			CaseValuePin->PinName = *GetCasePinName(CaseValuePinNamePrefix.ToString(), Index);
-			CaseValuePin->PinFriendlyName =
-				FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), Index));
-			CaseKeyPin->PinName = *GetCasePinName(CaseKeyPinNamePrefix.ToString(), Index);
-			CaseKeyPin->PinFriendlyName =
-				FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), Index));
+	const FScopedTransaction Transaction(LOCTEXT("InsertCasePinsTransaction", "Insert Case Pins"));
+	const bool bRecordChange = CanRecordCasePinsChange(CaseIndex, 0);
+	if (!bRecordChange)
+	{
+		Modify();
+	}
 
-			++Index;
-		}
+	InsertCasePairs(CaseIndex, Count);
+	if (bRecordChange)
+	{
+		RecordCasePinsChange(true, CaseIndex, Count);
 	}
 
 	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
 }
 
-int32 UK2Node_CasePairedPinsNode::GetCasePinCount() const
+void UK2Node_CasePairedPinsNode::InsertCasePairs(int32 CaseIndex, int32 Count)
 {
-	// TODO: need to optimize.
-	for (int32 Index = Pins.Num(); Index >= 0; --Index)
+	EnsureCasePinCache();
+	const int32 CasePinCount = CasePinPairCache.Num();
+
+	// The first case is created at its place by the node class. The others are appended to the pins and spliced after it at once,
+	// so that the following pins and their cache entries are moved only once regardless of the count.
+	// The following pins keep their old names until RenameCasePinPairs, but they are found by the cache.
+	const CasePinPair FirstPair = AddCasePinPair(CaseIndex);
+	if (Count > 1)
 	{
-		UEdGraphPin* CaseKeyPinIndex = GetCaseKeyPinFromCaseIndex(Index);
-		UEdGraphPin* CaseValuePinIndex = GetCaseValuePinFromCaseIndex(Index);
+		const int32 AppendedPinIndex = Pins.Num();
+		TArray<CasePinPair> AppendedPairs;
+		AppendedPairs.Reserve(Count - 1);
+		{
+			TGuardValue<bool> AppendingGuard(bAppendingCasePins, true);
+			for (int32 Index = 1; Index < Count; ++Index)
+			{
+				AppendedPairs.Add(AddCasePinPair(CaseIndex + Index));
+			}
+		}
 
-		if ((CaseKeyPinIndex != nullptr) && (CaseValuePinIndex != nullptr))
+		TArray<UEdGraphPin*> KeyPins;
+		TArray<UEdGraphPin*> ValuePins;
+		KeyPins.Reserve(AppendedPairs.Num());
+		ValuePins.Reserve(AppendedPairs.Num());
+		for (const CasePinPair& Pair : AppendedPairs)
 		{
-			return Index + 1;
+			KeyPins.Add(Pair.Key);
+			ValuePins.Add(Pair.Value);
 		}
+		Pins.RemoveAt(AppendedPinIndex, Pins.Num() - AppendedPinIndex);
+
+		// The later position is spliced first, so that the other position is not moved.
+		const int32 KeyPinIndex = Pins.Find(FirstPair.Key) + 1;
+		const int32 ValuePinIndex = Pins.Find(FirstPair.Value) + 1;
+		const bool bKeyPinsFirst = KeyPinIndex < ValuePinIndex;
+		Pins.Insert(bKeyPinsFirst ? ValuePins : KeyPins, bKeyPinsFirst ? ValuePinIndex : KeyPinIndex);
+		Pins.Insert(bKeyPinsFirst ? KeyPins : ValuePins, bKeyPinsFirst ? KeyPinIndex : ValuePinIndex);
+
+		CasePinPairCache.Insert(AppendedPairs, CaseIndex + 1);
+		ReindexCasePinCache(CaseIndex + 1);
+	}
+	RenameCasePinPairs(CaseIndex + Count);
+	INC_DWORD_STAT_BY(STAT_AdvancedControlFlow_EditedCasePairs, CasePinCount - CaseIndex + Count);
+}
+
+void UK2Node_CasePairedPinsNode::RemoveCases(int32 CaseIndex, int32 Count)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_EditCasePins);
+
+	const int32 CasePinCount = GetCasePinCount();
+	if ((CaseIndex < 0) || (CaseIndex >= CasePinCount))
+	{
+		return;
+	}
+	Count = FMath::Min(Count, CasePinCount - CaseIndex);
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	const FScopedTransaction Transaction(LOCTEXT("RemoveCasePinsTransaction", "Remove Case Pins"));
+	if (CanRecordCasePinsChange(CaseIndex, Count))
+	{
+		RecordCasePinsChange(false, CaseIndex, Count);
+	}
+	else
+	{
+		Modify();
 	}
 
-	return 0;
+	RemoveCasePairs(CaseIndex, Count);
+
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
 }
 
-TArray<CasePinPair> UK2Node_CasePairedPinsNode::GetCasePinPairs() const
+void UK2Node_CasePairedPinsNode::RemoveCasePairs(int32 CaseIndex, int32 Count)
 {
-	TArray<CasePinPair> CasePairs;
-	CasePairs.SetNum(GetCasePinCount());
+	EnsureCasePinCache();
+	const int32 CasePinCount = CasePinPairCache.Num();
+
+	TArray<CasePinPair> PairsToRemove;
+	PairsToRemove.Append(&CasePinPairCache[CaseIndex], Count);
+	UnregisterCasePinPairs(CaseIndex, Count);
+	INC_DWORD_STAT_BY(STAT_AdvancedControlFlow_EditedCasePairs, CasePinCount - CaseIndex);
 
-	for (auto& P : Pins)
+	TSet<UEdGraphPin*> PinsToRemove;
+	for (const CasePinPair& Pair : PairsToRemove)
 	{
-		if (IsCaseValuePin(P))
-		{
-			UEdGraphPin* CaseValuePin = P;
-			int32 Index = GetCaseIndexFromCaseValuePin(CaseValuePin);
-			CasePairs[Index] = GetCasePinPair(CaseValuePin);
-		}
+		PinsToRemove.Add(Pair.Key);
+		PinsToRemove.Add(Pair.Value);
+	}
+	Pins.RemoveAll([&PinsToRemove](UEdGraphPin* Pin) { return PinsToRemove.Contains(Pin); });
+	CasePinCachePinCount = Pins.Num();
+
+	for (UEdGraphPin* Pin : PinsToRemove)
+	{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+		Pin->MarkPendingKill();
+#else
+		Pin->MarkAsGarbage();
+#endif
 	}
 
-	return CasePairs;
+	RenameCasePinPairs(CaseIndex);
+}
+
+void UK2Node_CasePairedPinsNode::SetCaseCount(int32 CaseCount)
+{
+	const int32 CasePinCount = GetCasePinCount();
+	if (CaseCount > CasePinCount)
+	{
+		InsertCases(CasePinCount, CaseCount - CasePinCount);
+	}
+	else if (CaseCount < CasePinCount)
+	{
+		RemoveCases(FMath::Max(CaseCount, 0), CasePinCount - CaseCount);
+	}
+}
+
+void UK2Node_CasePairedPinsNode::RenameCasePinPairs(int32 StartCaseIndex)
+{
+	EnsureCasePinCache();
+
+	const FString KeyFriendlyNamePrefix = CaseKeyPinFriendlyNamePrefix.ToString();
+	const FString ValueFriendlyNamePrefix = CaseValuePinFriendlyNamePrefix.ToString();
+	for (int32 Index = StartCaseIndex; Index < CasePinPairCache.Num(); ++Index)
+	{
+		UEdGraphPin* CaseKeyPin = CasePinPairCache[Index].Key;
+		UEdGraphPin* CaseValuePin = CasePinPairCache[Index].Value;
+
+		// Same as GetCasePinName, but the number part of the name is set directly.
+		CaseValuePin->PinName = FName(CaseValuePinNamePrefix, NAME_EXTERNAL_TO_INTERNAL(Index));
+		CaseValuePin->PinFriendlyName = FText::AsCultureInvariant(GetCasePinFriendlyName(ValueFriendlyNamePrefix, Index));
+		CaseKeyPin->PinName = FName(CaseKeyPinNamePrefix, NAME_EXTERNAL_TO_INTERNAL(Index));
+		CaseKeyPin->PinFriendlyName = FText::AsCultureInvariant(GetCasePinFriendlyName(KeyFriendlyNamePrefix, Index));
+	}
+}
+
+int32 UK2Node_CasePairedPinsNode::GetCasePinCount() const
+{
+	EnsureCasePinCache();
+
+	return CasePinPairCache.Num();
+}
+
+TArray<CasePinPair> UK2Node_CasePairedPinsNode::GetCasePinPairs() const
+{
+	EnsureCasePinCache();
+
+	return CasePinPairCache;
 }
 
 bool UK2Node_CasePairedPinsNode::IsCasePin(const UEdGraphPin* Pin) const
@@ -388,22 +605,28 @@ bool UK2Node_CasePairedPinsNode::IsCasePin(const UEdGraphPin* Pin) const
 
 bool UK2Node_CasePairedPinsNode::IsCaseKeyPin(const UEdGraphPin* Pin) const
 {
-	FString PinName = Pin->GetFName().ToString();
-
-	FRegexPattern Pattern = FRegexPattern(FString::Format(TEXT("{0}_[0-9]+"), {CaseKeyPinNamePrefix.ToString()}));
-	FRegexMatcher Matcher(Pattern, PinName);
+	const FCasePinIndexEntry* Entry = FindCasePinIndexEntry(Pin);
+	if (Entry != nullptr)
+	{
+		return Entry->bIsCaseKey;
+	}
 
-	return Matcher.FindNext();
+	// The pin is not on the current pin list (ex. old pins during the reconstruction).
+	int32 CaseIndex;
+	return ParseCasePinName(Pin->PinName, CaseKeyPinNamePrefix, CaseIndex);
 }
 
 bool UK2Node_CasePairedPinsNode::IsCaseValuePin(const UEdGraphPin* Pin) const
 {
-	FString PinName = Pin->GetFName().ToString();
-
-	FRegexPattern Pattern = FRegexPattern(FString::Format(TEXT("{0}_[0-9]+"), {CaseValuePinNamePrefix.ToString()}));
-	FRegexMatcher Matcher(Pattern, PinName);
+	const FCasePinIndexEntry* Entry = FindCasePinIndexEntry(Pin);
+	if (Entry != nullptr)
+	{
+		return !Entry->bIsCaseKey;
+	}
 
-	return Matcher.FindNext();
+	// The pin is not on the current pin list (ex. old pins during the reconstruction).
+	int32 CaseIndex;
+	return ParseCasePinName(Pin->PinName, CaseValuePinNamePrefix, CaseIndex);
 }
 
 FString UK2Node_CasePairedPinsNode::GetCasePinName(const FString& Prefix, int32 CaseIndex) const
@@ -418,39 +641,310 @@ FString UK2Node_CasePairedPinsNode::GetCasePinFriendlyName(const FString& Prefix
 
 UEdGraphPin* UK2Node_CasePairedPinsNode::GetCaseKeyPinFromCaseValuePin(const UEdGraphPin* ValuePin) const
 {
-	FString ValuePinName = ValuePin->GetFName().ToString();
-
-	FString Dummy;
-	FString Suffix;
-	if (!ValuePinName.Split(CaseValuePinNamePrefix.ToString(), &Dummy, &Suffix, ESearchCase::CaseSensitive))
+	const FCasePinIndexEntry* Entry = FindCasePinIndexEntry(ValuePin);
+	if ((Entry == nullptr) || Entry->bIsCaseKey || !CasePinPairCache.IsValidIndex(Entry->CaseIndex))
 	{
 		return nullptr;
 	}
 
-	return FindPin(CaseKeyPinNamePrefix.ToString() + Suffix);
+	return CasePinPairCache[Entry->CaseIndex].Key;
 }
 
 UEdGraphPin* UK2Node_CasePairedPinsNode::GetCaseValuePinFromCaseKeyPin(const UEdGraphPin* KeyPin) const
 {
-	FString KeyPinName = KeyPin->GetFName().ToString();
-
-	FString Dummy;
-	FString Suffix;
-	if (!KeyPinName.Split(CaseKeyPinNamePrefix.ToString(), &Dummy, &Suffix, ESearchCase::CaseSensitive))
+	const FCasePinIndexEntry* Entry = FindCasePinIndexEntry(KeyPin);
+	if ((Entry == nullptr) || !Entry->bIsCaseKey || !CasePinPairCache.IsValidIndex(Entry->CaseIndex))
 	{
 		return nullptr;
 	}
 
-	return FindPin(CaseValuePinNamePrefix.ToString() + Suffix);
+	return CasePinPairCache[Entry->CaseIndex].Value;
 }
 
 void UK2Node_CasePairedPinsNode::AddCasePinLast()
 {
-	Modify();
+	SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_EditCasePins);
 
+	const FScopedTransaction Transaction(LOCTEXT("AddCasePinTransaction", "Add Case Pin"));
 	int32 N = GetCasePinCount();
+	const bool bRecordChange = CanRecordCasePinsChange(N, 0);
+	if (!bRecordChange)
+	{
+		Modify();
+	}
 
 	AddCasePinPair(N);
+	INC_DWORD_STAT(STAT_AdvancedControlFlow_EditedCasePairs);
+	if (bRecordChange)
+	{
+		RecordCasePinsChange(true, N, 1);
+	}
+}
+
+void UK2Node_CasePairedPinsNode::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	// Pins may be recreated by the transaction.
+	InvalidateCasePinCache();
+}
+
+bool UK2Node_CasePairedPinsNode::CanRecordCasePinsChange(int32 CaseIndex, int32 Count) const
+{
+	// The node which is already saved to the transaction is restored from the snapshot, which includes this edit.
+	if ((GUndo == nullptr) || !HasAnyFlags(RF_Transactional) || GUndo->ContainsObject(this))
+	{
+		return false;
+	}
+
+	// The links are owned by the other nodes too, so they can not be restored by the change of this node.
+	EnsureCasePinCache();
+	for (int32 Index = CaseIndex; Index < CaseIndex + Count; ++Index)
+	{
+		for (const UEdGraphPin* Pin : {CasePinPairCache[Index].Key, CasePinPairCache[Index].Value})
+		{
+			if ((Pin->LinkedTo.Num() > 0) || (Pin->DefaultObject != nullptr) || !Pin->DefaultTextValue.IsEmpty())
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void UK2Node_CasePairedPinsNode::RecordCasePinsChange(bool bInserted, int32 CaseIndex, int32 Count)
+{
+	EnsureCasePinCache();
+
+	TArray<FCasePinsChange::FCasePinState> States;
+	States.Reserve(Count);
+	for (int32 Index = CaseIndex; Index < CaseIndex + Count; ++Index)
+	{
+		const CasePinPair& Pair = CasePinPairCache[Index];
+		States.Add({Pair.Key->PinId, Pair.Value->PinId, Pair.Key->DefaultValue, Pair.Value->DefaultValue});
+	}
+
+	GUndo->StoreUndo(this, MakeUnique<FCasePinsChange>(bInserted, CaseIndex, MoveTemp(States)));
+
+	// Same as Modify, which is not called for this edit.
+	MarkPackageDirty();
+}
+
+void UK2Node_CasePairedPinsNode::Serialize(FArchive& Ar)
+{
+	// The layout is saved only to the packages, so the transactions and the duplications do not pay for it.
+	if (Ar.IsSaving() && Ar.IsPersistent())
+	{
+		SaveCaseLayout();
+	}
+
+	Super::Serialize(Ar);
+}
+
+void UK2Node_CasePairedPinsNode::ReconstructNode()
+{
+	// The pins loaded with the current layout are same as the ones which the reconstruction creates, so they are kept.
+	// The reconstruction is still needed on the other cases (ex. the connected nodes are changed on the editor).
+	const UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForNode(this);
+	if ((Blueprint != nullptr) && Blueprint->bIsRegeneratingOnLoad && IsSavedCaseLayoutUpToDate())
+	{
+		INC_DWORD_STAT(STAT_AdvancedControlFlow_KeptCaseLayouts);
+		PostReconstructNode();
+		return;
+	}
+
+	Super::ReconstructNode();
+}
+
+// Return the hash of the pins which is stable across the sessions.
+// The names are hashed as the strings because the hash of FName depends on the name table of the session.
+static uint32 ComputeCasePinSignature(const TArray<UEdGraphPin*>& Pins)
+{
+	uint32 Crc = 0;
+	for (const UEdGraphPin* Pin : Pins)
+	{
+		const FEdGraphPinType& PinType = Pin->PinType;
+		Crc = FCrc::StrCrc32(*Pin->PinName.ToString(), Crc);
+		Crc = FCrc::StrCrc32(*PinType.PinCategory.ToString(), Crc);
+		Crc = FCrc::StrCrc32(*PinType.PinSubCategory.ToString(), Crc);
+		Crc = FCrc::StrCrc32(*GetPathNameSafe(PinType.PinSubCategoryObject.Get()), Crc);
+		Crc = FCrc::StrCrc32(*GetPathNameSafe(Pin->DefaultObject), Crc);
+
+		const uint8 Flags[] = {static_cast<uint8>(Pin->Direction), static_cast<uint8>(PinType.ContainerType),
+			static_cast<uint8>(PinType.bIsReference), static_cast<uint8>(PinType.bIsConst)};
+		Crc = FCrc::MemCrc32(Flags, sizeof(Flags), Crc);
+	}
+
+	return Crc;
+}
+
+void UK2Node_CasePairedPinsNode::SaveCaseLayout()
+{
+	SavedCaseLayout.Version = CaseLayoutVersion;
+	SavedCaseLayout.CaseCount = GetCasePinCount();
+	SavedCaseLayout.PinCount = Pins.Num();
+	SavedCaseLayout.PinSignature = ComputeCasePinSignature(Pins);
+}
+
+bool UK2Node_CasePairedPinsNode::IsSavedCaseLayoutUpToDate() const
+{
+	if ((CaseLayoutVersion == INDEX_NONE) || (SavedCaseLayout.Version != CaseLayoutVersion))
+	{
+		return false;
+	}
+
+	// The pin count also catches the pins which are not in the layout (ex. the pins saved by the old format).
+	if ((SavedCaseLayout.CaseCount != GetCasePinCount()) || (SavedCaseLayout.PinCount != Pins.Num()))
+	{
+		return false;
+	}
+
+	// The orphaned pins are removed by the reconstruction.
+	for (const UEdGraphPin* Pin : Pins)
+	{
+		if (Pin->bOrphanedPin)
+		{
+			return false;
+		}
+	}
+
+	// The signature catches the pins which are loaded differently from the saved ones with the same count
+	// (ex. the pin type object or the default object is renamed, redirected or removed after the save).
+	return SavedCaseLayout.PinSignature == ComputeCasePinSignature(Pins);
+}
+
+bool UK2Node_CasePairedPinsNode::ParseCasePinName(const FName& PinName, const FName& Prefix, int32& OutCaseIndex) const
+{
+	// "<Prefix>_<Index>" is stored in FName as the base name "<Prefix>" and the number "<Index>".
+	// Comparing them does not need any string work, so this is safe to call from anywhere (ex. compiler or cook workers).
+	if ((PinName.GetComparisonIndex() != Prefix.GetComparisonIndex()) || (PinName.GetNumber() == NAME_NO_NUMBER_INTERNAL))
+	{
+		return false;
+	}
+
+	OutCaseIndex = NAME_INTERNAL_TO_EXTERNAL(PinName.GetNumber());
+
+	return true;
+}
+
+void UK2Node_CasePairedPinsNode::RebuildCasePinCache() const
+{
+	TArray<UEdGraphPin*> KeyPins;
+	TArray<UEdGraphPin*> ValuePins;
+
+	CasePinIndexCache.Reset();
+	for (UEdGraphPin* Pin : Pins)
+	{
+		int32 CaseIndex;
+		TArray<UEdGraphPin*>* CasePins = nullptr;
+		bool bIsCaseKey = false;
+		if (ParseCasePinName(Pin->PinName, CaseKeyPinNamePrefix, CaseIndex))
+		{
+			CasePins = &KeyPins;
+			bIsCaseKey = true;
+		}
+		else if (ParseCasePinName(Pin->PinName, CaseValuePinNamePrefix, CaseIndex))
+		{
+			CasePins = &ValuePins;
+		}
+		else
+		{
+			continue;
+		}
+
+		if (CaseIndex >= CasePins->Num())
+		{
+			CasePins->SetNumZeroed(CaseIndex + 1);
+		}
+		(*CasePins)[CaseIndex] = Pin;
+		CasePinIndexCache.Add(Pin, {CaseIndex, bIsCaseKey});
+	}
+
+	// The number of cases is determined by the last case index which has both key and value pins.
+	int32 CasePinCount = FMath::Min(KeyPins.Num(), ValuePins.Num());
+	while ((CasePinCount > 0) && ((KeyPins[CasePinCount - 1] == nullptr) || (ValuePins[CasePinCount - 1] == nullptr)))
+	{
+		--CasePinCount;
+	}
+
+	CasePinPairCache.SetNum(CasePinCount);
+	for (int32 Index = 0; Index < CasePinCount; ++Index)
+	{
+		CasePinPairCache[Index] = CasePinPair(KeyPins[Index], ValuePins[Index]);
+	}
+
+	CasePinCachePinCount = Pins.Num();
+	bCasePinCacheValid = true;
+}
+
+void UK2Node_CasePairedPinsNode::EnsureCasePinCache() const
+{
+	// The pin count check catches the pin list change from outside (ex. reconstruction).
+	if (!bCasePinCacheValid || (CasePinCachePinCount != Pins.Num()))
+	{
+		RebuildCasePinCache();
+	}
+}
+
+void UK2Node_CasePairedPinsNode::InvalidateCasePinCache()
+{
+	bCasePinCacheValid = false;
+	CasePinPairCache.Reset();
+	CasePinIndexCache.Reset();
+}
+
+void UK2Node_CasePairedPinsNode::RegisterCasePinPair(int32 CaseIndex, const CasePinPair& Pair)
+{
+	// The cache must be valid before the new pins are created, or the pins with same name will be confused.
+	check(bCasePinCacheValid);
+
+	// The appended pins are registered by InsertCasePairs after they are spliced.
+	if (!bAppendingCasePins)
+	{
+		check((CaseIndex >= 0) && (CaseIndex <= CasePinPairCache.Num()));
+		CasePinPairCache.Insert(Pair, CaseIndex);
+		ReindexCasePinCache(CaseIndex);
+	}
+
+	CasePinCachePinCount = Pins.Num();
+}
+
+void UK2Node_CasePairedPinsNode::ReindexCasePinCache(int32 StartCaseIndex)
+{
+	for (int32 Index = StartCaseIndex; Index < CasePinPairCache.Num(); ++Index)
+	{
+		CasePinIndexCache.Add(CasePinPairCache[Index].Key, {Index, true});
+		CasePinIndexCache.Add(CasePinPairCache[Index].Value, {Index, false});
+	}
+
+	CasePinCachePinCount = Pins.Num();
+}
+
+int32 UK2Node_CasePairedPinsNode::GetCasePinInsertIndex(int32 PinIndex) const
+{
+	return bAppendingCasePins ? INDEX_NONE : PinIndex;
+}
+
+void UK2Node_CasePairedPinsNode::UnregisterCasePinPairs(int32 CaseIndex, int32 Count)
+{
+	check(bCasePinCacheValid);
+	check((Count > 0) && CasePinPairCache.IsValidIndex(CaseIndex) && CasePinPairCache.IsValidIndex(CaseIndex + Count - 1));
+
+	for (int32 Index = CaseIndex; Index < CaseIndex + Count; ++Index)
+	{
+		CasePinIndexCache.Remove(CasePinPairCache[Index].Key);
+		CasePinIndexCache.Remove(CasePinPairCache[Index].Value);
+	}
+	CasePinPairCache.RemoveAt(CaseIndex, Count);
+	ReindexCasePinCache(CaseIndex);
+}
+
+const FCasePinIndexEntry* UK2Node_CasePairedPinsNode::FindCasePinIndexEntry(const UEdGraphPin* Pin) const
+{
+	EnsureCasePinCache();
+
+	return CasePinIndexCache.Find(Pin);
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -9,15 +9,319 @@
 
 #include "K2Node_ConditionalSequence.h"
 
+#include "AdvancedControlFlowCompilerUtils.h"
+#include "AdvancedControlFlowStats.h"
 #include "BlueprintActionDatabaseRegistrar.h"
 #include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "EdGraphUtilities.h"
 #include "EditorCategoryUtils.h"
-#include "K2Node_ExecutionSequence.h"
 #include "K2Node_IfThenElse.h"
+#include "K2Node_VariableGet.h"
+#include "KismetCompiledFunctionContext.h"
 #include "KismetCompiler.h"
+#include "KismetCompilerMisc.h"
 
 #define LOCTEXT_NAMESPACE "AdvancedControlFlow"
 
+class FKCHandler_ConditionalSequence : public FNodeHandlingFunctor
+{
+public:
+	FKCHandler_ConditionalSequence(FKismetCompilerContext& InCompilerContext) : FNodeHandlingFunctor(InCompilerContext)
+	{
+	}
+
+	virtual void RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_RegisterNets);
+
+		FNodeHandlingFunctor::RegisterNets(Context, Node);
+
+		const TArray<UEdGraphPin*> SnapshotNets = GetSnapshotConditionNets(CastChecked<UK2Node_ConditionalSequence>(Node));
+		for (int32 Index = 0; Index < SnapshotNets.Num(); ++Index)
+		{
+			FBPTerminal* Term = Context.CreateLocalTerminal();
+			Term->Type.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+			Term->Source = Node;
+			Term->Name = GetSnapshotTerminalName(Node, Index);
+		}
+	}
+
+	// clang-format off
+	/*
+	 * Generated code
+	 *
+	 *          GotoIfNot Condition 0 -> Stage 1
+	 *          PushState -> Stage 1
+	 *          Goto Case Execution 0
+	 * Stage 1: GotoIfNot Condition 1 -> Default
+	 *          PushState -> Default
+	 *          Goto Case Execution 1
+	 * Default: Goto Default Execution
+	 *
+	 * The stage whose case execution is not connected is skipped.
+	 * The condition which is always true (ex. evaluated by the intermediate Branch node in ExpandNode) has no GotoIfNot.
+	 * The stage whose condition is always false is removed.
+	 * On snapshot mode, the condition nets are copied to the locals before Stage 0 and the stages read the copies.
+	 * The pure nodes are evaluated once before this node, and the net shared by the several conditions is copied once.
+	 * If the case hits are recorded, RecordCaseHit is called before PushState and Goto Default Execution.
+	 * If the cases are traced, each stage sets "Trace case = Index; Trace start = BeginTraceCase()" before PushState, and the
+	 * next stage and Default begin with "Trace start = TraceCaseTaken(Trace case, Trace start)". So the traced duration is the
+	 * time which the case execution takes. PushState is always emitted to return after the last stage.
+	 *
+	 * The handler has no state, and everything needed is read from the node pins.
+	 */
+	// clang-format on
+	virtual void Compile(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_Compile);
+
+		UK2Node_ConditionalSequence* ConditionalSequenceNode = CastChecked<UK2Node_ConditionalSequence>(Node);
+
+		FEdGraphPinType ExpectedExecPinType;
+		ExpectedExecPinType.PinCategory = UEdGraphSchema_K2::PC_Exec;
+
+		{
+			UEdGraphPin* ExecTriggeringPin =
+				Context.FindRequiredPinByName(ConditionalSequenceNode, UEdGraphSchema_K2::PN_Execute, EGPD_Input);
+			if ((ExecTriggeringPin == nullptr) || !Context.ValidatePinType(ExecTriggeringPin, ExpectedExecPinType))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("NoValidExecutionPinForConditionalSequence_Error", "@@ must have a valid execution pin @@").ToString(),
+					ConditionalSequenceNode, ExecTriggeringPin);
+				return;
+			}
+			else if (ExecTriggeringPin->LinkedTo.Num() == 0)
+			{
+				CompilerContext.MessageLog.Warning(
+					*LOCTEXT("NodeNeverExecuted_Warning", "@@ will never be executed").ToString(), ConditionalSequenceNode);
+				return;
+			}
+		}
+
+		UEdGraphPin* DefaultExecPin = ConditionalSequenceNode->GetDefaultExecPin();
+		TArray<CasePinPair> CasePairs = ConditionalSequenceNode->GetCasePinPairs();
+		INC_DWORD_STAT_BY(STAT_AdvancedControlFlow_CompiledCasePairs, CasePairs.Num());
+
+		int32 LastConnectedCaseIndex = INDEX_NONE;
+		for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+		{
+			if ((CasePairs[Index].Value->LinkedTo.Num() > 0) && !IsLiteralFalse(CasePairs[Index].Key))
+			{
+				LastConnectedCaseIndex = Index;
+			}
+		}
+
+		// Statements which jump to the next stage.
+		TArray<FBlueprintCompiledStatement*> NextStageStatements;
+		auto ResolveNextStage = [&NextStageStatements](FBlueprintCompiledStatement& StageStatement) {
+			for (FBlueprintCompiledStatement* Statement : NextStageStatements)
+			{
+				Statement->TargetLabel = &StageStatement;
+				StageStatement.bIsJumpTarget = true;
+			}
+			NextStageStatements.Reset();
+		};
+
+		// Snapshot = Condition Net
+		TMap<UEdGraphPin*, FBPTerminal*> SnapshotTerms;
+		const TArray<UEdGraphPin*> SnapshotNets = GetSnapshotConditionNets(ConditionalSequenceNode);
+		for (int32 Index = 0; Index < SnapshotNets.Num(); ++Index)
+		{
+			FBPTerminal* SnapshotTerm = FindSnapshotTerminal(Context, ConditionalSequenceNode, Index);
+			check(SnapshotTerm != nullptr);
+
+			FBlueprintCompiledStatement& AssignStatement = Context.AppendStatementForNode(ConditionalSequenceNode);
+			AssignStatement.Type = KCST_Assignment;
+			AssignStatement.LHS = SnapshotTerm;
+			AssignStatement.RHS.Add(Context.NetMap.FindRef(SnapshotNets[Index]));
+			SnapshotTerms.Add(SnapshotNets[Index], SnapshotTerm);
+		}
+
+		// Trace start = 0
+		FBPTerminal* TraceStartTerm = nullptr;
+		FBPTerminal* TraceCaseTerm = nullptr;
+		if (ShouldTraceCases())
+		{
+			TraceStartTerm = FindOrCreateTraceStartTerminal(Context, ConditionalSequenceNode);
+			TraceCaseTerm = FindOrCreateTraceCaseTerminal(Context, ConditionalSequenceNode);
+
+			FBlueprintCompiledStatement& ResetStatement = Context.AppendStatementForNode(ConditionalSequenceNode);
+			ResetStatement.Type = KCST_Assignment;
+			ResetStatement.LHS = TraceStartTerm;
+			ResetStatement.RHS.Add(CreateLiteralTerminal(Context, ConditionalSequenceNode, UEdGraphSchema_K2::PC_Int64, TEXT("0")));
+		}
+
+		const bool bRecordCaseHits = ShouldRecordCaseHits();
+		bool bAnyStageEmitted = false;
+		int32 EvaluatedConditionCount = 0;
+		for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+		{
+			UEdGraphPin* CondPin = CasePairs[Index].Key;
+			UEdGraphPin* ExecPin = CasePairs[Index].Value;
+			if (ExecPin->LinkedTo.Num() == 0)
+			{
+				continue;
+			}
+			if (IsLiteralFalse(CondPin))
+			{
+				CompilerContext.MessageLog.Note(
+					*LOCTEXT("AlwaysFalseCasePruned_Note", "@@: @@ is removed because it is always false").ToString(),
+					ConditionalSequenceNode, CondPin);
+				continue;
+			}
+			++EvaluatedConditionCount;
+
+			// Statements which jump to the next stage, and the first statement of this stage.
+			TArray<FBlueprintCompiledStatement*> StageStatements;
+			FBlueprintCompiledStatement* FirstStageStatement = nullptr;
+
+			// Trace the previous stage if it was executed
+			if ((TraceStartTerm != nullptr) && bAnyStageEmitted)
+			{
+				FirstStageStatement = &EmitTraceCaseTaken(Context, ConditionalSequenceNode, TraceCaseTerm, TraceStartTerm);
+			}
+			bAnyStageEmitted = true;
+
+			// Goto next stage if not Cond
+			if (!IsLiteralTrue(CondPin))
+			{
+				UEdGraphPin* CondNet = FEdGraphUtilities::GetNetFromPin(CondPin);
+				FBPTerminal* CondValueTerm = SnapshotTerms.FindRef(CondNet);
+				if (CondValueTerm == nullptr)
+				{
+					CondValueTerm = Context.NetMap.FindRef(CondNet);
+				}
+
+				FBlueprintCompiledStatement& GotoIfNotStatement = Context.AppendStatementForNode(ConditionalSequenceNode);
+				GotoIfNotStatement.Type = KCST_GotoIfNot;
+				GotoIfNotStatement.LHS = CondValueTerm;
+				StageStatements.Add(&GotoIfNotStatement);
+				FirstStageStatement = (FirstStageStatement != nullptr) ? FirstStageStatement : &GotoIfNotStatement;
+			}
+
+			if (bRecordCaseHits)
+			{
+				FBlueprintCompiledStatement& RecordStatement =
+					EmitRecordCaseHit(Context, ConditionalSequenceNode, Index, EvaluatedConditionCount);
+				FirstStageStatement = (FirstStageStatement != nullptr) ? FirstStageStatement : &RecordStatement;
+			}
+
+			// Trace case = Index
+			// Trace start = BeginTraceCase()
+			if (TraceStartTerm != nullptr)
+			{
+				FBlueprintCompiledStatement& CaseAssignStatement = Context.AppendStatementForNode(ConditionalSequenceNode);
+				CaseAssignStatement.Type = KCST_Assignment;
+				CaseAssignStatement.LHS = TraceCaseTerm;
+				CaseAssignStatement.RHS.Add(
+					CreateLiteralTerminal(Context, ConditionalSequenceNode, UEdGraphSchema_K2::PC_Int, FString::FromInt(Index)));
+				EmitBeginTraceCase(Context, ConditionalSequenceNode, TraceStartTerm);
+				FirstStageStatement = (FirstStageStatement != nullptr) ? FirstStageStatement : &CaseAssignStatement;
+			}
+
+			// Return to next stage after the case execution.
+			// If there is nothing to do after this stage, the flow stack is not needed.
+			const bool bNeedPushState =
+				(Index != LastConnectedCaseIndex) || (DefaultExecPin->LinkedTo.Num() > 0) || (TraceStartTerm != nullptr);
+			if (bNeedPushState)
+			{
+				FBlueprintCompiledStatement& PushStateStatement = Context.AppendStatementForNode(ConditionalSequenceNode);
+				PushStateStatement.Type = KCST_PushState;
+				StageStatements.Add(&PushStateStatement);
+				FirstStageStatement = (FirstStageStatement != nullptr) ? FirstStageStatement : &PushStateStatement;
+			}
+
+			// Goto case execution
+			FBlueprintCompiledStatement& GotoStatement = Context.AppendStatementForNode(ConditionalSequenceNode);
+			GotoStatement.Type = KCST_UnconditionalGoto;
+			Context.GotoFixupRequestMap.Add(&GotoStatement, ExecPin);
+
+			ResolveNextStage((FirstStageStatement != nullptr) ? *FirstStageStatement : GotoStatement);
+			NextStageStatements.Append(StageStatements);
+		}
+
+		// Goto default
+		TArray<FBlueprintCompiledStatement*>& NodeStatements = Context.StatementsPerNode.FindOrAdd(ConditionalSequenceNode);
+		const int32 DefaultStatementIndex = NodeStatements.Num();
+		if ((TraceStartTerm != nullptr) && bAnyStageEmitted)
+		{
+			EmitTraceCaseTaken(Context, ConditionalSequenceNode, TraceCaseTerm, TraceStartTerm);
+		}
+		if (bRecordCaseHits)
+		{
+			EmitRecordCaseHit(Context, ConditionalSequenceNode, INDEX_NONE, EvaluatedConditionCount);
+		}
+		GenerateSimpleThenGoto(Context, *ConditionalSequenceNode, DefaultExecPin);
+		if (NodeStatements.IsValidIndex(DefaultStatementIndex))
+		{
+			ResolveNextStage(*NodeStatements[DefaultStatementIndex]);
+		}
+	}
+
+private:
+	static bool IsLiteralTrue(const UEdGraphPin* CondPin)
+	{
+		bool bLiteralValue = false;
+		return IsLiteralCondition(CondPin, bLiteralValue) && bLiteralValue;
+	}
+
+	static bool IsLiteralFalse(const UEdGraphPin* CondPin)
+	{
+		bool bLiteralValue = true;
+		return IsLiteralCondition(CondPin, bLiteralValue) && !bLiteralValue;
+	}
+
+	// Return the condition nets which are copied on snapshot mode without duplication.
+	// The condition of the first executed stage is not copied because nothing is executed before it.
+	static TArray<UEdGraphPin*> GetSnapshotConditionNets(const UK2Node_ConditionalSequence* ConditionalSequenceNode)
+	{
+		TArray<UEdGraphPin*> Nets;
+		if (!ConditionalSequenceNode->bSnapshotConditions)
+		{
+			return Nets;
+		}
+
+		bool bCaseExecutedBefore = false;
+		for (const CasePinPair& Pair : ConditionalSequenceNode->GetCasePinPairs())
+		{
+			if ((Pair.Value->LinkedTo.Num() == 0) || IsLiteralFalse(Pair.Key))
+			{
+				continue;
+			}
+
+			if (bCaseExecutedBefore && (Pair.Key->LinkedTo.Num() > 0))
+			{
+				Nets.AddUnique(FEdGraphUtilities::GetNetFromPin(Pair.Key));
+			}
+			bCaseExecutedBefore = true;
+		}
+
+		return Nets;
+	}
+
+	static FString GetSnapshotTerminalName(const UEdGraphNode* Node, int32 Index)
+	{
+		return FString::Printf(TEXT("ACF_Snapshot_%s_%d"), *Node->GetName(), Index);
+	}
+
+	// Find the local created by RegisterNets.
+	static FBPTerminal* FindSnapshotTerminal(FKismetFunctionContext& Context, const UEdGraphNode* Node, int32 Index)
+	{
+		const FString Name = GetSnapshotTerminalName(Node, Index);
+		TIndirectArray<FBPTerminal>& Terms = Context.IsEventGraph() ? Context.EventGraphLocals : Context.Locals;
+		for (FBPTerminal& Term : Terms)
+		{
+			if ((Term.Source == Node) && (Term.Name == Name))
+			{
+				return &Term;
+			}
+		}
+
+		return nullptr;
+	}
+};
+
 UK2Node_ConditionalSequence::UK2Node_ConditionalSequence(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	NodeContextMenuSectionName = "K2NodeConditionalSequence";
@@ -26,6 +330,7 @@ UK2Node_ConditionalSequence::UK2Node_ConditionalSequence(const FObjectInitialize
 	CaseValuePinNamePrefix = TEXT("CaseExec");
 	CaseKeyPinFriendlyNamePrefix = TEXT("Condition ");
 	CaseValuePinFriendlyNamePrefix = TEXT(" ");
+	CaseLayoutVersion = 1;
 }
 
 void UK2Node_ConditionalSequence::AllocateDefaultPins()
@@ -76,42 +381,52 @@ void UK2Node_ConditionalSequence::ReallocatePinsDuringReconstruction(TArray<UEdG
 
 void UK2Node_ConditionalSequence::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
 {
+	SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_ExpandNode);
+
 	Super::ExpandNode(CompilerContext, SourceGraph);
 
-	TArray<CasePinPair> CasePairs = GetCasePinPairs();
+	// On snapshot mode, the conditions are copied by the node handler.
+	if (bSnapshotConditions)
+	{
+		return;
+	}
 
-	UEdGraphPin* ExecTriggeringPin = GetExecPin();
-	UEdGraphPin* DefaultExecPin = FindPin(DefaultExecPinName);
+	TArray<CasePinPair> CasePairs = GetCasePinPairs();
 
+	// The conditions are evaluated lazily when each stage runs.
+	// The pure nodes connected to this node are evaluated before its first stage, so the condition which may be changed by the
+	// previous case executions is evaluated by the intermediate Branch node.
+	// The condition pin on this node is set to true instead of keeping the expansion result on this node, so that the node
+	// handler does not depend on the state between ExpandNode and Compile.
+	bool bCaseExecutedBefore = false;
+	for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
 	{
-		UK2Node_ExecutionSequence* Sequence = CompilerContext.SpawnIntermediateNode<UK2Node_ExecutionSequence>(this, SourceGraph);
-		Sequence->AllocateDefaultPins();
-
-		CompilerContext.MovePinLinksToIntermediate(*ExecTriggeringPin, *Sequence->GetExecPin());
+		UEdGraphPin* CaseCondPin = CasePairs[Index].Key;
+		UEdGraphPin* CaseExecPin = CasePairs[Index].Value;
+		if (CaseExecPin->LinkedTo.Num() == 0)
+		{
+			continue;
+		}
 
-		for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+		if (bCaseExecutedBefore && !IsConditionReadOnEvaluation(CaseCondPin))
 		{
 			UK2Node_IfThenElse* IfThenElse = CompilerContext.SpawnIntermediateNode<UK2Node_IfThenElse>(this, SourceGraph);
 			IfThenElse->AllocateDefaultPins();
 
-			Sequence->AddInputPin();
+			CompilerContext.MovePinLinksToIntermediate(*CaseExecPin, *IfThenElse->GetThenPin());
+			CompilerContext.MovePinLinksToIntermediate(*CaseCondPin, *IfThenElse->GetConditionPin());
+			CaseExecPin->MakeLinkTo(IfThenElse->GetExecPin());
 
-			UEdGraphPin* CaseCondPin = CasePairs[Index].Key;
-			UEdGraphPin* CaseExecPin = CasePairs[Index].Value;
-			UEdGraphPin* SequenceExecPin = Sequence->GetThenPinGivenIndex(Index);
-			UEdGraphPin* IfThenElseExecPin = IfThenElse->GetExecPin();
-			UEdGraphPin* IfThenElseThenPin = IfThenElse->GetThenPin();
-			UEdGraphPin* IfThenElseCondPin = IfThenElse->GetConditionPin();
-
-			SequenceExecPin->MakeLinkTo(IfThenElseExecPin);
-			CompilerContext.MovePinLinksToIntermediate(*CaseExecPin, *IfThenElseThenPin);
-			CompilerContext.MovePinLinksToIntermediate(*CaseCondPin, *IfThenElseCondPin);
+			CaseCondPin->DefaultValue = TEXT("true");
 		}
 
-		CompilerContext.MovePinLinksToIntermediate(*DefaultExecPin, *Sequence->GetThenPinGivenIndex(CasePairs.Num()));
+		bCaseExecutedBefore = true;
 	}
+}
 
-	BreakAllNodeLinks();
+class FNodeHandlingFunctor* UK2Node_ConditionalSequence::CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const
+{
+	return new FKCHandler_ConditionalSequence(CompilerContext);
 }
 
 void UK2Node_ConditionalSequence::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
@@ -153,7 +468,7 @@ CasePinPair UK2Node_ConditionalSequence::AddCasePinPair(int32 CaseIndex)
 
 	{
 		FCreatePinParams Params;
-		Params.Index = 2 + CaseIndex;
+		Params.Index = GetCasePinInsertIndex(2 + CaseIndex);
 		Pair.Key = CreatePin(
 			EGPD_Input, UEdGraphSchema_K2::PC_Boolean, *GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex), Params);
 		Pair.Key->PinFriendlyName =
@@ -161,13 +476,15 @@ CasePinPair UK2Node_ConditionalSequence::AddCasePinPair(int32 CaseIndex)
 	}
 	{
 		FCreatePinParams Params;
-		Params.Index = 2 + N + 1 + CaseIndex;
+		Params.Index = GetCasePinInsertIndex(2 + N + 1 + CaseIndex);
 		Pair.Value = CreatePin(
 			EGPD_Output, UEdGraphSchema_K2::PC_Exec, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
 		Pair.Value->PinFriendlyName =
 			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
 	}
 
+	RegisterCasePinPair(CaseIndex, Pair);
+
 	return Pair;
 }
 
@@ -176,4 +493,22 @@ UEdGraphPin* UK2Node_ConditionalSequence::GetDefaultExecPin() const
 	return FindPin(DefaultExecPinName);
 }
 
+bool UK2Node_ConditionalSequence::IsConditionReadOnEvaluation(const UEdGraphPin* CondPin) const
+{
+	// Literal value.
+	if (CondPin->LinkedTo.Num() == 0)
+	{
+		return true;
+	}
+
+	// Variable getter refers to the variable directly, so the current value is read.
+	UK2Node_VariableGet* VariableGet = Cast<UK2Node_VariableGet>(CondPin->LinkedTo[0]->GetOwningNode());
+	if ((VariableGet != nullptr) && VariableGet->IsNodePure())
+	{
+		return true;
+	}
+
+	return false;
+}
+
 #undef LOCTEXT_NAMESPACE
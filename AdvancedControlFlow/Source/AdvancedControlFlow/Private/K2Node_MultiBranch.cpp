@@ -9,22 +9,26 @@
 
 #include "K2Node_MultiBranch.h"
 
+#include "AdvancedControlFlowCaseHitCounter.h"
+#include "AdvancedControlFlowCompilerUtils.h"
+#include "AdvancedControlFlowStats.h"
 #include "BlueprintNodeSpawner.h"
 #include "EdGraphSchema_K2.h"
 #include "EdGraphUtilities.h"
 #include "EditorCategoryUtils.h"
 #include "GraphEditorSettings.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
 #include "KismetCompiledFunctionContext.h"
 #include "KismetCompiler.h"
 #include "KismetCompilerMisc.h"
+#include "ScopedTransaction.h"
+#include "ToolMenu.h"
 
 #define LOCTEXT_NAMESPACE "AdvancedControlFlow"
 
 class FKCHandler_MultiBranch : public FNodeHandlingFunctor
 {
-	TMap<UEdGraphNode*, FBPTerminal*> BoolTermMap;
-
 public:
 	FKCHandler_MultiBranch(FKismetCompilerContext& InCompilerContext) : FNodeHandlingFunctor(InCompilerContext)
 	{
@@ -32,19 +36,15 @@ public:
 
 	virtual void RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node) override
 	{
-		UK2Node_MultiBranch* MultiBranchNode = CastChecked<UK2Node_MultiBranch>(Node);
+		SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_RegisterNets);
 
 		FNodeHandlingFunctor::RegisterNets(Context, Node);
-
-		FBPTerminal* BoolTerm = Context.CreateLocalTerminal();
-		BoolTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-		BoolTerm->Source = Node;
-		BoolTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("Inverted"));
-		BoolTermMap.Add(Node, BoolTerm);
 	}
 
 	virtual void Compile(FKismetFunctionContext& Context, UEdGraphNode* Node) override
 	{
+		SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_Compile);
+
 		UK2Node_MultiBranch* MultiBranchNode = CastChecked<UK2Node_MultiBranch>(Node);
 
 		FEdGraphPinType ExpectedExecPinType;
@@ -69,52 +69,134 @@ public:
 		}
 
 		UEdGraphPin* DefaultExecPin = MultiBranchNode->GetDefaultExecPin();
-
-		UEdGraphPin* FunctionPin = MultiBranchNode->GetFunctionPin();
-		FBPTerminal* FunctionContext = Context.NetMap.FindRef(FunctionPin);
-		UClass* FunctionClass = Cast<UClass>(FunctionPin->PinType.PinSubCategoryObject.Get());
-		UFunction* FunctionPtr = FindUField<UFunction>(FunctionClass, FunctionPin->PinName);
-		check(FunctionPtr);
-
-		FBPTerminal* BoolTerm = BoolTermMap.FindRef(MultiBranchNode);
-
-		for (auto PinIt = MultiBranchNode->Pins.CreateIterator(); PinIt; ++PinIt)
+		INC_DWORD_STAT_BY(STAT_AdvancedControlFlow_CompiledCasePairs, MultiBranchNode->GetCasePinCount());
+
+		// Each case is compiled to the conditional jumps only.
+		//   GotoIfNot Cond[i] -> (Next case)
+		//   (RecordCaseHit i, Number of the tested conditions)
+		//   (TraceCaseTaken i, Trace start)
+		//   Goto CaseExec[i]
+		// The cases are tested in the pin order, or in the order of the case hit counts if they are mutually exclusive.
+		// The literal conditions are folded. The case which is always false is removed, and the case which is always true
+		// has no GotoIfNot and the following cases are removed.
+		// If the cases are traced, "Trace start = BeginTraceCase()" is emitted first, so the traced duration is the time to
+		// decide the case.
+		const bool bRecordCaseHits = ShouldRecordCaseHits();
+		FBPTerminal* TraceStartTerm = nullptr;
+		if (ShouldTraceCases())
+		{
+			TraceStartTerm = FindOrCreateTraceStartTerminal(Context, MultiBranchNode);
+			EmitBeginTraceCase(Context, MultiBranchNode, TraceStartTerm);
+		}
+		const TArray<int32> CaseOrder = MultiBranchNode->GetCaseEvaluationOrder();
+		const TArray<CasePinPair> CasePairs = MultiBranchNode->GetCasePinPairs();
+		int32 TestedConditionCount = 0;
+		UEdGraphPin* AlwaysTakenCondPin = nullptr;
+		FBlueprintCompiledStatement* PrevGotoIfNotStatement = nullptr;
+		for (int32 OrderIndex = 0; OrderIndex < CaseOrder.Num(); ++OrderIndex)
 		{
-			UEdGraphPin* ExecPin = *PinIt;
+			const int32 CaseIndex = CaseOrder[OrderIndex];
+			UEdGraphPin* CondPin = CasePairs[CaseIndex].Key;
+			UEdGraphPin* ExecPin = CasePairs[CaseIndex].Value;
 
-			if (ExecPin->Direction != EGPD_Output)
+			if (AlwaysTakenCondPin != nullptr)
 			{
+				CompilerContext.MessageLog.Note(
+					*LOCTEXT("UnreachableCasePruned_Note", "@@: @@ is removed because @@ is always true").ToString(),
+					MultiBranchNode, CondPin, AlwaysTakenCondPin);
 				continue;
 			}
-			if (ExecPin->GetFName() == DefaultExecPinName)
+
+			bool bLiteralValue = false;
+			const bool bIsLiteral = IsLiteralCondition(CondPin, bLiteralValue);
+			if (bIsLiteral && !bLiteralValue)
 			{
+				CompilerContext.MessageLog.Note(
+					*LOCTEXT("AlwaysFalseCasePruned_Note", "@@: @@ is removed because it is always false").ToString(),
+					MultiBranchNode, CondPin);
 				continue;
 			}
 
-			UEdGraphPin* CondPin = MultiBranchNode->GetCaseKeyPinFromCaseValuePin(ExecPin);
-			UEdGraphPin* CondNet = FEdGraphUtilities::GetNetFromPin(CondPin);
-			FBPTerminal* CondValueTerm = Context.NetMap.FindRef(CondNet);
+			// Goto next case if not Cond
+			FBlueprintCompiledStatement* GotoIfNotStatement = nullptr;
+			if (!bIsLiteral)
+			{
+				UEdGraphPin* CondNet = FEdGraphUtilities::GetNetFromPin(CondPin);
+				FBPTerminal* CondValueTerm = Context.NetMap.FindRef(CondNet);
+
+				GotoIfNotStatement = &Context.AppendStatementForNode(MultiBranchNode);
+				GotoIfNotStatement->Type = KCST_GotoIfNot;
+				GotoIfNotStatement->LHS = CondValueTerm;
+				++TestedConditionCount;
+			}
+
+			FBlueprintCompiledStatement* RecordStatement = nullptr;
+			if (bRecordCaseHits)
+			{
+				RecordStatement = &EmitRecordCaseHit(Context, MultiBranchNode, CaseIndex, TestedConditionCount);
+			}
+			if (TraceStartTerm != nullptr)
+			{
+				FBlueprintCompiledStatement& TraceStatement =
+					EmitTraceCaseTaken(Context, MultiBranchNode, CaseIndex, TraceStartTerm);
+				RecordStatement = (RecordStatement != nullptr) ? RecordStatement : &TraceStatement;
+			}
+
+			// Goto case execution
+			FBlueprintCompiledStatement& GotoStatement = Context.AppendStatementForNode(MultiBranchNode);
+			GotoStatement.Type = KCST_UnconditionalGoto;
+			Context.GotoFixupRequestMap.Add(&GotoStatement, ExecPin);
 
-			// Goto if Not_PreBool(Cond)
+			if (PrevGotoIfNotStatement != nullptr)
+			{
+				FBlueprintCompiledStatement* CaseStatement = &GotoStatement;
+				if (GotoIfNotStatement != nullptr)
+				{
+					CaseStatement = GotoIfNotStatement;
+				}
+				else if (RecordStatement != nullptr)
+				{
+					CaseStatement = RecordStatement;
+				}
+				PrevGotoIfNotStatement->TargetLabel = CaseStatement;
+				CaseStatement->bIsJumpTarget = true;
+			}
+
+			PrevGotoIfNotStatement = GotoIfNotStatement;
+			if (bIsLiteral)
+			{
+				AlwaysTakenCondPin = CondPin;
+			}
+		}
+
+		if (AlwaysTakenCondPin != nullptr)
+		{
+			if (DefaultExecPin->LinkedTo.Num() > 0)
 			{
-				FBlueprintCompiledStatement& CallFuncStatement = Context.AppendStatementForNode(MultiBranchNode);
-				CallFuncStatement.Type = KCST_CallFunction;
-				CallFuncStatement.FunctionToCall = FunctionPtr;
-				CallFuncStatement.FunctionContext = FunctionContext;
-				CallFuncStatement.bIsParentContext = false;
-				CallFuncStatement.LHS = BoolTerm;
-				CallFuncStatement.RHS.Add(CondValueTerm);
-
-				FBlueprintCompiledStatement& GotoStatement = Context.AppendStatementForNode(MultiBranchNode);
-				GotoStatement.Type = KCST_GotoIfNot;
-				GotoStatement.LHS = BoolTerm;
-
-				Context.GotoFixupRequestMap.Add(&GotoStatement, ExecPin);
+				CompilerContext.MessageLog.Note(
+					*LOCTEXT("UnreachableDefaultPruned_Note", "@@: @@ is never executed because @@ is always true").ToString(),
+					MultiBranchNode, DefaultExecPin, AlwaysTakenCondPin);
 			}
+			return;
 		}
 
 		// Goto default
+		TArray<FBlueprintCompiledStatement*>& NodeStatements = Context.StatementsPerNode.FindOrAdd(MultiBranchNode);
+		const int32 DefaultStatementIndex = NodeStatements.Num();
+		if (bRecordCaseHits)
+		{
+			EmitRecordCaseHit(Context, MultiBranchNode, INDEX_NONE, TestedConditionCount);
+		}
+		if (TraceStartTerm != nullptr)
+		{
+			EmitTraceCaseTaken(Context, MultiBranchNode, INDEX_NONE, TraceStartTerm);
+		}
 		GenerateSimpleThenGoto(Context, *MultiBranchNode, DefaultExecPin);
+		if ((PrevGotoIfNotStatement != nullptr) && NodeStatements.IsValidIndex(DefaultStatementIndex))
+		{
+			PrevGotoIfNotStatement->TargetLabel = NodeStatements[DefaultStatementIndex];
+			NodeStatements[DefaultStatementIndex]->bIsJumpTarget = true;
+		}
 	}
 };
 
@@ -128,6 +210,7 @@ UK2Node_MultiBranch::UK2Node_MultiBranch(const FObjectInitializer& ObjectInitial
 	CaseValuePinNamePrefix = TEXT("CaseExec");
 	CaseKeyPinFriendlyNamePrefix = TEXT("Condition ");
 	CaseValuePinFriendlyNamePrefix = TEXT(" ");
+	CaseLayoutVersion = 1;
 }
 
 void UK2Node_MultiBranch::AllocateDefaultPins()
@@ -135,7 +218,7 @@ void UK2Node_MultiBranch::AllocateDefaultPins()
 	// Pin structure
 	//   N: Number of case pin pair
 	// -----
-	// 0: Internal function (Hidden, Object)
+	// 0: Internal function (Hidden, Object, kept for the compatibility of the pin layout)
 	// 1: Execution Triggering (In, Exec)
 	// 2: Default Execution (Out, Exec)
 	// 3 - 2+N: Case Conditional (In, Boolean)
@@ -169,6 +252,36 @@ FSlateIcon UK2Node_MultiBranch::GetIconAndTint(FLinearColor& OutColor) const
 	return Icon;
 }
 
+void UK2Node_MultiBranch::GetNodeContextMenuActions(class UToolMenu* Menu, class UGraphNodeContextMenuContext* Context) const
+{
+	Super::GetNodeContextMenuActions(Menu, Context);
+
+	if (Context->bIsDebugging)
+	{
+		return;
+	}
+
+	FToolMenuSection& Section = Menu->FindOrAddSection(NodeContextMenuSectionName);
+#if ACF_WITH_CASE_HIT_COUNTERS
+	if (FAdvancedControlFlowCaseHitCounter::Get().HasAnyHits())
+	{
+		Section.AddMenuEntry("ApplyRecordedCaseHits", LOCTEXT("ApplyRecordedCaseHits", "Apply recorded case hits"),
+			LOCTEXT("ApplyRecordedCaseHitsTooltip",
+				"Store the case hits recorded by acf.RecordCaseHits on this node to reorder the mutually exclusive cases"),
+			FSlateIcon(),
+			FUIAction(FExecuteAction::CreateUObject(
+				const_cast<UK2Node_MultiBranch*>(this), &UK2Node_MultiBranch::ApplyRecordedCaseHits)));
+	}
+#endif
+	if (CaseHitCounts.Num() > 0)
+	{
+		Section.AddMenuEntry("ClearCaseHitCounts", LOCTEXT("ClearCaseHitCounts", "Clear stored case hits"),
+			LOCTEXT("ClearCaseHitCountsTooltip", "Clear the case hits stored on this node"), FSlateIcon(),
+			FUIAction(
+				FExecuteAction::CreateUObject(const_cast<UK2Node_MultiBranch*>(this), &UK2Node_MultiBranch::ClearCaseHitCounts)));
+	}
+}
+
 void UK2Node_MultiBranch::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
 {
 	CreateFunctionPin();
@@ -207,7 +320,7 @@ CasePinPair UK2Node_MultiBranch::AddCasePinPair(int32 CaseIndex)
 
 	{
 		FCreatePinParams Params;
-		Params.Index = 3 + CaseIndex;
+		Params.Index = GetCasePinInsertIndex(3 + CaseIndex);
 		Pair.Key = CreatePin(
 			EGPD_Input, UEdGraphSchema_K2::PC_Boolean, *GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex), Params);
 		Pair.Key->PinFriendlyName =
@@ -215,13 +328,15 @@ CasePinPair UK2Node_MultiBranch::AddCasePinPair(int32 CaseIndex)
 	}
 	{
 		FCreatePinParams Params;
-		Params.Index = 3 + N + 1 + CaseIndex;
+		Params.Index = GetCasePinInsertIndex(3 + N + 1 + CaseIndex);
 		Pair.Value = CreatePin(
 			EGPD_Output, UEdGraphSchema_K2::PC_Exec, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
 		Pair.Value->PinFriendlyName =
 			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
 	}
 
+	RegisterCasePinPair(CaseIndex, Pair);
+
 	return Pair;
 }
 
@@ -270,6 +385,64 @@ UEdGraphPin* UK2Node_MultiBranch::GetDefaultExecPin() const
 	return FindPin(DefaultExecPinName);
 }
 
+TArray<int32> UK2Node_MultiBranch::GetCaseEvaluationOrder() const
+{
+	TArray<CasePinPair> CasePairs = GetCasePinPairs();
+	TArray<int32> CaseOrder;
+	CaseOrder.Reserve(CasePairs.Num());
+	for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+	{
+		CaseOrder.Add(Index);
+	}
+
+	if (bCasesMutuallyExclusive && (CaseHitCounts.Num() > 0))
+	{
+		// The cases which have the same hit count keep the pin order.
+		TArray<int64> Hits;
+		Hits.Reserve(CasePairs.Num());
+		for (const CasePinPair& Pair : CasePairs)
+		{
+			Hits.Add(CaseHitCounts.FindRef(Pair.Value->PinId));
+		}
+		CaseOrder.StableSort([&Hits](int32 A, int32 B) { return Hits[A] > Hits[B]; });
+	}
+
+	return CaseOrder;
+}
+
+void UK2Node_MultiBranch::ApplyRecordedCaseHits()
+{
+#if ACF_WITH_CASE_HIT_COUNTERS
+	TArray<FAdvancedControlFlowCaseHit> Hits;
+	if (!FAdvancedControlFlowCaseHitCounter::Get().GetHits(GetCaseHitCounterKey(this), Hits))
+	{
+		return;
+	}
+
+	const FScopedTransaction Transaction(LOCTEXT("ApplyRecordedCaseHitsTransaction", "Apply Recorded Case Hits"));
+	Modify();
+
+	CaseHitCounts.Reset();
+	TArray<CasePinPair> CasePairs = GetCasePinPairs();
+	for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+	{
+		CaseHitCounts.Add(CasePairs[Index].Value->PinId, Hits.IsValidIndex(1 + Index) ? Hits[1 + Index].HitCount : 0);
+	}
+
+	FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+#endif
+}
+
+void UK2Node_MultiBranch::ClearCaseHitCounts()
+{
+	const FScopedTransaction Transaction(LOCTEXT("ClearCaseHitCountsTransaction", "Clear Stored Case Hits"));
+	Modify();
+
+	CaseHitCounts.Reset();
+
+	FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+}
+
 UEdGraphPin* UK2Node_MultiBranch::GetFunctionPin() const
 {
 	return FindPin(ConditionPreProcessFuncName);
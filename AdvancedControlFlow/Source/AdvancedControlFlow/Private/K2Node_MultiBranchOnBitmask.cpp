@@ -0,0 +1,466 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "K2Node_MultiBranchOnBitmask.h"
+
+#include "AdvancedControlFlowCompilerUtils.h"
+#include "AdvancedControlFlowEditorUtils.h"
+#include "AdvancedControlFlowLibrary.h"
+#include "AdvancedControlFlowStats.h"
+#include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "EdGraphUtilities.h"
+#include "EditorCategoryUtils.h"
+#include "GraphEditorSettings.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "KismetCompiledFunctionContext.h"
+#include "KismetCompiler.h"
+#include "KismetCompilerMisc.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+const FName MaskPinName(TEXT("Mask"));
+const FName BitmaskCompareFunctionLibraryPinName(TEXT("CompareFunctionLibrary"));
+const FName BitmaskBitFunctionLibraryPinName(TEXT("BitFunctionLibrary"));
+
+struct FMultiBranchOnBitmaskCase
+{
+	UEdGraphPin* BitPin;
+	UEdGraphPin* ExecPin;
+	FBPTerminal* BitTerm;
+	int32 Bit;
+};
+
+class FKCHandler_MultiBranchOnBitmask : public FNodeHandlingFunctor
+{
+public:
+	FKCHandler_MultiBranchOnBitmask(FKismetCompilerContext& InCompilerContext) : FNodeHandlingFunctor(InCompilerContext)
+	{
+	}
+
+	virtual void RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_RegisterNets);
+
+		UK2Node_MultiBranchOnBitmask* MultiBranchNode = CastChecked<UK2Node_MultiBranchOnBitmask>(Node);
+
+		if (!UK2Node_MultiBranchOnBitmask::IsSupportedMaskType(MultiBranchNode->GetMaskPin()->PinType))
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("InvalidMaskForMultiBranchOnBitmask_Error", "@@ must have a connected integer mask").ToString(),
+				MultiBranchNode);
+			return;
+		}
+
+		FNodeHandlingFunctor::RegisterNets(Context, Node);
+
+		FindOrCreateScratchBoolTerminal(Context, Node);
+		FindOrCreateScratchIntTerminal(Context, Node);
+	}
+
+	// clang-format off
+	/*
+	 * Generated code
+	 *
+	 *          ACF_Scratch = FindLowestSetBit(Mask, (1 << Bit 0) | (1 << Bit 1) | ...)
+	 *          (Same as Multi-Branch on Value (Equal) with the value ACF_Scratch and the keys Bit 0, Bit 1, ...)
+	 *
+	 * The lowest bit is found by one native call (count trailing zeros), so the dispatch needs only log2(N) comparisons
+	 * instead of testing the bits one by one. ACF_Scratch is -1 when no case bit is set, which goes to default.
+	 */
+	// clang-format on
+	virtual void Compile(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_Compile);
+
+		UK2Node_MultiBranchOnBitmask* MultiBranchNode = CastChecked<UK2Node_MultiBranchOnBitmask>(Node);
+
+		FEdGraphPinType ExpectedExecPinType;
+		ExpectedExecPinType.PinCategory = UEdGraphSchema_K2::PC_Exec;
+
+		{
+			UEdGraphPin* ExecTriggeringPin =
+				Context.FindRequiredPinByName(MultiBranchNode, UEdGraphSchema_K2::PN_Execute, EGPD_Input);
+			if ((ExecTriggeringPin == nullptr) || !Context.ValidatePinType(ExecTriggeringPin, ExpectedExecPinType))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("NoValidExecutionPinForMultiBranchOnBitmask_Error", "@@ must have a valid execution pin @@")
+						 .ToString(),
+					MultiBranchNode, ExecTriggeringPin);
+				return;
+			}
+			else if (ExecTriggeringPin->LinkedTo.Num() == 0)
+			{
+				CompilerContext.MessageLog.Warning(
+					*LOCTEXT("NodeNeverExecuted_Warning", "@@ will never be executed").ToString(), MultiBranchNode);
+				return;
+			}
+		}
+
+		UEdGraphPin* MaskPin = MultiBranchNode->GetMaskPin();
+		const bool bIsInt64 = MaskPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Int64;
+		const int32 BitCount = bIsInt64 ? 64 : 32;
+
+		FBPTerminal* MaskTerm = Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(MaskPin));
+		FBPTerminal* BitFunctionContext = Context.NetMap.FindRef(MultiBranchNode->GetBitFunctionPin());
+		UFunction* FindLowestSetBitFunction = FindUField<UFunction>(UAdvancedControlFlowLibrary::StaticClass(),
+			bIsInt64 ? GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowLibrary, FindLowestSetBit64)
+					 : GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowLibrary, FindLowestSetBit));
+
+		FDispatchTreeContext TreeContext;
+		TreeContext.Node = MultiBranchNode;
+		TreeContext.SelectionTerm = FindOrCreateScratchIntTerminal(Context, MultiBranchNode);
+		TreeContext.BoolTerm = FindOrCreateScratchBoolTerminal(Context, MultiBranchNode);
+		TreeContext.FunctionContext = Context.NetMap.FindRef(MultiBranchNode->GetCompareFunctionPin());
+		TreeContext.LessFunction = FindUField<UFunction>(UKismetMathLibrary::StaticClass(), TEXT("Less_IntInt"));
+		TreeContext.EqualFunction = FindUField<UFunction>(UKismetMathLibrary::StaticClass(), TEXT("EqualEqual_IntInt"));
+		TreeContext.DefaultExecPin = MultiBranchNode->GetDefaultExecPin();
+		if ((MaskTerm == nullptr) || (FindLowestSetBitFunction == nullptr) || (TreeContext.LessFunction == nullptr) ||
+			(TreeContext.EqualFunction == nullptr))
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("InvalidTermForMultiBranchOnBitmask_Error", "@@ has an invalid mask pin @@").ToString(), MultiBranchNode,
+				MaskPin);
+			return;
+		}
+
+		TArray<FMultiBranchOnBitmaskCase> Cases;
+		if (!CollectCases(Context, MultiBranchNode, BitCount, Cases))
+		{
+			return;
+		}
+		INC_DWORD_STAT_BY(STAT_AdvancedControlFlow_CompiledCasePairs, MultiBranchNode->GetCasePinCount());
+
+		uint64 CaseBits = 0;
+		TArray<FDispatchTreeCase> TreeCases;
+		for (const FMultiBranchOnBitmaskCase& Case : Cases)
+		{
+			CaseBits |= 1ULL << Case.Bit;
+			TreeCases.Add({Case.BitTerm, Case.ExecPin});
+		}
+
+		// The bits which no case is mapped to are masked out, so that the lower unmapped bit does not hide the mapped one.
+		FBPTerminal* CaseBitsTerm = Context.CreateLocalTerminal(ETerminalSpecification::TS_Literal);
+		CaseBitsTerm->Type.PinCategory = MaskPin->PinType.PinCategory;
+		CaseBitsTerm->Source = MultiBranchNode;
+		CaseBitsTerm->Name = bIsInt64 ? FString::Printf(TEXT("%lld"), static_cast<int64>(CaseBits))
+									  : FString::FromInt(static_cast<int32>(static_cast<uint32>(CaseBits)));
+
+		FBlueprintCompiledStatement& CallFuncStatement = Context.AppendStatementForNode(MultiBranchNode);
+		CallFuncStatement.Type = KCST_CallFunction;
+		CallFuncStatement.FunctionToCall = FindLowestSetBitFunction;
+		CallFuncStatement.FunctionContext = BitFunctionContext;
+		CallFuncStatement.bIsParentContext = false;
+		CallFuncStatement.LHS = TreeContext.SelectionTerm;
+		CallFuncStatement.RHS.Add(MaskTerm);
+		CallFuncStatement.RHS.Add(CaseBitsTerm);
+
+		EmitEqualDispatchTree(Context, TreeContext, TreeCases);
+	}
+
+private:
+	// Collect the cases sorted by the bit in ascending order.
+	// The case whose bit is out of range or duplicated is removed with a warning.
+	bool CollectCases(FKismetFunctionContext& Context, UK2Node_MultiBranchOnBitmask* Node, int32 BitCount,
+		TArray<FMultiBranchOnBitmaskCase>& OutCases)
+	{
+		TArray<FMultiBranchOnBitmaskCase> Cases;
+		for (const CasePinPair& Pair : Node->GetCasePinPairs())
+		{
+			FMultiBranchOnBitmaskCase Case;
+			Case.BitPin = Pair.Key;
+			Case.ExecPin = Pair.Value;
+			Case.BitTerm = Context.NetMap.FindRef(Pair.Key);
+			Case.Bit = FCString::Atoi(*Pair.Key->GetDefaultAsString());
+			if ((Case.BitTerm == nullptr) || !Case.BitTerm->bIsLiteral)
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("InvalidCaseBitForMultiBranchOnBitmask_Error", "@@ has an invalid case bit @@").ToString(), Node,
+					Pair.Key);
+				return false;
+			}
+			if ((Case.Bit < 0) || (Case.Bit >= BitCount))
+			{
+				CompilerContext.MessageLog.Warning(
+					*FText::Format(LOCTEXT("OutOfRangeBitForMultiBranchOnBitmask_Warning",
+									   "@@ has the case bit @@ which is out of range. The bit must be between 0 and {0}."),
+						FText::AsNumber(BitCount - 1))
+						 .ToString(),
+					Node, Pair.Key);
+				continue;
+			}
+			Cases.Add(Case);
+		}
+
+		Cases.StableSort([](const FMultiBranchOnBitmaskCase& A, const FMultiBranchOnBitmaskCase& B) { return A.Bit < B.Bit; });
+		for (const FMultiBranchOnBitmaskCase& Case : Cases)
+		{
+			if ((OutCases.Num() > 0) && (OutCases.Last().Bit == Case.Bit))
+			{
+				CompilerContext.MessageLog.Warning(
+					*LOCTEXT("DuplicatedBitForMultiBranchOnBitmask_Warning", "@@ has the duplicated case bit @@").ToString(), Node,
+					Case.BitPin);
+				continue;
+			}
+			OutCases.Add(Case);
+		}
+
+		return true;
+	}
+};
+
+UK2Node_MultiBranchOnBitmask::UK2Node_MultiBranchOnBitmask(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeMultiBranchOnBitmask";
+	NodeContextMenuSectionLabel = LOCTEXT("MultiBranchOnBitmask", "Multi-Branch on Bitmask");
+	CaseKeyPinNamePrefix = TEXT("CaseBit");
+	CaseValuePinNamePrefix = TEXT("CaseExec");
+	CaseKeyPinFriendlyNamePrefix = TEXT("Bit ");
+	CaseValuePinFriendlyNamePrefix = TEXT(" ");
+}
+
+void UK2Node_MultiBranchOnBitmask::AllocateDefaultPins()
+{
+	// Pin structure
+	//   N: Number of case pin pair
+	// -----
+	// 0: Internal compare function library (Hidden, Object)
+	// 1: Internal bit function library (Hidden, Object)
+	// 2: Execution Triggering (In, Exec)
+	// 3: Mask (In, Wildcard -> Integer/Integer64)
+	// 4: Default Execution (Out, Exec)
+	// 5 - 4+N: Case Bit (In, Integer, Not connectable)
+	// 4+N+1 - 4+2*N: Case Execution (Out, Exec)
+
+	CreateFunctionPins();
+	CreateExecTriggeringPin();
+	CreateMaskPin();
+	CreateDefaultExecPin();
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_MultiBranchOnBitmask::GetTooltipText() const
+{
+	return LOCTEXT("MultiBranchOnBitmaskStatement_Tooltip",
+		"Multi-Branch on Bitmask Statement\nExecution goes where the lowest bit set in the mask is mapped to");
+}
+
+FLinearColor UK2Node_MultiBranchOnBitmask::GetNodeTitleColor() const
+{
+	return GetDefault<UGraphEditorSettings>()->ExecBranchNodeTitleColor;
+}
+
+FText UK2Node_MultiBranchOnBitmask::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("MultiBranchOnBitmask", "Multi-Branch on Bitmask");
+}
+
+FSlateIcon UK2Node_MultiBranchOnBitmask::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static FSlateIcon Icon("EditorStyle", "GraphEditor.Switch_16x");
+	return Icon;
+}
+
+void UK2Node_MultiBranchOnBitmask::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_PinConnectionListChanged);
+
+	if ((Pin == nullptr) || (Pin != GetMaskPin()))
+	{
+		return;
+	}
+
+	if (Pin->LinkedTo.Num() == 0)
+	{
+		// Ignore the disconnection event.
+		return;
+	}
+
+	if (Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard)
+	{
+		// Pin type has already fixed.
+		return;
+	}
+
+	Super::PinConnectionListChanged(Pin);
+
+	Modify();
+
+	FEdGraphPinType PinType;
+	PinType.PinCategory = Pin->LinkedTo[0]->PinType.PinCategory;
+	Pin->PinType = PinType;
+
+	RequestDeferredBlueprintModified(GetBlueprint());
+}
+
+void UK2Node_MultiBranchOnBitmask::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	UEdGraphPin* OldMaskPin = nullptr;
+	for (auto& Pin : OldPins)
+	{
+		if (Pin->GetFName() == MaskPinName)
+		{
+			OldMaskPin = Pin;
+			break;
+		}
+	}
+
+	CreateFunctionPins();
+	CreateExecTriggeringPin();
+	CreateMaskPin();
+	CreateDefaultExecPin();
+
+	if (OldMaskPin != nullptr)
+	{
+		GetMaskPin()->PinType = OldMaskPin->PinType;
+	}
+
+	Super::ReallocatePinsDuringReconstruction(OldPins);
+}
+
+class FNodeHandlingFunctor* UK2Node_MultiBranchOnBitmask::CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const
+{
+	return new FKCHandler_MultiBranchOnBitmask(CompilerContext);
+}
+
+void UK2Node_MultiBranchOnBitmask::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+}
+
+FText UK2Node_MultiBranchOnBitmask::GetMenuCategory() const
+{
+	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::FlowControl);
+}
+
+bool UK2Node_MultiBranchOnBitmask::IsConnectionDisallowed(
+	const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const
+{
+	if ((MyPin == GetMaskPin()) && (OtherPin != nullptr) && !IsSupportedMaskType(OtherPin->PinType))
+	{
+		OutReason = LOCTEXT("UnsupportedMaskType", "Only integer or integer64 value can be connected.").ToString();
+		return true;
+	}
+
+	return Super::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
+}
+
+CasePinPair UK2Node_MultiBranchOnBitmask::AddCasePinPair(int32 CaseIndex)
+{
+	CasePinPair Pair;
+	int N = GetCasePinCount();
+
+	{
+		FCreatePinParams Params;
+		Params.Index = GetCasePinInsertIndex(5 + CaseIndex);
+		Pair.Key = CreatePin(
+			EGPD_Input, UEdGraphSchema_K2::PC_Int, *GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Key->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), CaseIndex));
+		// Bits must be the literal to build the decision tree on compile.
+		Pair.Key->bNotConnectable = true;
+		Pair.Key->DefaultValue = FString::FromInt(CaseIndex);
+	}
+	{
+		FCreatePinParams Params;
+		Params.Index = GetCasePinInsertIndex(5 + N + 1 + CaseIndex);
+		Pair.Value = CreatePin(
+			EGPD_Output, UEdGraphSchema_K2::PC_Exec, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Value->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+	}
+
+	RegisterCasePinPair(CaseIndex, Pair);
+
+	return Pair;
+}
+
+void UK2Node_MultiBranchOnBitmask::CreateFunctionPins()
+{
+	UBlueprint* Blueprint = GetBlueprint();
+	int32 PinIndex = 0;
+	for (const TPair<FName, UClass*>& Library :
+		{TPair<FName, UClass*>(BitmaskCompareFunctionLibraryPinName, UKismetMathLibrary::StaticClass()),
+			TPair<FName, UClass*>(BitmaskBitFunctionLibraryPinName, UAdvancedControlFlowLibrary::StaticClass())})
+	{
+		FCreatePinParams Params;
+		Params.Index = PinIndex++;
+		UEdGraphPin* FunctionPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Object, Library.Value, Library.Key, Params);
+		FunctionPin->bDefaultValueIsReadOnly = true;
+		FunctionPin->bNotConnectable = true;
+		FunctionPin->bHidden = true;
+
+		if ((Blueprint != nullptr) && !Blueprint->SkeletonGeneratedClass->IsChildOf(Library.Value))
+		{
+			FunctionPin->DefaultObject = Library.Value->GetDefaultObject();
+		}
+	}
+}
+
+void UK2Node_MultiBranchOnBitmask::CreateExecTriggeringPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 2;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute, Params);
+}
+
+void UK2Node_MultiBranchOnBitmask::CreateMaskPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 3;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, MaskPinName, Params);
+}
+
+void UK2Node_MultiBranchOnBitmask::CreateDefaultExecPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 4;
+	UEdGraphPin* DefaultExecPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, DefaultExecPinName, Params);
+	DefaultExecPin->PinFriendlyName = FText::AsCultureInvariant(DefaultExecPinFriendlyName.ToString());
+}
+
+UEdGraphPin* UK2Node_MultiBranchOnBitmask::GetDefaultExecPin() const
+{
+	return FindPin(DefaultExecPinName);
+}
+
+UEdGraphPin* UK2Node_MultiBranchOnBitmask::GetMaskPin() const
+{
+	return FindPin(MaskPinName);
+}
+
+UEdGraphPin* UK2Node_MultiBranchOnBitmask::GetCompareFunctionPin() const
+{
+	return FindPin(BitmaskCompareFunctionLibraryPinName);
+}
+
+UEdGraphPin* UK2Node_MultiBranchOnBitmask::GetBitFunctionPin() const
+{
+	return FindPin(BitmaskBitFunctionLibraryPinName);
+}
+
+bool UK2Node_MultiBranchOnBitmask::IsSupportedMaskType(const FEdGraphPinType& PinType)
+{
+	if (PinType.ContainerType != EPinContainerType::None)
+	{
+		return false;
+	}
+
+	return (PinType.PinCategory == UEdGraphSchema_K2::PC_Int) || (PinType.PinCategory == UEdGraphSchema_K2::PC_Int64);
+}
+
+#undef LOCTEXT_NAMESPACE
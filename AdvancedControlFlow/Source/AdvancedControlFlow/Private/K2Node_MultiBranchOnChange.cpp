@@ -0,0 +1,276 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "K2Node_MultiBranchOnChange.h"
+
+#include "AdvancedControlFlowLibrary.h"
+#include "AdvancedControlFlowStats.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_AssignmentStatement.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_CustomEvent.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_MakeArray.h"
+#include "K2Node_Self.h"
+#include "K2Node_TemporaryVariable.h"
+#include "KismetCompiler.h"
+
+#if ACF_WITH_FIELD_NOTIFICATION
+#include "INotifyFieldValueChanged.h"
+#endif
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+const FName OnChangeSourcePinName(TEXT("Source"));
+
+// Return the class of the object connected to the source pin (self if unconnected), or nullptr if it is unknown on compile.
+static UClass* GetSourceClass(const UEdGraphPin* SourcePin, UClass* SelfClass)
+{
+	if (SourcePin->LinkedTo.Num() == 0)
+	{
+		return SelfClass;
+	}
+
+	const FEdGraphPinType& PinType = SourcePin->LinkedTo[0]->PinType;
+	if (PinType.PinSubCategory == UEdGraphSchema_K2::PSC_Self)
+	{
+		return SelfClass;
+	}
+
+	return Cast<UClass>(PinType.PinSubCategoryObject.Get());
+}
+
+// Return true if the object of the class notifies the field value changes.
+static bool CanNotifyFieldValueChanged(const UClass* SourceClass)
+{
+#if ACF_WITH_FIELD_NOTIFICATION
+	return SourceClass->IsChildOf(UNotifyFieldValueChanged::StaticClass()) ||
+		   SourceClass->ImplementsInterface(UNotifyFieldValueChanged::StaticClass());
+#else
+	return false;
+#endif
+}
+
+#if ACF_WITH_FIELD_NOTIFICATION
+// Return the field notification descriptor of the class, or nullptr if the class default object does not have it.
+static const UE::FieldNotification::IClassDescriptor* FindFieldNotificationDescriptor(UClass* SourceClass)
+{
+	const INotifyFieldValueChanged* Notifier = Cast<INotifyFieldValueChanged>(SourceClass->GetDefaultObject());
+	return (Notifier != nullptr) ? &Notifier->GetFieldNotificationDescriptor() : nullptr;
+}
+#endif
+
+UK2Node_MultiBranchOnChange::UK2Node_MultiBranchOnChange(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeMultiBranchOnChange";
+	NodeContextMenuSectionLabel = LOCTEXT("MultiBranchOnChange", "Multi-Branch on Change");
+	CaseLayoutVersion = 2;
+}
+
+void UK2Node_MultiBranchOnChange::AllocateDefaultPins()
+{
+	// Pin structure
+	//   N: Number of case pin pair
+	// -----
+	// 0 - 2*(N+1): Same as Multi-Branch
+	// 2*(N+1)+1: Source (In, Object)
+
+	Super::AllocateDefaultPins();
+
+	CreateSourcePin();
+}
+
+FText UK2Node_MultiBranchOnChange::GetTooltipText() const
+{
+	return LOCTEXT("MultiBranchOnChangeStatement_Tooltip",
+		"Multi-Branch on Change Statement\nExecution goes where condition is true, and goes again whenever any watched field of "
+		"the source is changed");
+}
+
+FText UK2Node_MultiBranchOnChange::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("MultiBranchOnChange", "Multi-Branch on Change");
+}
+
+bool UK2Node_MultiBranchOnChange::IsCompatibleWithGraph(const UEdGraph* TargetGraph) const
+{
+	const UEdGraphSchema_K2* Schema = Cast<UEdGraphSchema_K2>(TargetGraph->GetSchema());
+	if (Schema == nullptr)
+	{
+		return false;
+	}
+
+	const EGraphType GraphType = Schema->GetGraphType(TargetGraph);
+	return Super::IsCompatibleWithGraph(TargetGraph) && ((GraphType == GT_Ubergraph) || (GraphType == GT_Macro));
+}
+
+void UK2Node_MultiBranchOnChange::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	Super::ReallocatePinsDuringReconstruction(OldPins);
+
+	CreateSourcePin();
+}
+
+void UK2Node_MultiBranchOnChange::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_ExpandNode);
+
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	// Multi-Branch reports the node which is never executed.
+	UEdGraphPin* ExecTriggeringPin = GetExecPin();
+	UEdGraphPin* SourcePin = GetSourcePin();
+	if ((ExecTriggeringPin == nullptr) || (ExecTriggeringPin->LinkedTo.Num() == 0) || (SourcePin == nullptr))
+	{
+		return;
+	}
+
+	// The bound flag and the custom event must be kept per object, so they are placed on the ubergraph.
+	if (SourceGraph != CompilerContext.ConsolidatedEventGraph)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT("MultiBranchOnChangeNotInEventGraph_Error", "@@ can be used only in the event graph").ToString(), this);
+		return;
+	}
+	if (WatchedFields.Num() == 0)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT("NoWatchedFields_Error", "@@ must have at least one watched field").ToString(), this);
+		return;
+	}
+	UClass* SourceClass = GetSourceClass(SourcePin, CompilerContext.Blueprint->SkeletonGeneratedClass);
+	if (SourceClass == nullptr)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT("UnknownSourceClass_Error", "@@: The class of @@ must be known on compile to check the watched fields")
+				 .ToString(),
+			this, SourcePin);
+		return;
+	}
+	if (!CanNotifyFieldValueChanged(SourceClass))
+	{
+		CompilerContext.MessageLog.Error(*LOCTEXT("SourceNotNotifyFieldValueChanged_Error",
+			"@@: @@ must implement INotifyFieldValueChanged (ex. widgets and viewmodels on UE 5.1 or later)")
+											  .ToString(),
+			this, SourcePin);
+		return;
+	}
+#if ACF_WITH_FIELD_NOTIFICATION
+	// BindFieldValueChanged skips the unknown fields on runtime, so they are reported here instead of never executing the node.
+	const UE::FieldNotification::IClassDescriptor* Descriptor = FindFieldNotificationDescriptor(SourceClass);
+	if (Descriptor == nullptr)
+	{
+		CompilerContext.MessageLog.Error(
+			*LOCTEXT("NoFieldNotificationDescriptor_Error", "@@: The field notifications of @@ cannot be resolved on compile")
+				 .ToString(),
+			this, SourcePin);
+		return;
+	}
+	bool bHasUnknownField = false;
+	for (const FName& FieldName : WatchedFields)
+	{
+		if (!Descriptor->GetField(SourceClass, FieldName).IsValid())
+		{
+			CompilerContext.MessageLog.Error(*FText::Format(LOCTEXT("UnknownWatchedField_Error",
+												  "@@: {0} is not the field notification of @@"),
+												  FText::FromName(FieldName))
+												  .ToString(),
+				this, SourcePin);
+			bHasUnknownField = true;
+		}
+	}
+	if (bHasUnknownField)
+	{
+		return;
+	}
+#endif
+
+	// The source is bound on the first execution, and the custom event executes this node whenever the fields are changed.
+	//   Exec -> Branch(Bound) -> (True)  -> (Multi-Branch)
+	//                         -> (False) -> Bound = true -> BindFieldValueChanged(Source, [Field 0, ...], OnChange)
+	//                                                    -> (Multi-Branch)
+	//   OnChange (Custom Event) -> (Multi-Branch)
+	// Bound is the persistent ubergraph local, so the source is bound once per object.
+	UK2Node_TemporaryVariable* BoundVariable =
+		CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(this, SourceGraph);
+	BoundVariable->VariableType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+	BoundVariable->bIsPersistent = true;
+	BoundVariable->AllocateDefaultPins();
+	UEdGraphPin* BoundPin = BoundVariable->GetVariablePin();
+
+	UK2Node_IfThenElse* IfThenElse = CompilerContext.SpawnIntermediateNode<UK2Node_IfThenElse>(this, SourceGraph);
+	IfThenElse->AllocateDefaultPins();
+	CompilerContext.MovePinLinksToIntermediate(*ExecTriggeringPin, *IfThenElse->GetExecPin());
+	BoundPin->MakeLinkTo(IfThenElse->GetConditionPin());
+	IfThenElse->GetThenPin()->MakeLinkTo(ExecTriggeringPin);
+
+	UK2Node_AssignmentStatement* Assignment =
+		CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(this, SourceGraph);
+	Assignment->AllocateDefaultPins();
+	UEdGraphPin* AssignmentVariablePin = Assignment->FindPinChecked(TEXT("Variable"));
+	BoundPin->MakeLinkTo(AssignmentVariablePin);
+	Assignment->PinConnectionListChanged(AssignmentVariablePin);
+	Assignment->FindPinChecked(TEXT("Value"))->DefaultValue = TEXT("true");
+	IfThenElse->GetElsePin()->MakeLinkTo(Assignment->GetExecPin());
+
+	UK2Node_CallFunction* CallFunction = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	CallFunction->SetFromFunction(UAdvancedControlFlowLibrary::StaticClass()->FindFunctionByName(
+		GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowLibrary, BindFieldValueChanged)));
+	CallFunction->AllocateDefaultPins();
+	Assignment->FindPinChecked(UEdGraphSchema_K2::PN_Then)->MakeLinkTo(CallFunction->GetExecPin());
+	CallFunction->GetThenPin()->MakeLinkTo(ExecTriggeringPin);
+
+	UEdGraphPin* CallSourcePin = CallFunction->FindPinChecked(OnChangeSourcePinName);
+	if (SourcePin->LinkedTo.Num() > 0)
+	{
+		CompilerContext.MovePinLinksToIntermediate(*SourcePin, *CallSourcePin);
+	}
+	else
+	{
+		UK2Node_Self* Self = CompilerContext.SpawnIntermediateNode<UK2Node_Self>(this, SourceGraph);
+		Self->AllocateDefaultPins();
+		Self->FindPinChecked(UEdGraphSchema_K2::PN_Self)->MakeLinkTo(CallSourcePin);
+	}
+
+	// Wildcard pins of the array are resolved by the connection to the library function.
+	UK2Node_MakeArray* FieldNames = CompilerContext.SpawnIntermediateNode<UK2Node_MakeArray>(this, SourceGraph);
+	FieldNames->NumInputs = WatchedFields.Num();
+	FieldNames->AllocateDefaultPins();
+	UEdGraphPin* FieldNamesPin = FieldNames->GetOutputPin();
+	FieldNamesPin->MakeLinkTo(CallFunction->FindPinChecked(TEXT("FieldNames")));
+	FieldNames->PinConnectionListChanged(FieldNamesPin);
+	for (int32 Index = 0; Index < WatchedFields.Num(); ++Index)
+	{
+		FieldNames->FindPinChecked(FName(*FString::Printf(TEXT("[%d]"), Index)))->DefaultValue = WatchedFields[Index].ToString();
+	}
+
+	UK2Node_CustomEvent* CustomEvent =
+		CompilerContext.SpawnIntermediateEventNode<UK2Node_CustomEvent>(this, SourcePin, SourceGraph);
+	CustomEvent->CustomFunctionName = *FString::Printf(TEXT("ACF_OnChange_%s"), *CompilerContext.GetGuid(this));
+	CustomEvent->AllocateDefaultPins();
+	CustomEvent->FindPinChecked(UK2Node_Event::DelegateOutputName)->MakeLinkTo(CallFunction->FindPinChecked(TEXT("Delegate")));
+	CustomEvent->FindPinChecked(UEdGraphSchema_K2::PN_Then)->MakeLinkTo(ExecTriggeringPin);
+}
+
+void UK2Node_MultiBranchOnChange::CreateSourcePin()
+{
+	UEdGraphPin* SourcePin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Object, UObject::StaticClass(), OnChangeSourcePinName);
+	SourcePin->PinToolTip =
+		LOCTEXT("MultiBranchOnChangeSource_Tooltip",
+			"Object whose watched fields are bound to this node on the first execution (self if unconnected)\n"
+			"It must implement INotifyFieldValueChanged (ex. widgets and viewmodels)")
+			.ToString();
+}
+
+UEdGraphPin* UK2Node_MultiBranchOnChange::GetSourcePin() const
+{
+	return FindPin(OnChangeSourcePinName);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,458 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "K2Node_MultiBranchOnName.h"
+
+#include "AdvancedControlFlowCaseTable.h"
+#include "AdvancedControlFlowCompilerUtils.h"
+#include "AdvancedControlFlowEditorUtils.h"
+#include "AdvancedControlFlowStats.h"
+#include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "EdGraphUtilities.h"
+#include "EditorCategoryUtils.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "GraphEditorSettings.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "KismetCompiledFunctionContext.h"
+#include "KismetCompiler.h"
+#include "KismetCompilerMisc.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+const FName NameSelectionPinName(TEXT("Selection"));
+const FName NameSelectionPinFriendlyName(TEXT("Value"));
+const FName NameCompareFunctionLibraryPinName(TEXT("CompareFunctionLibrary"));
+
+class FKCHandler_MultiBranchOnName : public FNodeHandlingFunctor
+{
+public:
+	FKCHandler_MultiBranchOnName(FKismetCompilerContext& InCompilerContext) : FNodeHandlingFunctor(InCompilerContext)
+	{
+	}
+
+	virtual void RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_RegisterNets);
+
+		UK2Node_MultiBranchOnName* MultiBranchNode = CastChecked<UK2Node_MultiBranchOnName>(Node);
+
+		if (!UK2Node_MultiBranchOnName::IsSupportedSelectionType(MultiBranchNode->GetSelectionPin()->PinType))
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("InvalidSelectionForMultiBranchOnName_Error", "@@ must have a connected name or string value").ToString(),
+				MultiBranchNode);
+			return;
+		}
+
+		FNodeHandlingFunctor::RegisterNets(Context, Node);
+
+		FindOrCreateScratchBoolTerminal(Context, Node);
+		FindOrCreateScratchIntTerminal(Context, Node);
+	}
+
+	// clang-format off
+	/*
+	 * Generated code
+	 *
+	 *          ACF_Scratch = ACF_CaseTable.FindNameCase(Selection) (or FindStringCase)
+	 *          (Same as Multi-Branch on Value (Equal) with the value ACF_Scratch and the keys 0, 1, ...)
+	 *
+	 * ACF_CaseTable is the hash table from the case keys to the case indices, which is built here and saved as the subobject
+	 * of the generated class. The value is hashed once instead of being compared with the keys one by one, and the case index
+	 * is dispatched by log2(N) integer comparisons. ACF_Scratch is -1 when no case has the value, which goes to default.
+	 */
+	// clang-format on
+	virtual void Compile(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_Compile);
+
+		UK2Node_MultiBranchOnName* MultiBranchNode = CastChecked<UK2Node_MultiBranchOnName>(Node);
+
+		FEdGraphPinType ExpectedExecPinType;
+		ExpectedExecPinType.PinCategory = UEdGraphSchema_K2::PC_Exec;
+
+		{
+			UEdGraphPin* ExecTriggeringPin =
+				Context.FindRequiredPinByName(MultiBranchNode, UEdGraphSchema_K2::PN_Execute, EGPD_Input);
+			if ((ExecTriggeringPin == nullptr) || !Context.ValidatePinType(ExecTriggeringPin, ExpectedExecPinType))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("NoValidExecutionPinForMultiBranchOnName_Error", "@@ must have a valid execution pin @@").ToString(),
+					MultiBranchNode, ExecTriggeringPin);
+				return;
+			}
+			else if (ExecTriggeringPin->LinkedTo.Num() == 0)
+			{
+				CompilerContext.MessageLog.Warning(
+					*LOCTEXT("NodeNeverExecuted_Warning", "@@ will never be executed").ToString(), MultiBranchNode);
+				return;
+			}
+		}
+
+		UEdGraphPin* SelectionPin = MultiBranchNode->GetSelectionPin();
+		const bool bIsName = SelectionPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Name;
+
+		FBPTerminal* SelectionTerm = Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(SelectionPin));
+		UFunction* FindCaseFunction = FindUField<UFunction>(UAdvancedControlFlowCaseTable::StaticClass(),
+			bIsName ? GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowCaseTable, FindNameCase)
+					: GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowCaseTable, FindStringCase));
+
+		FDispatchTreeContext TreeContext;
+		TreeContext.Node = MultiBranchNode;
+		TreeContext.SelectionTerm = FindOrCreateScratchIntTerminal(Context, MultiBranchNode);
+		TreeContext.BoolTerm = FindOrCreateScratchBoolTerminal(Context, MultiBranchNode);
+		TreeContext.FunctionContext = Context.NetMap.FindRef(MultiBranchNode->GetFunctionPin());
+		TreeContext.LessFunction = FindUField<UFunction>(UKismetMathLibrary::StaticClass(), TEXT("Less_IntInt"));
+		TreeContext.EqualFunction = FindUField<UFunction>(UKismetMathLibrary::StaticClass(), TEXT("EqualEqual_IntInt"));
+		TreeContext.DefaultExecPin = MultiBranchNode->GetDefaultExecPin();
+		if ((SelectionTerm == nullptr) || (FindCaseFunction == nullptr) || (TreeContext.LessFunction == nullptr) ||
+			(TreeContext.EqualFunction == nullptr) || (Context.NewClass == nullptr))
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("InvalidTermForMultiBranchOnName_Error", "@@ has an invalid value pin @@").ToString(), MultiBranchNode,
+				SelectionPin);
+			return;
+		}
+
+		// The table is outered to the generated class, so that it is saved and cooked together with the bytecode which
+		// refers to it. The tables of the previous compile are discarded with the other subobjects when the class is cleaned.
+		UAdvancedControlFlowCaseTable* CaseTable = NewObject<UAdvancedControlFlowCaseTable>(Context.NewClass,
+			MakeUniqueObjectName(Context.NewClass, UAdvancedControlFlowCaseTable::StaticClass(), TEXT("ACF_CaseTable")));
+
+		TArray<FDispatchTreeCase> TreeCases;
+		if (!CollectCases(Context, MultiBranchNode, bIsName, CaseTable, TreeCases))
+		{
+			return;
+		}
+		INC_DWORD_STAT_BY(STAT_AdvancedControlFlow_CompiledCasePairs, MultiBranchNode->GetCasePinCount());
+
+		FBPTerminal* CaseTableTerm = Context.CreateLocalTerminal(ETerminalSpecification::TS_Literal);
+		CaseTableTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Object;
+		CaseTableTerm->Type.PinSubCategoryObject = UAdvancedControlFlowCaseTable::StaticClass();
+		CaseTableTerm->Source = MultiBranchNode;
+		CaseTableTerm->ObjectLiteral = CaseTable;
+
+		FBlueprintCompiledStatement& CallFuncStatement = Context.AppendStatementForNode(MultiBranchNode);
+		CallFuncStatement.Type = KCST_CallFunction;
+		CallFuncStatement.FunctionToCall = FindCaseFunction;
+		CallFuncStatement.FunctionContext = CaseTableTerm;
+		CallFuncStatement.bIsParentContext = false;
+		CallFuncStatement.LHS = TreeContext.SelectionTerm;
+		CallFuncStatement.RHS.Add(SelectionTerm);
+
+		EmitEqualDispatchTree(Context, TreeContext, TreeCases);
+	}
+
+private:
+	// Add the case keys to the table, and collect the cases keyed by the case index in ascending order.
+	// The case whose key is duplicated is removed with a warning.
+	bool CollectCases(FKismetFunctionContext& Context, UK2Node_MultiBranchOnName* Node, bool bIsName,
+		UAdvancedControlFlowCaseTable* CaseTable, TArray<FDispatchTreeCase>& OutCases)
+	{
+		const TArray<CasePinPair> Pairs = Node->GetCasePinPairs();
+		for (int32 CaseIndex = 0; CaseIndex < Pairs.Num(); ++CaseIndex)
+		{
+			const CasePinPair& Pair = Pairs[CaseIndex];
+			FBPTerminal* KeyTerm = Context.NetMap.FindRef(Pair.Key);
+			if ((KeyTerm == nullptr) || !KeyTerm->bIsLiteral)
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("InvalidCaseKeyForMultiBranchOnName_Error", "@@ has an invalid case key @@").ToString(), Node,
+					Pair.Key);
+				return false;
+			}
+
+			const FString& Key = Pair.Key->GetDefaultAsString();
+			const int32 FoundCaseIndex = bIsName ? CaseTable->FindNameCase(FName(*Key)) : CaseTable->FindStringCase(Key);
+			if (FoundCaseIndex != -1)
+			{
+				CompilerContext.MessageLog.Warning(
+					*LOCTEXT("DuplicatedKeyForMultiBranchOnName_Warning", "@@ has the duplicated case key @@").ToString(), Node,
+					Pair.Key);
+				continue;
+			}
+
+			if (bIsName)
+			{
+				CaseTable->AddNameCase(FName(*Key), CaseIndex);
+			}
+			else
+			{
+				CaseTable->AddStringCase(Key, CaseIndex);
+			}
+			OutCases.Add(
+				{CreateLiteralTerminal(Context, Node, UEdGraphSchema_K2::PC_Int, FString::FromInt(CaseIndex)), Pair.Value});
+		}
+
+		return true;
+	}
+};
+
+UK2Node_MultiBranchOnName::UK2Node_MultiBranchOnName(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeMultiBranchOnName";
+	NodeContextMenuSectionLabel = LOCTEXT("MultiBranchOnName", "Multi-Branch on Name");
+	CaseKeyPinNamePrefix = TEXT("CaseKey");
+	CaseValuePinNamePrefix = TEXT("CaseExec");
+	CaseKeyPinFriendlyNamePrefix = TEXT("Case ");
+	CaseValuePinFriendlyNamePrefix = TEXT(" ");
+}
+
+void UK2Node_MultiBranchOnName::AllocateDefaultPins()
+{
+	// Pin structure
+	//   N: Number of case pin pair
+	// -----
+	// 0: Internal function library (Hidden, Object)
+	// 1: Execution Triggering (In, Exec)
+	// 2: Selection (In, Wildcard -> Name/String)
+	// 3: Default Execution (Out, Exec)
+	// 4 - 3+N: Case Key (In, Same as Selection, Not connectable)
+	// 3+N+1 - 3+2*N: Case Execution (Out, Exec)
+
+	CreateFunctionPin();
+	CreateExecTriggeringPin();
+	CreateSelectionPin();
+	CreateDefaultExecPin();
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_MultiBranchOnName::GetTooltipText() const
+{
+	return LOCTEXT("MultiBranchOnNameStatement_Tooltip",
+		"Multi-Branch on Name Statement\nExecution goes where the name or string matches the case key (ignoring case)");
+}
+
+FLinearColor UK2Node_MultiBranchOnName::GetNodeTitleColor() const
+{
+	return GetDefault<UGraphEditorSettings>()->ExecBranchNodeTitleColor;
+}
+
+FText UK2Node_MultiBranchOnName::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("MultiBranchOnName", "Multi-Branch on Name");
+}
+
+FSlateIcon UK2Node_MultiBranchOnName::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static FSlateIcon Icon("EditorStyle", "GraphEditor.Switch_16x");
+	return Icon;
+}
+
+void UK2Node_MultiBranchOnName::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_PinConnectionListChanged);
+
+	if ((Pin == nullptr) || (Pin != GetSelectionPin()))
+	{
+		return;
+	}
+
+	if (Pin->LinkedTo.Num() == 0)
+	{
+		// Ignore the disconnection event.
+		return;
+	}
+
+	if (Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard)
+	{
+		// Pin type has already fixed.
+		return;
+	}
+
+	Super::PinConnectionListChanged(Pin);
+
+	Modify();
+
+	FEdGraphPinType PinType;
+	PinType.PinCategory = Pin->LinkedTo[0]->PinType.PinCategory;
+	Pin->PinType = PinType;
+
+	EnsureCasePinCache();
+	for (int32 Index = 0; Index < CasePinPairCache.Num(); ++Index)
+	{
+		UEdGraphPin* KeyPin = CasePinPairCache[Index].Key;
+
+		KeyPin->PinType = PinType;
+		ResetCaseKeyPinDefaultValue(KeyPin, Index);
+	}
+
+	RequestDeferredBlueprintModified(GetBlueprint());
+}
+
+void UK2Node_MultiBranchOnName::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	UEdGraphPin* OldSelectionPin = nullptr;
+	for (auto& Pin : OldPins)
+	{
+		if (Pin->GetFName() == NameSelectionPinName)
+		{
+			OldSelectionPin = Pin;
+			break;
+		}
+	}
+
+	CreateFunctionPin();
+	CreateExecTriggeringPin();
+	CreateSelectionPin();
+	CreateDefaultExecPin();
+
+	// Case key pins take over the selection pin type when they are created.
+	if (OldSelectionPin != nullptr)
+	{
+		GetSelectionPin()->PinType = OldSelectionPin->PinType;
+	}
+
+	Super::ReallocatePinsDuringReconstruction(OldPins);
+}
+
+class FNodeHandlingFunctor* UK2Node_MultiBranchOnName::CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const
+{
+	return new FKCHandler_MultiBranchOnName(CompilerContext);
+}
+
+void UK2Node_MultiBranchOnName::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+}
+
+FText UK2Node_MultiBranchOnName::GetMenuCategory() const
+{
+	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::FlowControl);
+}
+
+bool UK2Node_MultiBranchOnName::IsConnectionDisallowed(
+	const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const
+{
+	if ((MyPin == GetSelectionPin()) && (OtherPin != nullptr) && !IsSupportedSelectionType(OtherPin->PinType))
+	{
+		OutReason = LOCTEXT("UnsupportedNameSelectionType", "Only name or string value can be connected.").ToString();
+		return true;
+	}
+
+	return Super::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
+}
+
+CasePinPair UK2Node_MultiBranchOnName::AddCasePinPair(int32 CaseIndex)
+{
+	CasePinPair Pair;
+	int N = GetCasePinCount();
+
+	{
+		FCreatePinParams Params;
+		Params.Index = GetCasePinInsertIndex(4 + CaseIndex);
+		Pair.Key = CreatePin(EGPD_Input, GetSelectionPin()->PinType, *GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex),
+			Params);
+		Pair.Key->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), CaseIndex));
+		// Keys must be the literal to build the hash table on compile.
+		Pair.Key->bNotConnectable = true;
+		ResetCaseKeyPinDefaultValue(Pair.Key, CaseIndex);
+	}
+	{
+		FCreatePinParams Params;
+		Params.Index = GetCasePinInsertIndex(4 + N + 1 + CaseIndex);
+		Pair.Value = CreatePin(
+			EGPD_Output, UEdGraphSchema_K2::PC_Exec, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Value->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+	}
+
+	RegisterCasePinPair(CaseIndex, Pair);
+
+	return Pair;
+}
+
+void UK2Node_MultiBranchOnName::CreateFunctionPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 0;
+	UEdGraphPin* FunctionPin = CreatePin(
+		EGPD_Input, UEdGraphSchema_K2::PC_Object, UKismetMathLibrary::StaticClass(), NameCompareFunctionLibraryPinName, Params);
+	FunctionPin->bDefaultValueIsReadOnly = true;
+	FunctionPin->bNotConnectable = true;
+	FunctionPin->bHidden = true;
+
+	UBlueprint* Blueprint = GetBlueprint();
+	if ((Blueprint != nullptr) && !Blueprint->SkeletonGeneratedClass->IsChildOf(UKismetMathLibrary::StaticClass()))
+	{
+		FunctionPin->DefaultObject = UKismetMathLibrary::StaticClass()->GetDefaultObject();
+	}
+}
+
+void UK2Node_MultiBranchOnName::CreateExecTriggeringPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 1;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute, Params);
+}
+
+void UK2Node_MultiBranchOnName::CreateSelectionPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 2;
+	UEdGraphPin* SelectionPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, NameSelectionPinName, Params);
+	SelectionPin->PinFriendlyName = FText::AsCultureInvariant(NameSelectionPinFriendlyName.ToString());
+}
+
+void UK2Node_MultiBranchOnName::CreateDefaultExecPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 3;
+	UEdGraphPin* DefaultExecPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, DefaultExecPinName, Params);
+	DefaultExecPin->PinFriendlyName = FText::AsCultureInvariant(DefaultExecPinFriendlyName.ToString());
+}
+
+void UK2Node_MultiBranchOnName::ResetCaseKeyPinDefaultValue(UEdGraphPin* KeyPin, int32 CaseIndex) const
+{
+	// Different keys are set so that the new case is not duplicated.
+	if (IsSupportedSelectionType(KeyPin->PinType))
+	{
+		KeyPin->DefaultValue = FString::Printf(TEXT("Case%d"), CaseIndex);
+		return;
+	}
+
+	GetDefault<UEdGraphSchema_K2>()->SetPinAutogeneratedDefaultValueBasedOnType(KeyPin);
+}
+
+UEdGraphPin* UK2Node_MultiBranchOnName::GetDefaultExecPin() const
+{
+	return FindPin(DefaultExecPinName);
+}
+
+UEdGraphPin* UK2Node_MultiBranchOnName::GetSelectionPin() const
+{
+	return FindPin(NameSelectionPinName);
+}
+
+UEdGraphPin* UK2Node_MultiBranchOnName::GetFunctionPin() const
+{
+	return FindPin(NameCompareFunctionLibraryPinName);
+}
+
+bool UK2Node_MultiBranchOnName::IsSupportedSelectionType(const FEdGraphPinType& PinType)
+{
+	if (PinType.ContainerType != EPinContainerType::None)
+	{
+		return false;
+	}
+
+	return (PinType.PinCategory == UEdGraphSchema_K2::PC_Name) || (PinType.PinCategory == UEdGraphSchema_K2::PC_String);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,612 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "K2Node_MultiBranchOnValue.h"
+
+#include "AdvancedControlFlowCompilerUtils.h"
+#include "AdvancedControlFlowEditorUtils.h"
+#include "AdvancedControlFlowStats.h"
+#include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "EdGraphUtilities.h"
+#include "EditorCategoryUtils.h"
+#include "GraphEditorSettings.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiledFunctionContext.h"
+#include "KismetCompiler.h"
+#include "KismetCompilerMisc.h"
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+#include "KismetCastingUtils.h"
+#endif
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+const FName SelectionPinName(TEXT("Selection"));
+const FName SelectionPinFriendlyName(TEXT("Value"));
+const FName CompareFunctionLibraryPinName(TEXT("CompareFunctionLibrary"));
+
+struct FMultiBranchOnValueCase
+{
+	UEdGraphPin* KeyPin;
+	UEdGraphPin* ExecPin;
+	FBPTerminal* KeyTerm;
+	int64 IntKey;
+	double RealKey;
+};
+
+static bool IsRealPinType(const FEdGraphPinType& PinType)
+{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	return PinType.PinCategory == UEdGraphSchema_K2::PC_Float;
+#else
+	return PinType.PinCategory == UEdGraphSchema_K2::PC_Real;
+#endif
+}
+
+static FName GetCompareFunctionName(const FEdGraphPinType& PinType, bool bLessThan)
+{
+	if (PinType.PinCategory == UEdGraphSchema_K2::PC_Int)
+	{
+		return bLessThan ? TEXT("Less_IntInt") : TEXT("EqualEqual_IntInt");
+	}
+	else if (PinType.PinCategory == UEdGraphSchema_K2::PC_Int64)
+	{
+		return bLessThan ? TEXT("Less_Int64Int64") : TEXT("EqualEqual_Int64Int64");
+	}
+	else if (PinType.PinCategory == UEdGraphSchema_K2::PC_Byte)
+	{
+		return bLessThan ? TEXT("Less_ByteByte") : TEXT("EqualEqual_ByteByte");
+	}
+	else if (IsRealPinType(PinType))
+	{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+		return bLessThan ? TEXT("Less_FloatFloat") : TEXT("EqualEqual_FloatFloat");
+#else
+		return bLessThan ? TEXT("Less_DoubleDouble") : TEXT("EqualEqual_DoubleDouble");
+#endif
+	}
+
+	return NAME_None;
+}
+
+static bool ParseCaseKey(const UEdGraphPin* KeyPin, FMultiBranchOnValueCase& OutCase)
+{
+	const FString& DefaultValue = KeyPin->GetDefaultAsString();
+
+	OutCase.IntKey = 0;
+	OutCase.RealKey = 0.0;
+
+	if (UEnum* Enum = Cast<UEnum>(KeyPin->PinType.PinSubCategoryObject.Get()))
+	{
+		const int64 Value = Enum->GetValueByNameString(DefaultValue);
+		if (Value == INDEX_NONE)
+		{
+			return false;
+		}
+		OutCase.IntKey = Value;
+	}
+	else if (IsRealPinType(KeyPin->PinType))
+	{
+		OutCase.RealKey = FCString::Atod(*DefaultValue);
+	}
+	else
+	{
+		OutCase.IntKey = FCString::Atoi64(*DefaultValue);
+	}
+
+	return true;
+}
+
+class FKCHandler_MultiBranchOnValue : public FNodeHandlingFunctor
+{
+public:
+	FKCHandler_MultiBranchOnValue(FKismetCompilerContext& InCompilerContext) : FNodeHandlingFunctor(InCompilerContext)
+	{
+	}
+
+	virtual void RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_RegisterNets);
+
+		UK2Node_MultiBranchOnValue* MultiBranchNode = CastChecked<UK2Node_MultiBranchOnValue>(Node);
+
+		if (!UK2Node_MultiBranchOnValue::IsSupportedSelectionType(MultiBranchNode->GetSelectionPin()->PinType))
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("InvalidSelectionForMultiBranchOnValue_Error", "@@ must have a connected integer, float or enum value")
+					 .ToString(),
+				MultiBranchNode);
+			return;
+		}
+
+		FNodeHandlingFunctor::RegisterNets(Context, Node);
+
+		FindOrCreateScratchBoolTerminal(Context, Node);
+	}
+
+	// clang-format off
+	/*
+	 * Generated code (Less Than mode, 3 cases)
+	 *
+	 *          ACF_CmpSuccess = Selection < Threshold 1
+	 *          GotoIfNot ACF_CmpSuccess -> Right
+	 *          ACF_CmpSuccess = Selection < Threshold 0
+	 *          GotoIfNot ACF_CmpSuccess -> Case 1
+	 *          Goto CaseExec 0
+	 * Case 1:  Goto CaseExec 1
+	 * Right:   ACF_CmpSuccess = Selection < Threshold 2
+	 *          GotoIfNot ACF_CmpSuccess -> Default
+	 *          Goto CaseExec 2
+	 * Default: Goto Default
+	 *
+	 * On Equal mode, the keys are sorted and the range of the keys is halved by Less Than comparison until the
+	 * number of the keys gets small. Then the remaining keys are tested one by one with Equal comparison.
+	 */
+	// clang-format on
+	virtual void Compile(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_Compile);
+
+		UK2Node_MultiBranchOnValue* MultiBranchNode = CastChecked<UK2Node_MultiBranchOnValue>(Node);
+
+		FEdGraphPinType ExpectedExecPinType;
+		ExpectedExecPinType.PinCategory = UEdGraphSchema_K2::PC_Exec;
+
+		{
+			UEdGraphPin* ExecTriggeringPin =
+				Context.FindRequiredPinByName(MultiBranchNode, UEdGraphSchema_K2::PN_Execute, EGPD_Input);
+			if ((ExecTriggeringPin == nullptr) || !Context.ValidatePinType(ExecTriggeringPin, ExpectedExecPinType))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("NoValidExecutionPinForMultiBranchOnValue_Error", "@@ must have a valid execution pin @@")
+						 .ToString(),
+					MultiBranchNode, ExecTriggeringPin);
+				return;
+			}
+			else if (ExecTriggeringPin->LinkedTo.Num() == 0)
+			{
+				CompilerContext.MessageLog.Warning(
+					*LOCTEXT("NodeNeverExecuted_Warning", "@@ will never be executed").ToString(), MultiBranchNode);
+				return;
+			}
+		}
+
+		UEdGraphPin* SelectionPin = MultiBranchNode->GetSelectionPin();
+		const FEdGraphPinType& SelectionPinType = SelectionPin->PinType;
+
+		FDispatchTreeContext TreeContext;
+		TreeContext.Node = MultiBranchNode;
+		TreeContext.SelectionTerm = Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(SelectionPin));
+		TreeContext.BoolTerm = FindOrCreateScratchBoolTerminal(Context, MultiBranchNode);
+		TreeContext.FunctionContext = Context.NetMap.FindRef(MultiBranchNode->GetFunctionPin());
+		TreeContext.LessFunction =
+			FindUField<UFunction>(UKismetMathLibrary::StaticClass(), GetCompareFunctionName(SelectionPinType, true));
+		TreeContext.EqualFunction =
+			FindUField<UFunction>(UKismetMathLibrary::StaticClass(), GetCompareFunctionName(SelectionPinType, false));
+		TreeContext.DefaultExecPin = MultiBranchNode->GetDefaultExecPin();
+		if ((TreeContext.SelectionTerm == nullptr) || (TreeContext.BoolTerm == nullptr) || (TreeContext.LessFunction == nullptr) ||
+			(TreeContext.EqualFunction == nullptr))
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("InvalidTermForMultiBranchOnValue_Error", "@@ has an invalid value pin @@").ToString(), MultiBranchNode,
+				SelectionPin);
+			return;
+		}
+
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+		// The single-precision float value is converted to double before the comparison.
+		{
+			using namespace UE::KismetCompiler;
+
+			TOptional<TPair<FBPTerminal*, EKismetCompiledStatementType>> ImplicitCast =
+				CastingUtils::InsertImplicitCastStatement(Context, SelectionPin, TreeContext.SelectionTerm);
+			if (ImplicitCast.IsSet())
+			{
+				TreeContext.SelectionTerm = ImplicitCast->Get<0>();
+			}
+		}
+#endif
+
+		TArray<FMultiBranchOnValueCase> Cases;
+		if (!CollectCases(Context, MultiBranchNode, Cases))
+		{
+			return;
+		}
+		INC_DWORD_STAT_BY(STAT_AdvancedControlFlow_CompiledCasePairs, MultiBranchNode->GetCasePinCount());
+
+		TArray<FDispatchTreeCase> TreeCases;
+		for (const FMultiBranchOnValueCase& Case : Cases)
+		{
+			TreeCases.Add({Case.KeyTerm, Case.ExecPin});
+		}
+
+		if (MultiBranchNode->CompareMode == EMultiBranchOnValueCompareMode::LessThan)
+		{
+			EmitLessThanDispatchTree(Context, TreeContext, TreeCases);
+		}
+		else
+		{
+			EmitEqualDispatchTree(Context, TreeContext, TreeCases);
+		}
+	}
+
+private:
+	// Collect the cases sorted by the key in ascending order.
+	// The cases which are never reached (ex. the duplicated key) are removed with a warning.
+	bool CollectCases(FKismetFunctionContext& Context, UK2Node_MultiBranchOnValue* Node, TArray<FMultiBranchOnValueCase>& OutCases)
+	{
+		const bool bIsReal = IsRealPinType(Node->GetSelectionPin()->PinType);
+		auto IsLess = [bIsReal](const FMultiBranchOnValueCase& A, const FMultiBranchOnValueCase& B)
+		{ return bIsReal ? (A.RealKey < B.RealKey) : (A.IntKey < B.IntKey); };
+
+		TArray<FMultiBranchOnValueCase> Cases;
+		for (const CasePinPair& Pair : Node->GetCasePinPairs())
+		{
+			FMultiBranchOnValueCase Case;
+			Case.KeyPin = Pair.Key;
+			Case.ExecPin = Pair.Value;
+			Case.KeyTerm = Context.NetMap.FindRef(Pair.Key);
+			if ((Case.KeyTerm == nullptr) || !Case.KeyTerm->bIsLiteral || !ParseCaseKey(Pair.Key, Case))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("InvalidCaseKeyForMultiBranchOnValue_Error", "@@ has an invalid case key @@").ToString(), Node,
+					Pair.Key);
+				return false;
+			}
+			Cases.Add(Case);
+		}
+
+		if (Node->CompareMode == EMultiBranchOnValueCompareMode::LessThan)
+		{
+			// The first case whose threshold is greater than the value is taken, so the threshold which is not greater than
+			// the previous ones is never reached.
+			for (const FMultiBranchOnValueCase& Case : Cases)
+			{
+				if ((OutCases.Num() > 0) && !IsLess(OutCases.Last(), Case))
+				{
+					CompilerContext.MessageLog.Warning(*LOCTEXT("UnreachableThresholdForMultiBranchOnValue_Warning",
+						"@@ has the case threshold @@ which is never reached. The thresholds should be sorted in ascending order.")
+															.ToString(),
+						Node, Case.KeyPin);
+					continue;
+				}
+				OutCases.Add(Case);
+			}
+		}
+		else
+		{
+			Cases.StableSort(IsLess);
+			for (const FMultiBranchOnValueCase& Case : Cases)
+			{
+				if ((OutCases.Num() > 0) && !IsLess(OutCases.Last(), Case))
+				{
+					CompilerContext.MessageLog.Warning(
+						*LOCTEXT("DuplicatedKeyForMultiBranchOnValue_Warning", "@@ has the duplicated case key @@").ToString(),
+						Node, Case.KeyPin);
+					continue;
+				}
+				OutCases.Add(Case);
+			}
+		}
+
+		return true;
+	}
+};
+
+UK2Node_MultiBranchOnValue::UK2Node_MultiBranchOnValue(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer), CompareMode(EMultiBranchOnValueCompareMode::Equal)
+{
+	NodeContextMenuSectionName = "K2NodeMultiBranchOnValue";
+	NodeContextMenuSectionLabel = LOCTEXT("MultiBranchOnValue", "Multi-Branch on Value");
+	CaseKeyPinNamePrefix = TEXT("CaseKey");
+	CaseValuePinNamePrefix = TEXT("CaseExec");
+	CaseKeyPinFriendlyNamePrefix = TEXT("Case ");
+	CaseValuePinFriendlyNamePrefix = TEXT(" ");
+}
+
+void UK2Node_MultiBranchOnValue::AllocateDefaultPins()
+{
+	// Pin structure
+	//   N: Number of case pin pair
+	// -----
+	// 0: Internal function library (Hidden, Object)
+	// 1: Execution Triggering (In, Exec)
+	// 2: Selection (In, Wildcard -> Integer/Float/Enum)
+	// 3: Default Execution (Out, Exec)
+	// 4 - 3+N: Case Key (In, Same as Selection, Not connectable)
+	// 3+N+1 - 3+2*N: Case Execution (Out, Exec)
+
+	UpdateCaseKeyPinFriendlyNamePrefix();
+
+	CreateFunctionPin();
+	CreateExecTriggeringPin();
+	CreateSelectionPin();
+	CreateDefaultExecPin();
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_MultiBranchOnValue::GetTooltipText() const
+{
+	return LOCTEXT("MultiBranchOnValueStatement_Tooltip",
+		"Multi-Branch on Value Statement\nExecution goes where the value matches the case key (Equal) or is less than the case "
+		"threshold first (Less Than)");
+}
+
+FLinearColor UK2Node_MultiBranchOnValue::GetNodeTitleColor() const
+{
+	return GetDefault<UGraphEditorSettings>()->ExecBranchNodeTitleColor;
+}
+
+FText UK2Node_MultiBranchOnValue::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("MultiBranchOnValue", "Multi-Branch on Value");
+}
+
+FSlateIcon UK2Node_MultiBranchOnValue::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static FSlateIcon Icon("EditorStyle", "GraphEditor.Switch_16x");
+	return Icon;
+}
+
+void UK2Node_MultiBranchOnValue::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_PinConnectionListChanged);
+
+	if ((Pin == nullptr) || (Pin != GetSelectionPin()))
+	{
+		return;
+	}
+
+	if (Pin->LinkedTo.Num() == 0)
+	{
+		// Ignore the disconnection event.
+		return;
+	}
+
+	if (Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard)
+	{
+		// Pin type has already fixed.
+		return;
+	}
+
+	Super::PinConnectionListChanged(Pin);
+
+	Modify();
+
+	FEdGraphPinType PinType = Pin->LinkedTo[0]->PinType;
+	PinType.ContainerType = EPinContainerType::None;
+	PinType.bIsReference = false;
+	PinType.bIsConst = false;
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	// The float value is compared as double.
+	if (IsRealPinType(PinType))
+	{
+		PinType.PinSubCategory = UEdGraphSchema_K2::PC_Double;
+	}
+#endif
+	Pin->PinType = PinType;
+
+	EnsureCasePinCache();
+	for (int32 Index = 0; Index < CasePinPairCache.Num(); ++Index)
+	{
+		UEdGraphPin* KeyPin = CasePinPairCache[Index].Key;
+
+		KeyPin->PinType = PinType;
+		ResetCaseKeyPinDefaultValue(KeyPin, Index);
+	}
+
+	RequestDeferredBlueprintModified(GetBlueprint());
+}
+
+void UK2Node_MultiBranchOnValue::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	const FName PropertyName = (PropertyChangedEvent.Property != nullptr) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(UK2Node_MultiBranchOnValue, CompareMode))
+	{
+		// Update the case key pin names.
+		ReconstructNode();
+	}
+
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+}
+
+void UK2Node_MultiBranchOnValue::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	UEdGraphPin* OldSelectionPin = nullptr;
+	for (auto& Pin : OldPins)
+	{
+		if (Pin->GetFName() == SelectionPinName)
+		{
+			OldSelectionPin = Pin;
+		}
+	}
+
+	UpdateCaseKeyPinFriendlyNamePrefix();
+
+	CreateFunctionPin();
+	CreateExecTriggeringPin();
+	CreateSelectionPin();
+	CreateDefaultExecPin();
+
+	// Case key pins take over the selection pin type when they are created.
+	if (OldSelectionPin != nullptr)
+	{
+		GetSelectionPin()->PinType = OldSelectionPin->PinType;
+	}
+
+	Super::ReallocatePinsDuringReconstruction(OldPins);
+}
+
+class FNodeHandlingFunctor* UK2Node_MultiBranchOnValue::CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const
+{
+	return new FKCHandler_MultiBranchOnValue(CompilerContext);
+}
+
+void UK2Node_MultiBranchOnValue::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+}
+
+FText UK2Node_MultiBranchOnValue::GetMenuCategory() const
+{
+	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::FlowControl);
+}
+
+bool UK2Node_MultiBranchOnValue::IsConnectionDisallowed(
+	const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const
+{
+	if ((MyPin == GetSelectionPin()) && (OtherPin != nullptr) && !IsSupportedSelectionType(OtherPin->PinType))
+	{
+		OutReason = LOCTEXT("UnsupportedSelectionType", "Only integer, float or enum value can be connected.").ToString();
+		return true;
+	}
+
+	return Super::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
+}
+
+CasePinPair UK2Node_MultiBranchOnValue::AddCasePinPair(int32 CaseIndex)
+{
+	CasePinPair Pair;
+	int N = GetCasePinCount();
+
+	{
+		FCreatePinParams Params;
+		Params.Index = GetCasePinInsertIndex(4 + CaseIndex);
+		Pair.Key = CreatePin(EGPD_Input, GetSelectionPin()->PinType, *GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex),
+			Params);
+		Pair.Key->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), CaseIndex));
+		// Keys must be the literal to build the decision tree on compile.
+		Pair.Key->bNotConnectable = true;
+		ResetCaseKeyPinDefaultValue(Pair.Key, CaseIndex);
+	}
+	{
+		FCreatePinParams Params;
+		Params.Index = GetCasePinInsertIndex(4 + N + 1 + CaseIndex);
+		Pair.Value = CreatePin(
+			EGPD_Output, UEdGraphSchema_K2::PC_Exec, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Value->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+	}
+
+	RegisterCasePinPair(CaseIndex, Pair);
+
+	return Pair;
+}
+
+void UK2Node_MultiBranchOnValue::CreateFunctionPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 0;
+	UEdGraphPin* FunctionPin = CreatePin(
+		EGPD_Input, UEdGraphSchema_K2::PC_Object, UKismetMathLibrary::StaticClass(), CompareFunctionLibraryPinName, Params);
+	FunctionPin->bDefaultValueIsReadOnly = true;
+	FunctionPin->bNotConnectable = true;
+	FunctionPin->bHidden = true;
+
+	UBlueprint* Blueprint = GetBlueprint();
+	if ((Blueprint != nullptr) && !Blueprint->SkeletonGeneratedClass->IsChildOf(UKismetMathLibrary::StaticClass()))
+	{
+		FunctionPin->DefaultObject = UKismetMathLibrary::StaticClass()->GetDefaultObject();
+	}
+}
+
+void UK2Node_MultiBranchOnValue::CreateExecTriggeringPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 1;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute, Params);
+}
+
+void UK2Node_MultiBranchOnValue::CreateSelectionPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 2;
+	UEdGraphPin* SelectionPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, SelectionPinName, Params);
+	SelectionPin->PinFriendlyName = FText::AsCultureInvariant(SelectionPinFriendlyName.ToString());
+}
+
+void UK2Node_MultiBranchOnValue::CreateDefaultExecPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 3;
+	UEdGraphPin* DefaultExecPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, DefaultExecPinName, Params);
+	DefaultExecPin->PinFriendlyName = FText::AsCultureInvariant(DefaultExecPinFriendlyName.ToString());
+}
+
+void UK2Node_MultiBranchOnValue::UpdateCaseKeyPinFriendlyNamePrefix()
+{
+	CaseKeyPinFriendlyNamePrefix =
+		(CompareMode == EMultiBranchOnValueCompareMode::LessThan) ? TEXT("Less Than ") : TEXT("Case ");
+}
+
+void UK2Node_MultiBranchOnValue::ResetCaseKeyPinDefaultValue(UEdGraphPin* KeyPin, int32 CaseIndex) const
+{
+	const FEdGraphPinType& PinType = KeyPin->PinType;
+
+	// Different keys are set so that the new case is not duplicated.
+	if (UEnum* Enum = Cast<UEnum>(PinType.PinSubCategoryObject.Get()))
+	{
+		if (CaseIndex < Enum->NumEnums() - 1)
+		{
+			KeyPin->DefaultValue = Enum->GetNameStringByIndex(CaseIndex);
+			return;
+		}
+	}
+	else if (IsRealPinType(PinType))
+	{
+		KeyPin->DefaultValue = FString::SanitizeFloat(CaseIndex);
+		return;
+	}
+	else if ((PinType.PinCategory == UEdGraphSchema_K2::PC_Int) || (PinType.PinCategory == UEdGraphSchema_K2::PC_Int64) ||
+			 (PinType.PinCategory == UEdGraphSchema_K2::PC_Byte))
+	{
+		KeyPin->DefaultValue = FString::FromInt(CaseIndex);
+		return;
+	}
+
+	GetDefault<UEdGraphSchema_K2>()->SetPinAutogeneratedDefaultValueBasedOnType(KeyPin);
+}
+
+UEdGraphPin* UK2Node_MultiBranchOnValue::GetDefaultExecPin() const
+{
+	return FindPin(DefaultExecPinName);
+}
+
+UEdGraphPin* UK2Node_MultiBranchOnValue::GetSelectionPin() const
+{
+	return FindPin(SelectionPinName);
+}
+
+UEdGraphPin* UK2Node_MultiBranchOnValue::GetFunctionPin() const
+{
+	return FindPin(CompareFunctionLibraryPinName);
+}
+
+bool UK2Node_MultiBranchOnValue::IsSupportedSelectionType(const FEdGraphPinType& PinType)
+{
+	if (PinType.ContainerType != EPinContainerType::None)
+	{
+		return false;
+	}
+
+	return (PinType.PinCategory == UEdGraphSchema_K2::PC_Int) || (PinType.PinCategory == UEdGraphSchema_K2::PC_Int64) ||
+		   (PinType.PinCategory == UEdGraphSchema_K2::PC_Byte) || IsRealPinType(PinType);
+}
+
+#undef LOCTEXT_NAMESPACE
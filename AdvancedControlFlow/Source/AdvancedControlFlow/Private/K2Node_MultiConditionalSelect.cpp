@@ -9,16 +9,19 @@
 
 #include "K2Node_MultiConditionalSelect.h"
 
+#include "AdvancedControlFlowCompilerUtils.h"
+#include "AdvancedControlFlowEditorUtils.h"
+#include "AdvancedControlFlowLibrary.h"
+#include "AdvancedControlFlowStats.h"
 #include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "EdGraphUtilities.h"
 #include "EditorCategoryUtils.h"
 #include "GraphEditorSettings.h"
-#include "K2Node_CallFunction.h"
-#include "K2Node_MakeArray.h"
-#include "K2Node_Select.h"
-#include "Kismet/KismetArrayLibrary.h"
-#include "Kismet/KismetMathLibrary.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiledFunctionContext.h"
 #include "KismetCompiler.h"
+#include "KismetCompilerMisc.h"
 
 #define LOCTEXT_NAMESPACE "AdvancedControlFlow"
 
@@ -27,6 +30,278 @@ const FName ReturnValueOptionPinName(TEXT("Return Value"));
 const FName OptionPinFriendlyNamePrefix(TEXT("Option "));
 const FName ConditionPinFriendlyNamePrefix(TEXT("Condition "));
 
+class FKCHandler_MultiConditionalSelect : public FNodeHandlingFunctor
+{
+public:
+	FKCHandler_MultiConditionalSelect(FKismetCompilerContext& InCompilerContext) : FNodeHandlingFunctor(InCompilerContext)
+	{
+	}
+
+	virtual void RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_RegisterNets);
+
+		UK2Node_MultiConditionalSelect* MultiConditionalSelectNode = CastChecked<UK2Node_MultiConditionalSelect>(Node);
+
+		if (MultiConditionalSelectNode->GetReturnValuePin()->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("WildcardOptionForMultiConditionalSelect_Error", "@@ must have a connected option pin").ToString(),
+				MultiConditionalSelectNode);
+			return;
+		}
+		if (MultiConditionalSelectNode->bElementWise && !MultiConditionalSelectNode->GetReturnValuePin()->PinType.IsArray())
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("ElementWiseNonArrayOption_Error", "@@ must have array options on element-wise mode").ToString(),
+				MultiConditionalSelectNode);
+			return;
+		}
+
+		FNodeHandlingFunctor::RegisterNets(Context, Node);
+	}
+
+	// clang-format off
+	/*
+	 * Generated code
+	 *
+	 *         GotoIfNot Condition 0 -> Case 1
+	 *         Return Value = Option 0
+	 *         Goto End
+	 * Case 1: GotoIfNot Condition 1 -> Default
+	 *         Return Value = Option 1
+	 *         Goto End
+	 * Default: Return Value = Default
+	 * End:     Nop
+	 *
+	 * Each path copies the selected option to Return Value only once, and the nodes which use the result read Return Value in
+	 * place. So the large structs and containers are copied once per evaluation, and the options which are not selected are
+	 * never copied. (The Blueprint VM has no reference locals, so one copy to the output terminal is the minimum.)
+	 * If the case hits are recorded, RecordCaseHit is called before each assignment.
+	 * If the cases are traced, "Trace start = BeginTraceCase()" is emitted first and TraceCaseTaken is called after RecordCaseHit.
+	 * The literal conditions are folded. The case which is always false is removed, and the case which is always true has
+	 * no GotoIfNot and the following cases and the default are removed.
+	 */
+	// clang-format on
+	virtual void Compile(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_Compile);
+
+		UK2Node_MultiConditionalSelect* MultiConditionalSelectNode = CastChecked<UK2Node_MultiConditionalSelect>(Node);
+
+		FBPTerminal* ReturnValueTerm = Context.NetMap.FindRef(MultiConditionalSelectNode->GetReturnValuePin());
+		FBPTerminal* DefaultOptionTerm =
+			Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(MultiConditionalSelectNode->GetDefaultOptionPin()));
+		if ((ReturnValueTerm == nullptr) || (DefaultOptionTerm == nullptr))
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("InvalidTermForMultiConditionalSelect_Error", "@@ has an invalid option or return value").ToString(),
+				MultiConditionalSelectNode);
+			return;
+		}
+
+		INC_DWORD_STAT_BY(STAT_AdvancedControlFlow_CompiledCasePairs, MultiConditionalSelectNode->GetCasePinCount());
+
+		if (MultiConditionalSelectNode->bElementWise)
+		{
+			CompileElementWise(Context, MultiConditionalSelectNode, ReturnValueTerm, DefaultOptionTerm);
+			return;
+		}
+
+		const bool bRecordCaseHits = ShouldRecordCaseHits();
+		FBPTerminal* TraceStartTerm = nullptr;
+		if (ShouldTraceCases())
+		{
+			TraceStartTerm = FindOrCreateTraceStartTerminal(Context, MultiConditionalSelectNode);
+			EmitBeginTraceCase(Context, MultiConditionalSelectNode, TraceStartTerm);
+		}
+		const TArray<CasePinPair> CasePairs = MultiConditionalSelectNode->GetCasePinPairs();
+		int32 TestedConditionCount = 0;
+		UEdGraphPin* AlwaysTakenCondPin = nullptr;
+		TArray<FBlueprintCompiledStatement*> GotoEndStatements;
+		FBlueprintCompiledStatement* PrevGotoIfNotStatement = nullptr;
+		for (int32 CaseIndex = 0; CaseIndex < CasePairs.Num(); ++CaseIndex)
+		{
+			const CasePinPair& Pair = CasePairs[CaseIndex];
+			FBPTerminal* OptionTerm = Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(Pair.Key));
+			FBPTerminal* CondTerm = Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(Pair.Value));
+			if ((OptionTerm == nullptr) || (CondTerm == nullptr))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("InvalidCaseTermForMultiConditionalSelect_Error", "@@ has an invalid case pin @@").ToString(),
+					MultiConditionalSelectNode, Pair.Key);
+				return;
+			}
+
+			if (AlwaysTakenCondPin != nullptr)
+			{
+				CompilerContext.MessageLog.Note(
+					*LOCTEXT("UnreachableCasePruned_Note", "@@: @@ is removed because @@ is always true").ToString(),
+					MultiConditionalSelectNode, Pair.Value, AlwaysTakenCondPin);
+				continue;
+			}
+
+			bool bLiteralValue = false;
+			const bool bIsLiteral = IsLiteralCondition(Pair.Value, bLiteralValue);
+			if (bIsLiteral && !bLiteralValue)
+			{
+				CompilerContext.MessageLog.Note(
+					*LOCTEXT("AlwaysFalseCasePruned_Note", "@@: @@ is removed because it is always false").ToString(),
+					MultiConditionalSelectNode, Pair.Value);
+				continue;
+			}
+
+			// Goto next case if not Cond
+			FBlueprintCompiledStatement* GotoIfNotStatement = nullptr;
+			FBlueprintCompiledStatement* CaseStatement = nullptr;
+			if (!bIsLiteral)
+			{
+				GotoIfNotStatement = &Context.AppendStatementForNode(MultiConditionalSelectNode);
+				GotoIfNotStatement->Type = KCST_GotoIfNot;
+				GotoIfNotStatement->LHS = CondTerm;
+				CaseStatement = GotoIfNotStatement;
+				++TestedConditionCount;
+			}
+
+			if (bRecordCaseHits)
+			{
+				FBlueprintCompiledStatement& RecordStatement =
+					EmitRecordCaseHit(Context, MultiConditionalSelectNode, CaseIndex, TestedConditionCount);
+				CaseStatement = (CaseStatement != nullptr) ? CaseStatement : &RecordStatement;
+			}
+			if (TraceStartTerm != nullptr)
+			{
+				FBlueprintCompiledStatement& TraceStatement =
+					EmitTraceCaseTaken(Context, MultiConditionalSelectNode, CaseIndex, TraceStartTerm);
+				CaseStatement = (CaseStatement != nullptr) ? CaseStatement : &TraceStatement;
+			}
+
+			// Copy the option whose condition is true first
+			FBlueprintCompiledStatement& AssignStatement = Context.AppendStatementForNode(MultiConditionalSelectNode);
+			AssignStatement.Type = KCST_Assignment;
+			AssignStatement.LHS = ReturnValueTerm;
+			AssignStatement.RHS.Add(OptionTerm);
+			CaseStatement = (CaseStatement != nullptr) ? CaseStatement : &AssignStatement;
+
+			if (PrevGotoIfNotStatement != nullptr)
+			{
+				PrevGotoIfNotStatement->TargetLabel = CaseStatement;
+				CaseStatement->bIsJumpTarget = true;
+			}
+			PrevGotoIfNotStatement = GotoIfNotStatement;
+
+			// The following cases and the default are removed, so the execution reaches to the end directly.
+			if (bIsLiteral)
+			{
+				AlwaysTakenCondPin = Pair.Value;
+				continue;
+			}
+
+			FBlueprintCompiledStatement& GotoEndStatement = Context.AppendStatementForNode(MultiConditionalSelectNode);
+			GotoEndStatement.Type = KCST_UnconditionalGoto;
+			GotoEndStatements.Add(&GotoEndStatement);
+		}
+
+		// Copy default if no condition is true
+		if (AlwaysTakenCondPin == nullptr)
+		{
+			FBlueprintCompiledStatement* DefaultRecordStatement = nullptr;
+			if (bRecordCaseHits)
+			{
+				DefaultRecordStatement = &EmitRecordCaseHit(Context, MultiConditionalSelectNode, INDEX_NONE, TestedConditionCount);
+			}
+			if (TraceStartTerm != nullptr)
+			{
+				FBlueprintCompiledStatement& TraceStatement =
+					EmitTraceCaseTaken(Context, MultiConditionalSelectNode, INDEX_NONE, TraceStartTerm);
+				DefaultRecordStatement = (DefaultRecordStatement != nullptr) ? DefaultRecordStatement : &TraceStatement;
+			}
+			FBlueprintCompiledStatement& DefaultAssignStatement = Context.AppendStatementForNode(MultiConditionalSelectNode);
+			DefaultAssignStatement.Type = KCST_Assignment;
+			DefaultAssignStatement.LHS = ReturnValueTerm;
+			DefaultAssignStatement.RHS.Add(DefaultOptionTerm);
+			if (PrevGotoIfNotStatement != nullptr)
+			{
+				FBlueprintCompiledStatement* DefaultStatement =
+					(DefaultRecordStatement != nullptr) ? DefaultRecordStatement : &DefaultAssignStatement;
+				PrevGotoIfNotStatement->TargetLabel = DefaultStatement;
+				DefaultStatement->bIsJumpTarget = true;
+			}
+		}
+
+		FBlueprintCompiledStatement& EndStatement = Context.AppendStatementForNode(MultiConditionalSelectNode);
+		EndStatement.Type = KCST_Nop;
+		EndStatement.bIsJumpTarget = true;
+		for (FBlueprintCompiledStatement* GotoEndStatement : GotoEndStatements)
+		{
+			GotoEndStatement->TargetLabel = &EndStatement;
+		}
+	}
+
+private:
+	// clang-format off
+	/*
+	 * Generated code (element-wise)
+	 *
+	 * Return Value = Default
+	 * SelectArrayElements(Return Value, Condition N-1, Option N-1)
+	 * ...
+	 * SelectArrayElements(Return Value, Condition 0, Option 0)
+	 *
+	 * The cases are applied in the reverse order, so the element of the first case whose condition is true is left.
+	 * Return Value has the same length as Default. The elements beyond the length of the condition or the option are not changed.
+	 * The unconnected condition is the empty array, so the case is removed. The case hits are not recorded.
+	 */
+	// clang-format on
+	void CompileElementWise(FKismetFunctionContext& Context, UK2Node_MultiConditionalSelect* MultiConditionalSelectNode,
+		FBPTerminal* ReturnValueTerm, FBPTerminal* DefaultOptionTerm)
+	{
+		UFunction* SelectFunction = FindUField<UFunction>(UAdvancedControlFlowLibrary::StaticClass(),
+			GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowLibrary, SelectArrayElements));
+		check(SelectFunction != nullptr);
+
+		// Return Value = Default
+		FBlueprintCompiledStatement& DefaultAssignStatement = Context.AppendStatementForNode(MultiConditionalSelectNode);
+		DefaultAssignStatement.Type = KCST_Assignment;
+		DefaultAssignStatement.LHS = ReturnValueTerm;
+		DefaultAssignStatement.RHS.Add(DefaultOptionTerm);
+
+		FBPTerminal* LibraryTerm = CreateLibraryTerminal(Context, MultiConditionalSelectNode);
+		const TArray<CasePinPair> CasePairs = MultiConditionalSelectNode->GetCasePinPairs();
+		for (int32 CaseIndex = CasePairs.Num() - 1; CaseIndex >= 0; --CaseIndex)
+		{
+			const CasePinPair& Pair = CasePairs[CaseIndex];
+			if (Pair.Value->LinkedTo.Num() == 0)
+			{
+				CompilerContext.MessageLog.Note(
+					*LOCTEXT("AlwaysFalseCasePruned_Note", "@@: @@ is removed because it is always false").ToString(),
+					MultiConditionalSelectNode, Pair.Value);
+				continue;
+			}
+
+			FBPTerminal* OptionTerm = Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(Pair.Key));
+			FBPTerminal* CondTerm = Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(Pair.Value));
+			if ((OptionTerm == nullptr) || (CondTerm == nullptr))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("InvalidCaseTermForMultiConditionalSelect_Error", "@@ has an invalid case pin @@").ToString(),
+					MultiConditionalSelectNode, Pair.Key);
+				return;
+			}
+
+			// SelectArrayElements(Return Value, Cond, Option)
+			FBlueprintCompiledStatement& CallFuncStatement = Context.AppendStatementForNode(MultiConditionalSelectNode);
+			CallFuncStatement.Type = KCST_CallFunction;
+			CallFuncStatement.FunctionToCall = SelectFunction;
+			CallFuncStatement.FunctionContext = LibraryTerm;
+			CallFuncStatement.bIsParentContext = false;
+			CallFuncStatement.RHS.Add(ReturnValueTerm);
+			CallFuncStatement.RHS.Add(CondTerm);
+			CallFuncStatement.RHS.Add(OptionTerm);
+		}
+	}
+};
+
 UK2Node_MultiConditionalSelect::UK2Node_MultiConditionalSelect(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -71,6 +346,11 @@ FLinearColor UK2Node_MultiConditionalSelect::GetNodeTitleColor() const
 
 FText UK2Node_MultiConditionalSelect::GetNodeTitle(ENodeTitleType::Type TitleType) const
 {
+	if (bElementWise)
+	{
+		return LOCTEXT("MultiConditionalSelectElementWise", "Multi-Conditional Select (Element-wise)");
+	}
+
 	return LOCTEXT("MultiConditionalSelect", "Multi-Conditional Select");
 }
 
@@ -82,6 +362,8 @@ FSlateIcon UK2Node_MultiConditionalSelect::GetIconAndTint(FLinearColor& OutColor
 
 void UK2Node_MultiConditionalSelect::PinConnectionListChanged(UEdGraphPin* Pin)
 {
+	SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_PinConnectionListChanged);
+
 	if (Pin == nullptr)
 	{
 		return;
@@ -93,15 +375,17 @@ void UK2Node_MultiConditionalSelect::PinConnectionListChanged(UEdGraphPin* Pin)
 		return;
 	}
 
-	if (IsCaseValuePin(Pin))
+	// Fast path: most of the connections are made after the pin type is fixed (ex. auto-wiring or pasting).
+	UEdGraphPin* DefaultOptionPin = GetDefaultOptionPin();
+	if (DefaultOptionPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard)
 	{
-		// Ignore condition pin connection.
+		// Pin type has already fixed.
 		return;
 	}
 
-	if (GetDefaultOptionPin()->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard)
+	if (IsCaseValuePin(Pin))
 	{
-		// Pin type has already fixed.
+		// Ignore condition pin connection.
 		return;
 	}
 
@@ -109,29 +393,43 @@ void UK2Node_MultiConditionalSelect::PinConnectionListChanged(UEdGraphPin* Pin)
 
 	Modify();
 
+	// The node is already modified, so the modify callbacks for each pin are not needed.
 	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
-	UEdGraphPin* LinkedPin = Pin->LinkedTo[0];
+	const FEdGraphPinType PinType = Pin->LinkedTo[0]->PinType;
 
-	UEdGraphPin* DefaultOptionPin = GetDefaultOptionPin();
-	DefaultOptionPin->PinType = LinkedPin->PinType;
-	Schema->ResetPinToAutogeneratedDefaultValue(DefaultOptionPin);
+	DefaultOptionPin->PinType = PinType;
+	Schema->ResetPinToAutogeneratedDefaultValue(DefaultOptionPin, false);
 
 	UEdGraphPin* ReturnValuePin = GetReturnValuePin();
-	ReturnValuePin->PinType = LinkedPin->PinType;
-	Schema->ResetPinToAutogeneratedDefaultValue(ReturnValuePin);
+	ReturnValuePin->PinType = PinType;
+	Schema->ResetPinToAutogeneratedDefaultValue(ReturnValuePin, false);
 
-	TArray<CasePinPair> CasePinPairs = GetCasePinPairs();
-	for (auto& Pair : CasePinPairs)
+	EnsureCasePinCache();
+	for (const CasePinPair& Pair : CasePinPairCache)
 	{
 		UEdGraphPin* OptionPin = Pair.Key;
 
-		OptionPin->PinType = LinkedPin->PinType;
-		Schema->ResetPinToAutogeneratedDefaultValue(OptionPin);
+		OptionPin->PinType = PinType;
+		Schema->ResetPinToAutogeneratedDefaultValue(OptionPin, false);
 	}
 
-	UBlueprint* Blueprint = GetBlueprint();
-	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
-	Blueprint->BroadcastChanged();
+	RequestDeferredBlueprintModified(GetBlueprint());
+}
+
+void UK2Node_MultiConditionalSelect::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	const FName PropertyName = (PropertyChangedEvent.Property != nullptr) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(UK2Node_MultiConditionalSelect, bElementWise))
+	{
+		// The connected pins do not accept the other container type, so the option type is decided again by the next connection.
+		BreakAllNodeLinks();
+		UEdGraphPin* DefaultOptionPin = GetDefaultOptionPin();
+		DefaultOptionPin->PinType.ResetToDefaults();
+		DefaultOptionPin->PinType.PinCategory = UEdGraphSchema_K2::PC_Wildcard;
+		ReconstructNode();
+	}
+
+	Super::PostEditChangeProperty(PropertyChangedEvent);
 }
 
 void UK2Node_MultiConditionalSelect::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
@@ -142,22 +440,22 @@ void UK2Node_MultiConditionalSelect::ReallocatePinsDuringReconstruction(TArray<U
 		if (Pin->GetFName() == DefaultOptionPinName)
 		{
 			OldDefaultPin = Pin;
+			break;
 		}
 	}
 
 	CreateDefaultOptionPin();
 	CreateReturnValuePin();
-	Super::ReallocatePinsDuringReconstruction(OldPins);
 
-	if (OldDefaultPin != nullptr)
+	// Option pins take over the default option pin type when they are created.
+	// The wildcard pins are created with the container type of the current mode.
+	if ((OldDefaultPin != nullptr) && (OldDefaultPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard))
 	{
 		GetDefaultOptionPin()->PinType = OldDefaultPin->PinType;
 		GetReturnValuePin()->PinType = OldDefaultPin->PinType;
-		for (auto& Pair : GetCasePinPairs())
-		{
-			Pair.Key->PinType = OldDefaultPin->PinType;
-		}
 	}
+
+	Super::ReallocatePinsDuringReconstruction(OldPins);
 }
 
 void UK2Node_MultiConditionalSelect::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
@@ -177,164 +475,9 @@ FText UK2Node_MultiConditionalSelect::GetMenuCategory() const
 	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::Utilities);
 }
 
-// clang-format off
-/*
-* Internal node structure
-
-            +-----------------------------------------------------------------------------------------------------------------------+
-            |                                                                                                                       |
-            |                                         +----------------------------+           +----------------------------+       |
-            |                                         |          Select            |           |           Select           |       |
-            |                                         |                            |           |                            |       |
-            +-+                                       +-+                        +-+           +-+                        +-+     +-+
-   Option 0 | +---------------------------------------+ | Option 0  Return Value | +-----------+ | False     Return Value | +-----+ | Return Value
-            +-+                                       +-+                        +-+           +-+                        +-+     +-+
-            |                                         |                            |           |                            |       |
-            |                                         |                            |           |                            |       |
-            +-+                                       +-+                          |           +-+                          |       |
-   Option 1 | +---------------------------------------+ | Option 1                 |   +-------+ | True                     |       |
-            +-+                                       +-+                          |   |       +-+                          |       |
-            |                                         |                            |   |       |                            |       |
-            |                                         |                            |   |       |                            |       |
-            +-+                                       +-+                          |   |       +-+                          |       |
-    Default | +------------------+            +-------+ | Index (Integer)          |   |    +--+ | Index (Boolean)          |       |
-            +-+                  |            |       +-+                          |   |    |  +-+                          |       |
-            |                    |            |       |                            |   |    |  |                            |       |
-            |                    |            |       |                            |   |    |  |                            |       |
-            |                    |            |       +----------------------------+   |    |  +----------------------------+       |
-            |                    |            x                                        |    |                                       |
-            |                    |            x                                        |    |                                       |
-            |                    +------------x----------------------------------------+    +------------------------+              |
-            |                                 x                                                                      |              |
-            |                                 x-----------------------------------+                                  |              |
-            |                                                                     |                                  |              |
-            |       +------------------+     +---------------------------------+  |  +-----------------------+       |              |
-            |       |    Make Array    |     |          Find (Array)           |  |  |     == (Integer)      |       |              |
-            |       |                  |     |                                 |  |  |                       |       |              |
-            +-+     +-+              +-+     +-+                             +-+  |  +-+                   +-+       |              |
-Condition 0 | +-----+ | [0]    Array | +-----+ | Target Array   Return Value | +--+--+ | A    Return Value | +-------+              |
-            +-+     +-+              +-+     +-+                             +-+     +-+                   +-+                      |
-            |       |                  |     |                                 |     |                       |                      |
-            |       |                  |     |                                 |     |                       |                      |
-            +-+     +-+                |     +-+                               |     +-+                     |                      |
-Condition 1 | +-----+ | [1]            |     | | Item To Find                  |     | | B                   |                      |
-            +-+     +-+                |     +-+                               |     +-+                     |                      |
-            |       |                  |     |                                 |     |                       |                      |
-            |       |                  |     |                                 |     |                       |                      |
-            |       +------------------+     +---------------------------------+     +-----------------------+                      |
-            |                                                                                                                       |
-            |                                                                                                                       |
-            +-----------------------------------------------------------------------------------------------------------------------+
- */
-// clang-format on
-void UK2Node_MultiConditionalSelect::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+class FNodeHandlingFunctor* UK2Node_MultiConditionalSelect::CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const
 {
-	Super::ExpandNode(CompilerContext, SourceGraph);
-
-	UEdGraphPin* ReferenceOptionPin = GetCasePinPairs()[0].Key;
-	TArray<CasePinPair> CasePinPairs = GetCasePinPairs();
-
-	FEdGraphPinType Select1stPinType;
-	Select1stPinType.PinCategory = UEdGraphSchema_K2::PC_Int;
-	Select1stPinType.PinSubCategory = UEdGraphSchema_K2::PSC_Index;
-	Select1stPinType.PinSubCategoryObject = nullptr;
-
-	FEdGraphPinType Select2ndPinType;
-	Select2ndPinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-	Select2ndPinType.PinSubCategory = UEdGraphSchema_K2::PSC_Index;
-	Select1stPinType.PinSubCategoryObject = nullptr;
-
-	UK2Node_Select* Select1st = CompilerContext.SpawnIntermediateNode<UK2Node_Select>(this, SourceGraph);
-	Select1st->AllocateDefaultPins();
-	Select1st->ChangePinType(ReferenceOptionPin);
-	for (int32 Index = 2; Index < CasePinPairs.Num(); ++Index)
-	{
-		Select1st->AddInputPin();
-	}
-
-	UK2Node_Select* Select2nd = CompilerContext.SpawnIntermediateNode<UK2Node_Select>(this, SourceGraph);
-	Select2nd->AllocateDefaultPins();
-	Select2nd->ChangePinType(ReferenceOptionPin);
-	for (int32 Index = 2; Index < CasePinPairs.Num(); ++Index)
-	{
-		Select2nd->AddInputPin();
-	}
-
-	UK2Node_MakeArray* MakeArray = CompilerContext.SpawnIntermediateNode<UK2Node_MakeArray>(this, SourceGraph);
-	MakeArray->AllocateDefaultPins();
-	for (int32 Index = 1; Index < CasePinPairs.Num(); ++Index)
-	{
-		MakeArray->AddInputPin();
-	}
-
-	UK2Node_CallFunction* ArrayFind = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-	UClass* KismetArrayLibrary = UKismetArrayLibrary::StaticClass();
-	UFunction* ArrayFindFunction = KismetArrayLibrary->FindFunctionByName("Array_Find");
-	ArrayFind->SetFromFunction(ArrayFindFunction);
-	ArrayFind->AllocateDefaultPins();
-
-	UK2Node_CallFunction* IntEqual = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-	UClass* KismetMathLibrary = UKismetMathLibrary::StaticClass();
-	UFunction* EqualEqualIntIntFunction = KismetMathLibrary->FindFunctionByName("EqualEqual_IntInt");
-	IntEqual->SetFromFunction(EqualEqualIntIntFunction);
-	IntEqual->AllocateDefaultPins();
-
-	// Link between outer and 1st Select
-	TArray<UEdGraphPin*> Select1stOptionPins;
-	Select1st->GetOptionPins(Select1stOptionPins);
-	for (int Index = 0; Index < CasePinPairs.Num(); ++Index)
-	{
-		CompilerContext.MovePinLinksToIntermediate(*CasePinPairs[Index].Key, *Select1stOptionPins[Index]);
-	}
-
-	// Link between outer and Make Array
-	TArray<UEdGraphPin*> KeyPins;
-	TArray<UEdGraphPin*> ValuePins;
-	MakeArray->GetKeyAndValuePins(KeyPins, ValuePins);
-	for (int Index = 0; Index < CasePinPairs.Num(); ++Index)
-	{
-		KeyPins[Index]->PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-		CompilerContext.MovePinLinksToIntermediate(*CasePinPairs[Index].Value, *KeyPins[Index]);
-	}
-
-	// Link between Make Array and Array Find
-	UEdGraphPin* ArrayPin = MakeArray->GetOutputPin();
-	UEdGraphPin* TargetArrayPin = ArrayFind->FindPinChecked(TEXT("TargetArray"));
-	UEdGraphPin* ItemToFindPin = ArrayFind->FindPinChecked(TEXT("ItemToFind"));
-	ArrayPin->PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-	ArrayPin->MakeLinkTo(TargetArrayPin);
-	TargetArrayPin->PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-	ItemToFindPin->PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-	MakeArray->GetSchema()->TrySetDefaultValue(*ItemToFindPin, TEXT("true"));
-
-	// Link between Array Find and 1st Select
-	UEdGraphPin* ArrayFindOutputPin = ArrayFind->GetReturnValuePin();
-	UEdGraphPin* Select1stIndexPin = Select1st->GetIndexPin();
-	ArrayFindOutputPin->MakeLinkTo(Select1stIndexPin);
-	Select1st->NotifyPinConnectionListChanged(Select1stIndexPin);
-
-	// Link between Array Find and Int Equal
-	UEdGraphPin* IntEqualAPin = IntEqual->FindPinChecked(TEXT("A"));
-	UEdGraphPin* IntEqualBPin = IntEqual->FindPinChecked(TEXT("B"));
-	ArrayFindOutputPin->MakeLinkTo(IntEqualAPin);
-	ArrayFindOutputPin->GetSchema()->TrySetDefaultValue(*IntEqualBPin, TEXT("-1"));
-
-	// Link among 1st Select, 2nd Select and Int Equal
-	UEdGraphPin* Select1stReturnValuePin = Select1st->GetReturnValuePin();
-	UEdGraphPin* IntEqualReturnValuePin = IntEqual->GetReturnValuePin();
-	UEdGraphPin* Select2ndIndexPin = Select2nd->GetIndexPin();
-	TArray<UEdGraphPin*> Select2ndOptionPins;
-	Select2nd->GetOptionPins(Select2ndOptionPins);
-	IntEqualReturnValuePin->MakeLinkTo(Select2ndIndexPin);
-	Select2nd->NotifyPinConnectionListChanged(Select2ndIndexPin);
-	Select1stReturnValuePin->MakeLinkTo(Select2ndOptionPins[0]);
-	CompilerContext.MovePinLinksToIntermediate(*GetDefaultOptionPin(), *Select2ndOptionPins[1]);
-
-	// Link 2nd Select and outer
-	UEdGraphPin* Select2ndReturnValuePin = Select2nd->GetReturnValuePin();
-	CompilerContext.MovePinLinksToIntermediate(*GetReturnValuePin(), *Select2ndReturnValuePin);
-
-	BreakAllNodeLinks();
+	return new FKCHandler_MultiConditionalSelect(CompilerContext);
 }
 
 bool UK2Node_MultiConditionalSelect::IsConnectionDisallowed(
@@ -345,6 +488,11 @@ bool UK2Node_MultiConditionalSelect::IsConnectionDisallowed(
 		OutReason = LOCTEXT("ExecConnectionDisallowd", "Can't connect with Exec pin.").ToString();
 		return true;
 	}
+	if (bElementWise && OtherPin && !OtherPin->PinType.IsArray())
+	{
+		OutReason = LOCTEXT("ElementWiseNonArrayConnectionDisallowed", "Element-wise mode accepts only arrays.").ToString();
+		return true;
+	}
 
 	return Super::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
 }
@@ -354,6 +502,7 @@ void UK2Node_MultiConditionalSelect::CreateDefaultOptionPin()
 	FCreatePinParams Params;
 	Params.Index = 0;
 	UEdGraphPin* DefaultOptionPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, DefaultOptionPinName, Params);
+	DefaultOptionPin->PinType.ContainerType = GetOptionContainerType();
 }
 
 void UK2Node_MultiConditionalSelect::CreateReturnValuePin()
@@ -362,7 +511,13 @@ void UK2Node_MultiConditionalSelect::CreateReturnValuePin()
 
 	FCreatePinParams Params;
 	Params.Index = 2 * N + 1;
-	UEdGraphPin* DefaultOptionPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, ReturnValueOptionPinName, Params);
+	UEdGraphPin* ReturnValuePin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, ReturnValueOptionPinName, Params);
+	ReturnValuePin->PinType.ContainerType = GetOptionContainerType();
+}
+
+EPinContainerType UK2Node_MultiConditionalSelect::GetOptionContainerType() const
+{
+	return bElementWise ? EPinContainerType::Array : EPinContainerType::None;
 }
 
 UEdGraphPin* UK2Node_MultiConditionalSelect::GetDefaultOptionPin() const
@@ -383,7 +538,7 @@ CasePinPair UK2Node_MultiConditionalSelect::AddCasePinPair(int32 CaseIndex)
 
 	{
 		FCreatePinParams Params;
-		Params.Index = 1 + CaseIndex;
+		Params.Index = GetCasePinInsertIndex(1 + CaseIndex);
 		Pair.Key = CreatePin(
 			EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, *GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex), Params);
 		Pair.Key->PinFriendlyName =
@@ -392,13 +547,16 @@ CasePinPair UK2Node_MultiConditionalSelect::AddCasePinPair(int32 CaseIndex)
 	}
 	{
 		FCreatePinParams Params;
-		Params.Index = N + 2 + CaseIndex;
+		Params.Index = GetCasePinInsertIndex(N + 2 + CaseIndex);
 		Pair.Value = CreatePin(
 			EGPD_Input, UEdGraphSchema_K2::PC_Boolean, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
 		Pair.Value->PinFriendlyName =
 			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+		Pair.Value->PinType.ContainerType = GetOptionContainerType();
 	}
 
+	RegisterCasePinPair(CaseIndex, Pair);
+
 	return Pair;
 }
 
@@ -0,0 +1,510 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "K2Node_ParallelConditionalSequence.h"
+
+#include "AdvancedControlFlowLibrary.h"
+#include "AdvancedControlFlowStats.h"
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "EditorCategoryUtils.h"
+#include "GraphEditorSettings.h"
+#include "K2Node_AssignmentStatement.h"
+#include "K2Node_BreakStruct.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_ConditionalSequence.h"
+#include "K2Node_DynamicCast.h"
+#include "K2Node_EnumLiteral.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_FunctionTerminator.h"
+#include "K2Node_GetArrayItem.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_Knot.h"
+#include "K2Node_MacroInstance.h"
+#include "K2Node_MakeArray.h"
+#include "K2Node_MakeStruct.h"
+#include "K2Node_MultiBranch.h"
+#include "K2Node_MultiBranchOnBitmask.h"
+#include "K2Node_MultiBranchOnChange.h"
+#include "K2Node_MultiBranchOnName.h"
+#include "K2Node_MultiBranchOnValue.h"
+#include "K2Node_MultiConditionalSelect.h"
+#include "K2Node_Select.h"
+#include "K2Node_Self.h"
+#include "K2Node_Switch.h"
+#include "K2Node_TemporaryVariable.h"
+#include "K2Node_Tunnel.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiler.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+// Return true if the pin is connected to the member variable (through the reroute nodes).
+static bool IsLinkedToMemberVariable(const UEdGraphPin* Pin)
+{
+	for (const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+	{
+		const UEdGraphNode* LinkedNode = LinkedPin->GetOwningNode();
+		if (const UK2Node_Knot* Knot = Cast<UK2Node_Knot>(LinkedNode))
+		{
+			if (IsLinkedToMemberVariable(Knot->GetInputPin()))
+			{
+				return true;
+			}
+		}
+		else if (const UK2Node_VariableGet* VariableGet = Cast<UK2Node_VariableGet>(LinkedNode))
+		{
+			if (!VariableGet->VariableReference.IsLocalScope())
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+// Validate the case function which CallFunctionsInParallel calls, and report the errors.
+// If the function is thread safe, the graphs which it runs are walked, and the nodes which may race with the other case functions
+// running on the same target are reported. The source graphs are walked before the expansion, including the Blueprint functions,
+// the macros and the collapsed graphs used from the case function. Only the native functions are trusted by their thread safe
+// metadata.
+class FCaseFunctionValidator
+{
+public:
+	FCaseFunctionValidator(FKismetCompilerContext& InCompilerContext, UEdGraphNode* InNode, UEdGraphPin* InCaseFunctionPin)
+		: CompilerContext(InCompilerContext), Node(InNode), CaseFunctionPin(InCaseFunctionPin)
+	{
+	}
+
+	// Return false if any error is reported.
+	bool ValidateCaseFunction(const UFunction* Function)
+	{
+		// CallFunctionsInParallel calls the function without any parameters (including the return value).
+		if (Function->NumParms > 0)
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("CaseFunctionHasParameters_Error", "@@: @@ must not have any parameters").ToString(), Node,
+				CaseFunctionPin);
+			return false;
+		}
+		if (!FBlueprintEditorUtils::HasFunctionBlueprintThreadSafeMetaData(Function))
+		{
+			return true;
+		}
+
+		UEdGraph* FunctionGraph = nullptr;
+		if (!FindFunctionGraph(Function, FunctionGraph))
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("CaseFunctionGraphNotFound_Error", "@@: The graph of @@ is not found to validate its thread safety")
+					 .ToString(),
+				Node, CaseFunctionPin);
+			return false;
+		}
+
+		return (FunctionGraph != nullptr) ? ValidateGraph(FunctionGraph) : true;
+	}
+
+private:
+	// Return false if the function is defined by the Blueprint but its graph is not found.
+	// OutGraph is null for the native functions.
+	static bool FindFunctionGraph(const UFunction* Function, UEdGraph*& OutGraph)
+	{
+		UBlueprint* Blueprint = UBlueprint::GetBlueprintFromClass(Function->GetOwnerClass());
+		if (Blueprint == nullptr)
+		{
+			OutGraph = nullptr;
+			return true;
+		}
+
+		for (UEdGraph* Graph : Blueprint->FunctionGraphs)
+		{
+			if ((Graph != nullptr) && (Graph->GetFName() == Function->GetFName()))
+			{
+				OutGraph = Graph;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool ValidateGraph(UEdGraph* Graph)
+	{
+		bool bIsValid = true;
+		if ((Graph == nullptr) || VisitedGraphs.Contains(Graph))
+		{
+			return bIsValid;
+		}
+		VisitedGraphs.Add(Graph);
+
+		for (UEdGraphNode* GraphNode : Graph->Nodes)
+		{
+			bIsValid &= ValidateNode(GraphNode);
+		}
+		for (UEdGraph* SubGraph : Graph->SubGraphs)
+		{
+			bIsValid &= ValidateGraph(SubGraph);
+		}
+
+		return bIsValid;
+	}
+
+	bool ValidateNode(UEdGraphNode* GraphNode)
+	{
+		// Comments and the other nodes which are not compiled.
+		if (!GraphNode->IsA<UK2Node>())
+		{
+			return true;
+		}
+
+		if (UK2Node_VariableSet* VariableSet = Cast<UK2Node_VariableSet>(GraphNode))
+		{
+			if (!VariableSet->VariableReference.IsLocalScope())
+			{
+				return ReportError(GraphNode, LOCTEXT("WritesMemberVariable", "writes the member variable"));
+			}
+			return true;
+		}
+		if (UK2Node_AssignmentStatement* Assignment = Cast<UK2Node_AssignmentStatement>(GraphNode))
+		{
+			const UEdGraphPin* VariablePin = Assignment->FindPin(TEXT("Variable"));
+			if ((VariablePin != nullptr) && IsLinkedToMemberVariable(VariablePin))
+			{
+				return ReportError(GraphNode, LOCTEXT("WritesMemberVariable", "writes the member variable"));
+			}
+			return true;
+		}
+		if (UK2Node_CallFunction* CallFunction = Cast<UK2Node_CallFunction>(GraphNode))
+		{
+			return ValidateCallFunction(CallFunction);
+		}
+		if (UK2Node_MacroInstance* MacroInstance = Cast<UK2Node_MacroInstance>(GraphNode))
+		{
+			return ValidateGraph(MacroInstance->GetMacroGraph());
+		}
+		if (GraphNode->IsA<UK2Node_ParallelConditionalSequence>())
+		{
+			// The functions which are not thread safe would run on the worker thread.
+			return ReportError(GraphNode, LOCTEXT("RunsParallelConditionalSequence", "runs Parallel Conditional Sequence"));
+		}
+		if (GraphNode->IsA<UK2Node_MultiBranchOnChange>())
+		{
+			// The binding and its flag are kept on the target.
+			return ReportError(GraphNode, LOCTEXT("BindsFieldNotifications", "binds the field notifications"));
+		}
+
+		// The nodes which do not write any member and do not call any function other than the thread safe ones.
+		// The nodes of this plugin listed here only branch on or select by their inputs with the jumps and the local terminals.
+		// The collapsed graphs (tunnels) are walked as the sub graphs.
+		if (GraphNode->IsA<UK2Node_FunctionTerminator>() || GraphNode->IsA<UK2Node_Tunnel>() || GraphNode->IsA<UK2Node_Knot>() ||
+			GraphNode->IsA<UK2Node_Self>() || GraphNode->IsA<UK2Node_VariableGet>() ||
+			GraphNode->IsA<UK2Node_TemporaryVariable>() || GraphNode->IsA<UK2Node_IfThenElse>() ||
+			GraphNode->IsA<UK2Node_ExecutionSequence>() || GraphNode->IsA<UK2Node_Select>() || GraphNode->IsA<UK2Node_Switch>() ||
+			GraphNode->IsA<UK2Node_MakeArray>() || GraphNode->IsA<UK2Node_MakeStruct>() || GraphNode->IsA<UK2Node_BreakStruct>() ||
+			GraphNode->IsA<UK2Node_GetArrayItem>() || GraphNode->IsA<UK2Node_DynamicCast>() ||
+			GraphNode->IsA<UK2Node_EnumLiteral>() || GraphNode->IsA<UK2Node_MultiBranch>() ||
+			GraphNode->IsA<UK2Node_ConditionalSequence>() || GraphNode->IsA<UK2Node_MultiConditionalSelect>() ||
+			GraphNode->IsA<UK2Node_MultiBranchOnValue>() || GraphNode->IsA<UK2Node_MultiBranchOnBitmask>() ||
+			GraphNode->IsA<UK2Node_MultiBranchOnName>())
+		{
+			return true;
+		}
+
+		return ReportError(GraphNode, LOCTEXT("NotKnownAsThreadSafe", "is not known to be thread safe"));
+	}
+
+	bool ValidateCallFunction(UK2Node_CallFunction* CallFunction)
+	{
+		const UFunction* Function = CallFunction->GetTargetFunction();
+		if ((Function == nullptr) || !FBlueprintEditorUtils::HasFunctionBlueprintThreadSafeMetaData(Function))
+		{
+			return ReportError(CallFunction, LOCTEXT("CallsNotThreadSafeFunction", "calls the function which is not thread safe"));
+		}
+
+		// The arrays and the other containers are modified through the reference.
+		for (const UEdGraphPin* Pin : CallFunction->Pins)
+		{
+			if ((Pin->Direction == EGPD_Input) && Pin->PinType.bIsReference && !Pin->PinType.bIsConst &&
+				IsLinkedToMemberVariable(Pin))
+			{
+				return ReportError(
+					CallFunction, LOCTEXT("PassesMemberVariableByReference", "passes the member variable by reference"));
+			}
+		}
+
+		UEdGraph* FunctionGraph = nullptr;
+		if (!FindFunctionGraph(Function, FunctionGraph))
+		{
+			return ReportError(CallFunction, LOCTEXT("CallsFunctionWithoutGraph", "calls the function whose graph is not found"));
+		}
+
+		return ValidateGraph(FunctionGraph);
+	}
+
+	bool ReportError(UEdGraphNode* GraphNode, const FText& Reason)
+	{
+		CompilerContext.MessageLog.Error(
+			*FText::Format(LOCTEXT("CaseFunctionRaces_Error", "@@: @@ is thread safe, but @@ {0}"), Reason).ToString(), Node,
+			CaseFunctionPin, GraphNode);
+		return false;
+	}
+
+	FKismetCompilerContext& CompilerContext;
+	UEdGraphNode* Node;
+	UEdGraphPin* CaseFunctionPin;
+	TSet<UEdGraph*> VisitedGraphs;
+};
+
+UK2Node_ParallelConditionalSequence::UK2Node_ParallelConditionalSequence(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeParallelConditionalSequence";
+	NodeContextMenuSectionLabel = LOCTEXT("ParallelConditionalSequence", "Parallel Conditional Sequence");
+	CaseKeyPinNamePrefix = TEXT("CaseCond");
+	CaseValuePinNamePrefix = TEXT("CaseFunction");
+	CaseKeyPinFriendlyNamePrefix = TEXT("Condition ");
+	CaseValuePinFriendlyNamePrefix = TEXT("Function ");
+	CaseLayoutVersion = 1;
+}
+
+void UK2Node_ParallelConditionalSequence::AllocateDefaultPins()
+{
+	// Pin structure
+	//   N: Number of case pin pair
+	// -----
+	// 0: Execution Triggering (In, Exec)
+	// 1: Default Execution (Out, Exec)
+	// 2 - 1+N: Case Conditional (In, Boolean)
+	// 1+N+1 - 2*(N+1)-1: Case Function (In, Name, Not connectable)
+
+	CreateExecTriggeringPin();
+	CreateDefaultExecPin();
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_ParallelConditionalSequence::GetTooltipText() const
+{
+	return LOCTEXT("ParallelConditionalSequence_Tooltip",
+		"Parallel Conditional Sequence\nCalls the functions which meet the condition in parallel and executes Default after "
+		"all of them finish\nOnly the thread safe functions run on the worker threads");
+}
+
+FLinearColor UK2Node_ParallelConditionalSequence::GetNodeTitleColor() const
+{
+	return FLinearColor::White;
+}
+
+FText UK2Node_ParallelConditionalSequence::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("ParallelConditionalSequence", "Parallel Conditional Sequence");
+}
+
+FSlateIcon UK2Node_ParallelConditionalSequence::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static FSlateIcon Icon("EditorStyle", "GraphEditor.Sequence_16x");
+	return Icon;
+}
+
+void UK2Node_ParallelConditionalSequence::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	CreateExecTriggeringPin();
+	CreateDefaultExecPin();
+
+	Super::ReallocatePinsDuringReconstruction(OldPins);
+}
+
+void UK2Node_ParallelConditionalSequence::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_ExpandNode);
+
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	// The Blueprint VM can not run the execution pins of a function on the other threads, so each case calls the function of
+	// this Blueprint, and this node is expanded to the native call which dispatches them.
+	//   Exec -> CallFunctionsInParallel(Self, [Condition 0, ...], [Function 0, ...], [Thread Safe Class 0, ...]) -> Default
+	// All conditions are evaluated on the calling thread before the call.
+	UClass* SelfClass = CompilerContext.Blueprint->SkeletonGeneratedClass;
+	TArray<CasePinPair> CasePairs;
+	TArray<UClass*> ThreadSafeClasses;
+	for (const CasePinPair& Pair : GetCasePinPairs())
+	{
+		UEdGraphPin* CaseCondPin = Pair.Key;
+		UEdGraphPin* CaseFunctionPin = Pair.Value;
+		const FName FunctionName(*CaseFunctionPin->GetDefaultAsString());
+		if (FunctionName.IsNone())
+		{
+			CompilerContext.MessageLog.Note(
+				*LOCTEXT("NoCaseFunction_Note", "@@: @@ has no function and is ignored").ToString(), this, CaseFunctionPin);
+			continue;
+		}
+		if ((CaseCondPin->LinkedTo.Num() == 0) && !CaseCondPin->GetDefaultAsString().ToBool())
+		{
+			CompilerContext.MessageLog.Note(
+				*LOCTEXT("AlwaysFalseCasePruned_Note", "@@: @@ is removed because it is always false").ToString(), this,
+				CaseCondPin);
+			continue;
+		}
+
+		const UFunction* Function = (SelfClass != nullptr) ? SelfClass->FindFunctionByName(FunctionName) : nullptr;
+		if (Function == nullptr)
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("CaseFunctionNotFound_Error", "@@: @@ is not a function of this Blueprint").ToString(), this,
+				CaseFunctionPin);
+			continue;
+		}
+		FCaseFunctionValidator Validator(CompilerContext, this, CaseFunctionPin);
+		if (!Validator.ValidateCaseFunction(Function))
+		{
+			continue;
+		}
+
+		// The function may be overridden by the derived class on runtime, so the class which defines the validated function is
+		// passed, and the function of the other class runs on the calling thread.
+		UClass* ThreadSafeClass = nullptr;
+		if (FBlueprintEditorUtils::HasFunctionBlueprintThreadSafeMetaData(Function))
+		{
+			ThreadSafeClass = Function->GetOwnerClass();
+			if (ThreadSafeClass == SelfClass)
+			{
+				ThreadSafeClass = CompilerContext.NewClass;
+			}
+		}
+		else
+		{
+			CompilerContext.MessageLog.Warning(
+				*LOCTEXT("CaseFunctionNotThreadSafe_Warning",
+					"@@: @@ is not thread safe, so it runs on the calling thread after the thread safe functions")
+					 .ToString(),
+				this, CaseFunctionPin);
+		}
+
+		CasePairs.Add(Pair);
+		ThreadSafeClasses.Add(ThreadSafeClass);
+	}
+
+	UK2Node_CallFunction* CallFunction = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	CallFunction->SetFromFunction(UAdvancedControlFlowLibrary::StaticClass()->FindFunctionByName(
+		GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowLibrary, CallFunctionsInParallel)));
+	CallFunction->AllocateDefaultPins();
+
+	UK2Node_Self* Self = CompilerContext.SpawnIntermediateNode<UK2Node_Self>(this, SourceGraph);
+	Self->AllocateDefaultPins();
+	Self->FindPinChecked(UEdGraphSchema_K2::PN_Self)->MakeLinkTo(CallFunction->FindPinChecked(TEXT("Target")));
+
+	// Wildcard pins of the arrays are resolved by the connection to the library function.
+	auto SpawnMakeArray = [&](const FName& ParamName) {
+		UK2Node_MakeArray* MakeArray = CompilerContext.SpawnIntermediateNode<UK2Node_MakeArray>(this, SourceGraph);
+		MakeArray->NumInputs = CasePairs.Num();
+		MakeArray->AllocateDefaultPins();
+		UEdGraphPin* ArrayPin = MakeArray->GetOutputPin();
+		ArrayPin->MakeLinkTo(CallFunction->FindPinChecked(ParamName));
+		MakeArray->PinConnectionListChanged(ArrayPin);
+
+		return MakeArray;
+	};
+	UK2Node_MakeArray* Conditions = SpawnMakeArray(TEXT("Conditions"));
+	UK2Node_MakeArray* FunctionNames = SpawnMakeArray(TEXT("FunctionNames"));
+	UK2Node_MakeArray* ThreadSafe = SpawnMakeArray(TEXT("ThreadSafeClasses"));
+	for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+	{
+		const FName ElementPinName(*FString::Printf(TEXT("[%d]"), Index));
+		UEdGraphPin* CaseCondPin = CasePairs[Index].Key;
+		UEdGraphPin* ConditionElementPin = Conditions->FindPinChecked(ElementPinName);
+		if (CaseCondPin->LinkedTo.Num() > 0)
+		{
+			CompilerContext.MovePinLinksToIntermediate(*CaseCondPin, *ConditionElementPin);
+		}
+		else
+		{
+			ConditionElementPin->DefaultValue = CaseCondPin->DefaultValue;
+		}
+		FunctionNames->FindPinChecked(ElementPinName)->DefaultValue = CasePairs[Index].Value->GetDefaultAsString();
+		ThreadSafe->FindPinChecked(ElementPinName)->DefaultObject = ThreadSafeClasses[Index];
+	}
+
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *CallFunction->GetExecPin());
+	CompilerContext.MovePinLinksToIntermediate(*GetDefaultExecPin(), *CallFunction->GetThenPin());
+
+	BreakAllNodeLinks();
+}
+
+void UK2Node_ParallelConditionalSequence::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+}
+
+FText UK2Node_ParallelConditionalSequence::GetMenuCategory() const
+{
+	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::FlowControl);
+}
+
+void UK2Node_ParallelConditionalSequence::CreateExecTriggeringPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 0;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute, Params);
+}
+
+void UK2Node_ParallelConditionalSequence::CreateDefaultExecPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 1;
+	UEdGraphPin* DefaultExecPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, DefaultExecPinName, Params);
+	DefaultExecPin->PinFriendlyName = FText::AsCultureInvariant(DefaultExecPinFriendlyName.ToString());
+}
+
+CasePinPair UK2Node_ParallelConditionalSequence::AddCasePinPair(int32 CaseIndex)
+{
+	CasePinPair Pair;
+	int N = GetCasePinCount();
+
+	{
+		FCreatePinParams Params;
+		Params.Index = GetCasePinInsertIndex(2 + CaseIndex);
+		Pair.Key = CreatePin(
+			EGPD_Input, UEdGraphSchema_K2::PC_Boolean, *GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Key->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), CaseIndex));
+	}
+	{
+		FCreatePinParams Params;
+		Params.Index = GetCasePinInsertIndex(2 + N + 1 + CaseIndex);
+		Pair.Value = CreatePin(
+			EGPD_Input, UEdGraphSchema_K2::PC_Name, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Value->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+		// Function must be known on compile to validate its thread safety.
+		Pair.Value->bNotConnectable = true;
+	}
+
+	RegisterCasePinPair(CaseIndex, Pair);
+
+	return Pair;
+}
+
+UEdGraphPin* UK2Node_ParallelConditionalSequence::GetDefaultExecPin() const
+{
+	return FindPin(DefaultExecPinName);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -9,13 +9,22 @@
 
 #include "SGraphNodeCasePairedPinsNode.h"
 
+#include "AdvancedControlFlowCaseHitCounter.h"
+#include "AdvancedControlFlowCompilerUtils.h"
+#include "AdvancedControlFlowStats.h"
 #include "DetailLayoutBuilder.h"
 #include "EditorStyleSet.h"
 #include "GraphEditorSettings.h"
 #include "K2Node_CasePairedPinsNode.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "NodeFactory.h"
 #include "ScopedTransaction.h"
 
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+// The button to hide the unconnected cases is shown if the node has the cases more than or equal to this count.
+static const int32 HideUnconnectedCasesButtonCaseCount = 8;
+
 void SGraphNodeCasePairedPinsNode::Construct(const FArguments& InArgs, UK2Node_CasePairedPinsNode* InNode)
 {
 	this->GraphNode = InNode;
@@ -23,6 +32,43 @@ void SGraphNodeCasePairedPinsNode::Construct(const FArguments& InArgs, UK2Node_C
 	this->UpdateGraphNode();
 }
 
+void SGraphNodeCasePairedPinsNode::GetNodeInfoPopups(FNodeInfoContext* Context, TArray<FGraphInformationPopupInfo>& Popups) const
+{
+	SGraphNodeK2Base::GetNodeInfoPopups(Context, Popups);
+
+#if ACF_WITH_CASE_HIT_COUNTERS
+	// Show the case hits recorded by acf.RecordCaseHits.
+	const FAdvancedControlFlowCaseHitCounter& Counter = FAdvancedControlFlowCaseHitCounter::Get();
+	TArray<FAdvancedControlFlowCaseHit> Hits;
+	if (!Counter.HasAnyHits() || !Counter.GetHits(GetCaseHitCounterKey(GraphNode), Hits))
+	{
+		return;
+	}
+
+	FNumberFormattingOptions AverageFormat;
+	AverageFormat.SetMinimumFractionalDigits(2).SetMaximumFractionalDigits(2);
+	FString Message = LOCTEXT("CaseHits", "Hits (Avg. Conditions)").ToString();
+	for (int32 HitIndex = 1; HitIndex < Hits.Num() + 1; ++HitIndex)
+	{
+		// The default is shown at last.
+		const int32 Index = HitIndex % Hits.Num();
+		if (Hits[Index].HitCount == 0)
+		{
+			continue;
+		}
+
+		const FText CaseName = (Index == 0) ? LOCTEXT("DefaultCaseHits", "Default")
+											: FText::Format(LOCTEXT("CaseIndexHits", "Case {0}"), Index - 1);
+		const double AverageConditions = static_cast<double>(Hits[Index].EvaluatedConditionCount) / Hits[Index].HitCount;
+		Message += TEXT("\n") + FText::Format(LOCTEXT("CaseHitCount", "{0}: {1} ({2})"), CaseName, Hits[Index].HitCount,
+									 FText::AsNumber(AverageConditions, &AverageFormat))
+									 .ToString();
+	}
+
+	Popups.Emplace(nullptr, GetDefault<UGraphEditorSettings>()->ExecBranchNodeTitleColor, Message);
+#endif
+}
+
 void SGraphNodeCasePairedPinsNode::CreateOutputSideAddButton(TSharedPtr<SVerticalBox> OutputBox)
 {
 	UK2Node_CasePairedPinsNode* CasePairedPinsNode = CastChecked<UK2Node_CasePairedPinsNode>(GraphNode);
@@ -51,6 +97,175 @@ void SGraphNodeCasePairedPinsNode::CreateOutputSideAddButton(TSharedPtr<SVertica
 	AddPinPadding.Right += 3.0f;
 
 	OutputBox->AddSlot().AutoHeight().VAlign(VAlign_Center).HAlign(HAlign_Right).Padding(AddPinPadding)[AddPinButton];
+
+	CreateHideUnconnectedCasesButton(OutputBox);
+}
+
+void SGraphNodeCasePairedPinsNode::CreateHideUnconnectedCasesButton(TSharedPtr<SVerticalBox> OutputBox)
+{
+	UK2Node_CasePairedPinsNode* CasePairedPinsNode = CastChecked<UK2Node_CasePairedPinsNode>(GraphNode);
+
+	FText ButtonText = LOCTEXT("HideUnconnectedCases", "Hide unconnected cases");
+	if (CasePairedPinsNode->bHideUnconnectedCases)
+	{
+		int32 HiddenCaseCount = 0;
+		for (const CasePinPair& Pair : CasePairedPinsNode->GetCasePinPairs())
+		{
+			if (!ShouldCreateCasePinWidget(Pair.Key))
+			{
+				++HiddenCaseCount;
+			}
+		}
+		ButtonText = FText::Format(LOCTEXT("ShowHiddenCases", "Show {0} hidden cases"), HiddenCaseCount);
+	}
+
+	FMargin Padding = Settings->GetOutputPinPadding();
+	Padding.Right += 3.0f;
+
+	OutputBox->AddSlot()
+		.AutoHeight()
+		.VAlign(VAlign_Center)
+		.HAlign(HAlign_Right)
+		.Padding(Padding)[SNew(SButton)
+#if UE_VERSION_NEWER_THAN(5, 1, 0)
+				.ButtonStyle(FAppStyle::Get(), "NoBorder")
+#else
+				.ButtonStyle(FEditorStyle::Get(), "NoBorder")
+#endif
+				.Visibility(this, &SGraphNodeCasePairedPinsNode::IsHideUnconnectedCasesButtonVisible)
+				.OnClicked(this, &SGraphNodeCasePairedPinsNode::OnHideUnconnectedCasesButtonClicked)
+				.ToolTipText(LOCTEXT("HideUnconnectedCases_Tooltip", "Show or hide the pins of the cases which are not connected"))
+					[SNew(STextBlock).Font(IDetailLayoutBuilder::GetDetailFont()).Text(ButtonText)]];
+}
+
+EVisibility SGraphNodeCasePairedPinsNode::IsHideUnconnectedCasesButtonVisible() const
+{
+	const UK2Node_CasePairedPinsNode* CasePairedPinsNode = CastChecked<UK2Node_CasePairedPinsNode>(GraphNode);
+	if (CasePairedPinsNode->bHideUnconnectedCases ||
+		(CasePairedPinsNode->GetCasePinCount() >= HideUnconnectedCasesButtonCaseCount))
+	{
+		return IsAddPinButtonVisible();
+	}
+
+	return EVisibility::Collapsed;
+}
+
+FReply SGraphNodeCasePairedPinsNode::OnHideUnconnectedCasesButtonClicked()
+{
+	UK2Node_CasePairedPinsNode* CasePairedPinsNode = CastChecked<UK2Node_CasePairedPinsNode>(GraphNode);
+
+	const FScopedTransaction Transaction(LOCTEXT("ToggleUnconnectedCases", "Toggle Unconnected Cases"));
+	CasePairedPinsNode->Modify();
+	CasePairedPinsNode->bHideUnconnectedCases = !CasePairedPinsNode->bHideUnconnectedCases;
+
+	// Only the widget is changed, so the graph does not need to be notified.
+	UpdateGraphNode();
+
+	return FReply::Handled();
+}
+
+bool SGraphNodeCasePairedPinsNode::ShouldCreateCasePinWidget(const UEdGraphPin* Pin) const
+{
+	const UK2Node_CasePairedPinsNode* CasePairedPinsNode = CastChecked<UK2Node_CasePairedPinsNode>(GraphNode);
+	if (!CasePairedPinsNode->bHideUnconnectedCases)
+	{
+		return true;
+	}
+
+	const UEdGraphPin* PairedPin = CasePairedPinsNode->GetCaseValuePinFromCaseKeyPin(Pin);
+	if (PairedPin == nullptr)
+	{
+		PairedPin = CasePairedPinsNode->GetCaseKeyPinFromCaseValuePin(Pin);
+	}
+	if (PairedPin == nullptr)
+	{
+		// Not a case pin.
+		return true;
+	}
+
+	return (Pin->LinkedTo.Num() > 0) || (PairedPin->LinkedTo.Num() > 0);
+}
+
+bool SGraphNodeCasePairedPinsNode::InsertLastCasePinWidgets()
+{
+	UK2Node_CasePairedPinsNode* CasePairedPinsNode = CastChecked<UK2Node_CasePairedPinsNode>(GraphNode);
+	const int32 CasePinCount = CasePairedPinsNode->GetCasePinCount();
+
+	// The hidden case count on the button and the visibility of the add pin button are changed.
+	if (CasePairedPinsNode->bHideUnconnectedCases || (CasePinCount == HideUnconnectedCasesButtonCaseCount))
+	{
+		return false;
+	}
+#ifdef ACF_FREE_VERSION
+	if (CasePinCount >= 3)
+	{
+		return false;
+	}
+#endif
+
+	// The nodes may have the other pins (ex. Default) between the cases and the previous pins in the same direction, so the new
+	// pins are placed after the widgets of the same pins of the previous case.
+	const TArray<CasePinPair> CasePairs = CasePairedPinsNode->GetCasePinPairs();
+	if (CasePairs.Num() < 2)
+	{
+		return false;
+	}
+	const CasePinPair& Pair = CasePairs.Last();
+	const CasePinPair& PrevPair = CasePairs[CasePairs.Num() - 2];
+	const TArray<UEdGraphPin*, TInlineAllocator<2>> NewPins = {Pair.Key, Pair.Value};
+	const TArray<UEdGraphPin*, TInlineAllocator<2>> PrevPins = {PrevPair.Key, PrevPair.Value};
+
+	for (int32 PinIndex = 0; PinIndex < NewPins.Num(); ++PinIndex)
+	{
+		UEdGraphPin* NewPin = NewPins[PinIndex];
+		TSharedPtr<SGraphPin> PrevPinWidget = FindWidgetForPin(PrevPins[PinIndex]);
+		if (!PrevPinWidget.IsValid())
+		{
+			return false;
+		}
+
+		TSharedPtr<SVerticalBox> PinBox = (NewPin->Direction == EGPD_Input) ? LeftNodeBox : RightNodeBox;
+		FChildren* Children = PinBox->GetChildren();
+		int32 PrevSlotIndex = INDEX_NONE;
+		for (int32 Index = 0; Index < Children->Num(); ++Index)
+		{
+			if (&Children->GetChildAt(Index).Get() == PrevPinWidget.Get())
+			{
+				PrevSlotIndex = Index;
+				break;
+			}
+		}
+		if (PrevSlotIndex == INDEX_NONE)
+		{
+			return false;
+		}
+
+		// Same as SGraphNode::AddPin, but the slot is inserted.
+		TSharedPtr<SGraphPin> NewPinWidget = FNodeFactory::CreatePinWidget(NewPin);
+		check(NewPinWidget.IsValid());
+		NewPinWidget->SetOwner(SharedThis(this));
+		if (NewPin->Direction == EGPD_Input)
+		{
+			PinBox->InsertSlot(PrevSlotIndex + 1)
+				.AutoHeight()
+				.HAlign(HAlign_Left)
+				.VAlign(VAlign_Center)
+				.Padding(Settings->GetInputPinPadding())[NewPinWidget.ToSharedRef()];
+			InputPins.Add(NewPinWidget.ToSharedRef());
+		}
+		else
+		{
+			PinBox->InsertSlot(PrevSlotIndex + 1)
+				.AutoHeight()
+				.HAlign(HAlign_Right)
+				.VAlign(VAlign_Center)
+				.Padding(Settings->GetOutputPinPadding())[NewPinWidget.ToSharedRef()];
+			OutputPins.Add(NewPinWidget.ToSharedRef());
+		}
+		INC_DWORD_STAT(STAT_AdvancedControlFlow_CreatedPinWidgets);
+	}
+
+	return true;
 }
 
 EVisibility SGraphNodeCasePairedPinsNode::IsAddPinButtonVisible() const
@@ -62,15 +277,20 @@ FReply SGraphNodeCasePairedPinsNode::OnAddPin()
 {
 	UK2Node_CasePairedPinsNode* CasePairedPinsNode = CastChecked<UK2Node_CasePairedPinsNode>(GraphNode);
 
+	// AddCasePinLast records only the new case to this transaction.
 	// TODO: Use NSLOCTEXT macro
 	const FScopedTransaction Transaction(FText::AsCultureInvariant("Add Execution Pin"));
-	CasePairedPinsNode->Modify();
-
 	CasePairedPinsNode->AddCasePinLast();
 	FBlueprintEditorUtils::MarkBlueprintAsModified(CasePairedPinsNode->GetBlueprint());
 
-	UpdateGraphNode();
-	GraphNode->GetGraph()->NotifyGraphChanged();
+	// Rebuilding all pin widgets of the node and the graph is slow with many cases, so only the new widgets are inserted.
+	if (!InsertLastCasePinWidgets())
+	{
+		UpdateGraphNode();
+		GraphNode->GetGraph()->NotifyGraphChanged();
+	}
 
 	return FReply::Handled();
-}
\ No newline at end of file
+}
+
+#undef LOCTEXT_NAMESPACE
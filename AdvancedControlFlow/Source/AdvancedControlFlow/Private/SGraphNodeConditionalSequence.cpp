@@ -9,25 +9,10 @@
 
 #include "SGraphNodeConditionalSequence.h"
 
+#include "AdvancedControlFlowStats.h"
 #include "K2Node_ConditionalSequence.h"
-#include "KismetPins/SGraphPinExec.h"
 #include "NodeFactory.h"
-
-class SGraphPinExecConditionalSequence : public SGraphPinExec
-{
-public:
-	SLATE_BEGIN_ARGS(SGraphPinExecConditionalSequence)
-	{
-	}
-	SLATE_END_ARGS()
-
-	void Construct(const FArguments& InArgs, UEdGraphPin* InPin)
-	{
-		SGraphPin::Construct(SGraphPin::FArguments().PinLabelStyle(FName("Graph.Node.DefaultPinName")), InPin);
-
-		CachePinIcons();
-	}
-};
+#include "SGraphPinExecDefault.h"
 
 void SGraphNodeConditionalSequence::Construct(const FArguments& InArgs, UK2Node_ConditionalSequence* InNode)
 {
@@ -38,7 +23,10 @@ void SGraphNodeConditionalSequence::Construct(const FArguments& InArgs, UK2Node_
 
 void SGraphNodeConditionalSequence::CreatePinWidgets()
 {
+	SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_CreatePinWidgets);
+
 	UK2Node_ConditionalSequence* ConditionalSequence = CastChecked<UK2Node_ConditionalSequence>(GraphNode);
+	INC_DWORD_STAT_BY(STAT_AdvancedControlFlow_CreatedPinWidgets, ConditionalSequence->GetCasePinCount());
 	UEdGraphPin* DefaultPin = ConditionalSequence->GetDefaultExecPin();
 
 	RightNodeBox->AddSlot().AutoHeight()[SNew(STextBlock).LineHeightPercentage(2.0f)];
@@ -46,7 +34,7 @@ void SGraphNodeConditionalSequence::CreatePinWidgets()
 	for (auto It = GraphNode->Pins.CreateConstIterator(); It; ++It)
 	{
 		UEdGraphPin* Pin = *It;
-		if ((!Pin->bHidden) && (Pin != DefaultPin))
+		if ((!Pin->bHidden) && (Pin != DefaultPin) && ShouldCreateCasePinWidget(Pin))
 		{
 			TSharedPtr<SGraphPin> NewPin = FNodeFactory::CreatePinWidget(Pin);
 			check(NewPin.IsValid());
@@ -69,7 +57,7 @@ void SGraphNodeConditionalSequence::CreatePinWidgets()
 #endif
 		];
 
-		TSharedPtr<SGraphPin> NewPin = SNew(SGraphPinExecConditionalSequence, DefaultPin);
+		TSharedPtr<SGraphPin> NewPin = SNew(SGraphPinExecDefault, DefaultPin);
 		this->AddPin(NewPin.ToSharedRef());
 	}
 }
\ No newline at end of file
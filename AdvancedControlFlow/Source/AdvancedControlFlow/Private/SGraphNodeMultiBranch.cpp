@@ -9,25 +9,10 @@
 
 #include "SGraphNodeMultiBranch.h"
 
+#include "AdvancedControlFlowStats.h"
 #include "K2Node_MultiBranch.h"
-#include "KismetPins/SGraphPinExec.h"
 #include "NodeFactory.h"
-
-class SGraphPinExecMultiBranch : public SGraphPinExec
-{
-public:
-	SLATE_BEGIN_ARGS(SGraphPinExecMultiBranch)
-	{
-	}
-	SLATE_END_ARGS()
-
-	void Construct(const FArguments& InArgs, UEdGraphPin* InPin)
-	{
-		SGraphPin::Construct(SGraphPin::FArguments().PinLabelStyle(FName("Graph.Node.DefaultPinName")), InPin);
-
-		CachePinIcons();
-	}
-};
+#include "SGraphPinExecDefault.h"
 
 void SGraphNodeMultiBranch::Construct(const FArguments& InArgs, UK2Node_MultiBranch* InNode)
 {
@@ -38,7 +23,10 @@ void SGraphNodeMultiBranch::Construct(const FArguments& InArgs, UK2Node_MultiBra
 
 void SGraphNodeMultiBranch::CreatePinWidgets()
 {
+	SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_CreatePinWidgets);
+
 	UK2Node_MultiBranch* MultiBranch = CastChecked<UK2Node_MultiBranch>(GraphNode);
+	INC_DWORD_STAT_BY(STAT_AdvancedControlFlow_CreatedPinWidgets, MultiBranch->GetCasePinCount());
 	UEdGraphPin* DefaultPin = MultiBranch->GetDefaultExecPin();
 
 	RightNodeBox->AddSlot().AutoHeight()[SNew(STextBlock).LineHeightPercentage(2.0f)];
@@ -46,7 +34,7 @@ void SGraphNodeMultiBranch::CreatePinWidgets()
 	for (auto It = GraphNode->Pins.CreateConstIterator(); It; ++It)
 	{
 		UEdGraphPin* Pin = *It;
-		if ((!Pin->bHidden) && (Pin != DefaultPin))
+		if ((!Pin->bHidden) && (Pin != DefaultPin) && ShouldCreateCasePinWidget(Pin))
 		{
 			TSharedPtr<SGraphPin> NewPin = FNodeFactory::CreatePinWidget(Pin);
 			check(NewPin.IsValid());
@@ -69,7 +57,7 @@ void SGraphNodeMultiBranch::CreatePinWidgets()
 #endif
 		];
 
-		TSharedPtr<SGraphPin> NewPin = SNew(SGraphPinExecMultiBranch, DefaultPin);
+		TSharedPtr<SGraphPin> NewPin = SNew(SGraphPinExecDefault, DefaultPin);
 		this->AddPin(NewPin.ToSharedRef());
 	}
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "SGraphNodeMultiBranchOnSelection.h"
+
+#include "AdvancedControlFlowStats.h"
+#include "K2Node_CasePairedPinsNode.h"
+#include "NodeFactory.h"
+#include "SGraphPinExecDefault.h"
+
+void SGraphNodeMultiBranchOnSelection::Construct(const FArguments& InArgs, UK2Node_CasePairedPinsNode* InNode)
+{
+	this->GraphNode = InNode;
+	this->SetCursor(EMouseCursor::CardinalCross);
+	this->UpdateGraphNode();
+}
+
+void SGraphNodeMultiBranchOnSelection::CreatePinWidgets()
+{
+	SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_CreatePinWidgets);
+
+	UK2Node_CasePairedPinsNode* CasePairedPinsNode = CastChecked<UK2Node_CasePairedPinsNode>(GraphNode);
+	INC_DWORD_STAT_BY(STAT_AdvancedControlFlow_CreatedPinWidgets, CasePairedPinsNode->GetCasePinCount());
+	UEdGraphPin* DefaultPin = CasePairedPinsNode->FindPin(DefaultExecPinName);
+
+	// Align the case execution pins with the case key pins which follow the execution and selection pins.
+	RightNodeBox->AddSlot().AutoHeight()[SNew(STextBlock).LineHeightPercentage(2.0f)];
+	RightNodeBox->AddSlot().AutoHeight()[SNew(STextBlock).LineHeightPercentage(2.0f)];
+
+	for (auto It = GraphNode->Pins.CreateConstIterator(); It; ++It)
+	{
+		UEdGraphPin* Pin = *It;
+		if ((!Pin->bHidden) && (Pin != DefaultPin) && ShouldCreateCasePinWidget(Pin))
+		{
+			TSharedPtr<SGraphPin> NewPin = FNodeFactory::CreatePinWidget(Pin);
+			check(NewPin.IsValid());
+
+			this->AddPin(NewPin.ToSharedRef());
+		}
+	}
+
+	if (DefaultPin != nullptr)
+	{
+		RightNodeBox->AddSlot()
+			.AutoHeight()
+			.HAlign(HAlign_Right)
+			.VAlign(VAlign_Center)
+			.Padding(1.0f)[
+#if UE_VERSION_NEWER_THAN(5, 1, 0)
+				SNew(SImage).Image(FAppStyle::GetBrush("Graph.Pin.DefaultPinSeparator"))
+#else
+				SNew(SImage).Image(FEditorStyle::GetBrush("Graph.Pin.DefaultPinSeparator"))
+#endif
+		];
+
+		TSharedPtr<SGraphPin> NewPin = SNew(SGraphPinExecDefault, DefaultPin);
+		this->AddPin(NewPin.ToSharedRef());
+	}
+}
\ No newline at end of file
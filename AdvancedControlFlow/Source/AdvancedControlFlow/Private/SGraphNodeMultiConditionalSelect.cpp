@@ -9,6 +9,7 @@
 
 #include "SGraphNodeMultiConditionalSelect.h"
 
+#include "AdvancedControlFlowStats.h"
 #include "K2Node_MultiConditionalSelect.h"
 #include "NodeFactory.h"
 
@@ -21,12 +22,15 @@ void SGraphNodeMultiConditionalSelect::Construct(const FArguments& InArgs, UK2No
 
 void SGraphNodeMultiConditionalSelect::CreatePinWidgets()
 {
+	SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_CreatePinWidgets);
+
 	UK2Node_MultiConditionalSelect* MultiConditionalSelect = CastChecked<UK2Node_MultiConditionalSelect>(GraphNode);
+	INC_DWORD_STAT_BY(STAT_AdvancedControlFlow_CreatedPinWidgets, MultiConditionalSelect->GetCasePinCount());
 
 	for (auto It = GraphNode->Pins.CreateConstIterator(); It; ++It)
 	{
 		UEdGraphPin* Pin = *It;
-		if (!Pin->bHidden)
+		if ((!Pin->bHidden) && ShouldCreateCasePinWidget(Pin))
 		{
 			TSharedPtr<SGraphPin> NewPin = FNodeFactory::CreatePinWidget(Pin);
 			check(NewPin.IsValid());
@@ -0,0 +1,41 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "SGraphNodeParallelConditionalSequence.h"
+
+#include "AdvancedControlFlowStats.h"
+#include "K2Node_ParallelConditionalSequence.h"
+#include "NodeFactory.h"
+
+void SGraphNodeParallelConditionalSequence::Construct(const FArguments& InArgs, UK2Node_ParallelConditionalSequence* InNode)
+{
+	this->GraphNode = InNode;
+	this->SetCursor(EMouseCursor::CardinalCross);
+	this->UpdateGraphNode();
+}
+
+void SGraphNodeParallelConditionalSequence::CreatePinWidgets()
+{
+	SCOPE_CYCLE_COUNTER(STAT_AdvancedControlFlow_CreatePinWidgets);
+
+	UK2Node_ParallelConditionalSequence* ParallelConditionalSequence = CastChecked<UK2Node_ParallelConditionalSequence>(GraphNode);
+	INC_DWORD_STAT_BY(STAT_AdvancedControlFlow_CreatedPinWidgets, ParallelConditionalSequence->GetCasePinCount());
+
+	for (auto It = GraphNode->Pins.CreateConstIterator(); It; ++It)
+	{
+		UEdGraphPin* Pin = *It;
+		if ((!Pin->bHidden) && ShouldCreateCasePinWidget(Pin))
+		{
+			TSharedPtr<SGraphPin> NewPin = FNodeFactory::CreatePinWidget(Pin);
+			check(NewPin.IsValid());
+
+			this->AddPin(NewPin.ToSharedRef());
+		}
+	}
+}
\ No newline at end of file
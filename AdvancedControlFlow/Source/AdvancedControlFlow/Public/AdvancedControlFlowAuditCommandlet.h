@@ -0,0 +1,56 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "AdvancedControlFlowAuditCommandlet.generated.h"
+
+class UBlueprint;
+
+// The audit result of one node of this plugin.
+struct FAdvancedControlFlowAuditEntry
+{
+	FString BlueprintPath;
+	FString GraphName;
+	FString NodeClass;
+	FGuid NodeGuid;
+	int32 CaseCount = 0;
+	// Number of the conditions which are not linked, and the ones of them which are always true/false.
+	// They are always 0 on the nodes which branch on a value (ex. Multi-Branch on Value), because their keys are literals.
+	int32 UnconnectedConditionCount = 0;
+	int32 AlwaysTrueConditionCount = 0;
+	int32 AlwaysFalseConditionCount = 0;
+	// Bytes of the generated bytecode which the debug data maps to the node (including its intermediate nodes).
+	int32 BytecodeSize = 0;
+	// Number of the intermediate nodes which the compile spawned for the node (ex. by ExpandNode).
+	int32 IntermediateNodeCount = 0;
+};
+
+// Commandlet which reports the nodes of this plugin which have the case pins (ex. Multi-Branch) in the project.
+//   UnrealEditor-Cmd <Project> -run=AdvancedControlFlowAudit [-Path=/Game,...] [-BatchSize=16] [-Output=<Directory>]
+// The report is written to AdvancedControlFlowAudit.json and AdvancedControlFlowAudit.csv in the output directory.
+UCLASS(MinimalAPI)
+class UAdvancedControlFlowAuditCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAdvancedControlFlowAuditCommandlet(const FObjectInitializer& ObjectInitializer);
+
+	// Override from UCommandlet
+	virtual int32 Main(const FString& Params) override;
+
+	// Compile the Blueprint and append the audit results of its nodes to OutEntries.
+	ADVANCEDCONTROLFLOW_API static void AuditBlueprint(UBlueprint* Blueprint, TArray<FAdvancedControlFlowAuditEntry>& OutEntries);
+
+	ADVANCEDCONTROLFLOW_API static FString ToJson(const TArray<FAdvancedControlFlowAuditEntry>& Entries);
+	ADVANCEDCONTROLFLOW_API static FString ToCSV(const TArray<FAdvancedControlFlowAuditEntry>& Entries);
+};
@@ -0,0 +1,36 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "BlueprintCompilerExtension.h"
+
+#include "AdvancedControlFlowAuditCompilerExtension.generated.h"
+
+class UEdGraphNode;
+
+// Compiler extension which counts the intermediate nodes of the nodes of this plugin for the audit commandlet.
+// The nodes are not changed by the compile, so the count is taken from the intermediate graphs after the compile.
+UCLASS()
+class UAdvancedControlFlowAuditCompilerExtension : public UBlueprintCompilerExtension
+{
+	GENERATED_BODY()
+
+public:
+	// Return the extension which is registered to all Blueprints on the first call.
+	static UAdvancedControlFlowAuditCompilerExtension* Get();
+
+	// Number of the intermediate nodes per node on the source graph. The nodes are counted only while this is not nullptr.
+	TMap<const UEdGraphNode*, int32>* IntermediateNodeCounts = nullptr;
+
+protected:
+	// Override from UBlueprintCompilerExtension
+	virtual void ProcessBlueprintCompiled(
+		const FKismetCompilerContext& CompilationContext, const FBlueprintCompiledData& Data) override;
+};
@@ -0,0 +1,100 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UEdGraphNode;
+class UEdGraphPin;
+class UFunction;
+struct FBlueprintCompiledStatement;
+struct FBPTerminal;
+struct FKismetFunctionContext;
+
+// Create the literal terminal of the value.
+FBPTerminal* CreateLiteralTerminal(
+	FKismetFunctionContext& Context, UEdGraphNode* SourceNode, const FName& PinCategory, const FString& Value);
+
+// Return true if the condition pin is not linked, so that its value is known on compile. The value is stored to bOutValue.
+bool IsLiteralCondition(const UEdGraphPin* CondPin, bool& bOutValue);
+
+// Return true if the nodes should be compiled with the calls which record the case hits.
+// This is enabled by acf.RecordCaseHits, and always disabled on commandlets (ex. cooking).
+bool ShouldRecordCaseHits();
+
+// Return true if the nodes should be compiled with the calls which trace the taken cases to AdvancedControlFlowChannel.
+// This is enabled by acf.TraceCases, and always disabled on commandlets (ex. cooking).
+bool ShouldTraceCases();
+
+// Return the key which identifies the node in FAdvancedControlFlowCaseHitCounter.
+ADVANCEDCONTROLFLOW_API FName GetCaseHitCounterKey(const UEdGraphNode* Node);
+
+// Create the literal terminal of UAdvancedControlFlowLibrary, which is the context of the calls to its functions.
+FBPTerminal* CreateLibraryTerminal(FKismetFunctionContext& Context, UEdGraphNode* SourceNode);
+
+// Emit the call which records that the case is taken after EvaluatedConditionCount conditions are evaluated.
+// CaseIndex is INDEX_NONE for the default. Return the emitted statement.
+FBlueprintCompiledStatement& EmitRecordCaseHit(
+	FKismetFunctionContext& Context, UEdGraphNode* Node, int32 CaseIndex, int32 EvaluatedConditionCount);
+
+// Find the bool terminal shared by all nodes of this plugin in the function, or create it if it does not exist.
+// The terminal is written and read back right away by the comparison, so one terminal per function is enough and the frame size
+// does not grow with the number of nodes.
+FBPTerminal* FindOrCreateScratchBoolTerminal(FKismetFunctionContext& Context, UEdGraphNode* SourceNode);
+
+// Same as FindOrCreateScratchBoolTerminal, but for the int value which is read only by the node which writes it.
+FBPTerminal* FindOrCreateScratchIntTerminal(FKismetFunctionContext& Context, UEdGraphNode* SourceNode);
+
+// Find the int64 terminal which holds the start cycle of the traced case of the node, or create it if it does not exist.
+FBPTerminal* FindOrCreateTraceStartTerminal(FKismetFunctionContext& Context, UEdGraphNode* Node);
+
+// Same as FindOrCreateTraceStartTerminal, but for the int index of the traced case which is executed after the node
+// (ex. the stage of Conditional Sequence).
+FBPTerminal* FindOrCreateTraceCaseTerminal(FKismetFunctionContext& Context, UEdGraphNode* Node);
+
+// Emit StartTerm = BeginTraceCase(). Return the emitted statement.
+FBlueprintCompiledStatement& EmitBeginTraceCase(FKismetFunctionContext& Context, UEdGraphNode* Node, FBPTerminal* StartTerm);
+
+// Emit StartTerm = TraceCaseTaken(Node key, CaseIndex, StartTerm), which traces the case from StartTerm to now and clears
+// StartTerm. CaseIndex is INDEX_NONE for the default. Return the emitted statement.
+FBlueprintCompiledStatement& EmitTraceCaseTaken(
+	FKismetFunctionContext& Context, UEdGraphNode* Node, FBPTerminal* CaseIndexTerm, FBPTerminal* StartTerm);
+FBlueprintCompiledStatement& EmitTraceCaseTaken(
+	FKismetFunctionContext& Context, UEdGraphNode* Node, int32 CaseIndex, FBPTerminal* StartTerm);
+
+struct FDispatchTreeCase
+{
+	FBPTerminal* KeyTerm;
+	UEdGraphPin* ExecPin;
+};
+
+struct FDispatchTreeContext
+{
+	UEdGraphNode* Node;
+	// The value compared with the case keys.
+	FBPTerminal* SelectionTerm;
+	// The comparison result (see FindOrCreateScratchBoolTerminal).
+	FBPTerminal* BoolTerm;
+	FBPTerminal* FunctionContext;
+	// bool (Selection, Key) functions.
+	UFunction* LessFunction;
+	UFunction* EqualFunction;
+	UEdGraphPin* DefaultExecPin;
+};
+
+// Emit the binary decision tree which jumps to the first case whose key is greater than the selection.
+// The keys must be sorted in ascending order without duplication. Return the first statement of the tree.
+FBlueprintCompiledStatement& EmitLessThanDispatchTree(
+	FKismetFunctionContext& Context, const FDispatchTreeContext& TreeContext, const TArray<FDispatchTreeCase>& Cases);
+
+// Emit the binary decision tree which jumps to the case whose key is equal to the selection.
+// The keys must be sorted in ascending order without duplication. Return the first statement of the tree.
+FBlueprintCompiledStatement& EmitEqualDispatchTree(
+	FKismetFunctionContext& Context, const FDispatchTreeContext& TreeContext, const TArray<FDispatchTreeCase>& Cases);
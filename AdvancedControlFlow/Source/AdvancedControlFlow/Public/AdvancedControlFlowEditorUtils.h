@@ -0,0 +1,25 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+
+// Mark the Blueprint as modified and broadcast the change on the next editor tick.
+// The requests in the same frame (ex. auto-wiring or pasting many nodes) are coalesced into one broadcast per Blueprint, so that
+// the editor panels are refreshed only once.
+void RequestDeferredBlueprintModified(UBlueprint* Blueprint);
+
+// Process the requested updates right now.
+ADVANCEDCONTROLFLOW_API void FlushDeferredBlueprintModified();
+
+// Discard the requested updates (ex. on module shutdown).
+void CancelDeferredBlueprintModified();
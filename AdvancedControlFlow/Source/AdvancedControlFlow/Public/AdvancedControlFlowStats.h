@@ -0,0 +1,36 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+// Stats are also emitted as the CPU trace events, so they can be seen on Unreal Insights with "-trace=cpu".
+DECLARE_STATS_GROUP(TEXT("AdvancedControlFlow"), STATGROUP_AdvancedControlFlow, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ExpandNode"), STAT_AdvancedControlFlow_ExpandNode, STATGROUP_AdvancedControlFlow, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RegisterNets"), STAT_AdvancedControlFlow_RegisterNets, STATGROUP_AdvancedControlFlow, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Compile"), STAT_AdvancedControlFlow_Compile, STATGROUP_AdvancedControlFlow, );
+DECLARE_CYCLE_STAT_EXTERN(
+	TEXT("ReallocatePinsDuringReconstruction"), STAT_AdvancedControlFlow_ReallocatePins, STATGROUP_AdvancedControlFlow, );
+DECLARE_CYCLE_STAT_EXTERN(
+	TEXT("PinConnectionListChanged"), STAT_AdvancedControlFlow_PinConnectionListChanged, STATGROUP_AdvancedControlFlow, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Edit Case Pins"), STAT_AdvancedControlFlow_EditCasePins, STATGROUP_AdvancedControlFlow, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CreatePinWidgets"), STAT_AdvancedControlFlow_CreatePinWidgets, STATGROUP_AdvancedControlFlow, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("Compiled Case Pairs"), STAT_AdvancedControlFlow_CompiledCasePairs, STATGROUP_AdvancedControlFlow, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("Reallocated Case Pairs"), STAT_AdvancedControlFlow_ReallocatedCasePairs, STATGROUP_AdvancedControlFlow, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("Kept Case Layouts"), STAT_AdvancedControlFlow_KeptCaseLayouts, STATGROUP_AdvancedControlFlow, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("Edited Case Pairs"), STAT_AdvancedControlFlow_EditedCasePairs, STATGROUP_AdvancedControlFlow, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(
+	TEXT("Created Pin Widgets"), STAT_AdvancedControlFlow_CreatedPinWidgets, STATGROUP_AdvancedControlFlow, );
@@ -19,15 +19,45 @@ typedef TPair<UEdGraphPin*, UEdGraphPin*> CasePinPair;
 extern const FName DefaultExecPinName;
 extern const FName DefaultExecPinFriendlyName;
 
+struct FCasePinIndexEntry
+{
+	int32 CaseIndex;
+	bool bIsCaseKey;
+};
+
+// Layout of the pins on the node when it was saved.
+USTRUCT()
+struct FCasePinLayout
+{
+	GENERATED_BODY()
+
+	// CaseLayoutVersion of the node class, or INDEX_NONE if the layout is not saved.
+	UPROPERTY()
+	int32 Version = INDEX_NONE;
+
+	UPROPERTY()
+	int32 CaseCount = 0;
+
+	UPROPERTY()
+	int32 PinCount = 0;
+
+	// Hash of the name, the type, the direction and the default object of the pins (see ComputeCasePinSignature).
+	UPROPERTY()
+	uint32 PinSignature = 0;
+};
+
 UCLASS(MinimalAPI)
 class UK2Node_CasePairedPinsNode : public UK2Node
 {
 	GENERATED_BODY()
 
+	friend class FCasePinsChange;
+
 protected:
 	// Override from UK2Node
 	virtual void GetNodeContextMenuActions(class UToolMenu* Menu, class UGraphNodeContextMenuContext* Context) const override;
 	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
+	virtual void PostEditUndo() override;
 	virtual bool CanEverInsertExecutionPin() const override
 	{
 		return true;
@@ -51,7 +81,6 @@ protected:
 	int32 GetCaseIndexFromCaseValuePin(UEdGraphPin* Pin) const;
 
 	CasePinPair GetCasePinPair(UEdGraphPin* Pin) const;
-	TArray<CasePinPair> GetCasePinPairs() const;
 
 	FString GetCasePinName(const FString& Prefix, int32 CaseIndex) const;
 	FString GetCasePinFriendlyName(const FString& Prefix, int32 CaseIndex) const;
@@ -60,17 +89,41 @@ protected:
 	{
 		return CasePinPair();
 	}
-	void AddCasePinAfter(UEdGraphPin* Pin);
-	void AddCasePinBefore(UEdGraphPin* Pin);
-	void RemoveCasePinAt(UEdGraphPin* Pin);
+	// Carry over the data of the old case pins at the same case index during the reconstruction.
+	virtual void RestoreCasePinPair(const CasePinPair& NewPair, const CasePinPair& OldPair);
 	void RemoveCasePinAt(int32 CaseIndex);
 	void RemoveFirstCasePin();
 	void RemoveLastCasePin();
+	void RenameCasePinPairs(int32 StartCaseIndex);
+	void InsertCasePairs(int32 CaseIndex, int32 Count);
+	void RemoveCasePairs(int32 CaseIndex, int32 Count);
+	void GetInsertCasesSubMenu(class UToolMenu* Menu, int32 CaseIndex);
 
 	bool IsCasePin(const UEdGraphPin* Pin) const;
 	bool IsCaseKeyPin(const UEdGraphPin* Pin) const;
 	bool IsCaseValuePin(const UEdGraphPin* Pin) const;
 
+	// Case pin index cache.
+	bool ParseCasePinName(const FName& PinName, const FName& Prefix, int32& OutCaseIndex) const;
+	void RebuildCasePinCache() const;
+	void EnsureCasePinCache() const;
+	void InvalidateCasePinCache();
+	void RegisterCasePinPair(int32 CaseIndex, const CasePinPair& Pair);
+	void ReindexCasePinCache(int32 StartCaseIndex);
+	// Return the index of Pins which AddCasePinPair creates the case pin at (INDEX_NONE appends it during InsertCasePairs).
+	int32 GetCasePinInsertIndex(int32 PinIndex) const;
+	void UnregisterCasePinPairs(int32 CaseIndex, int32 Count);
+	const FCasePinIndexEntry* FindCasePinIndexEntry(const UEdGraphPin* Pin) const;
+
+	// Undo record of the case pin edits.
+	// The inserted or removed cases are recorded as FCasePinsChange instead of the snapshot of the whole node if possible.
+	bool CanRecordCasePinsChange(int32 CaseIndex, int32 Count) const;
+	void RecordCasePinsChange(bool bInserted, int32 CaseIndex, int32 Count);
+
+	// Saved case layout.
+	void SaveCaseLayout();
+	bool IsSavedCaseLayoutUpToDate() const;
+
 	FName NodeContextMenuSectionName;
 	FText NodeContextMenuSectionLabel;
 	FName CaseKeyPinNamePrefix;
@@ -78,12 +131,53 @@ protected:
 	FName CaseKeyPinFriendlyNamePrefix;
 	FName CaseValuePinFriendlyNamePrefix;
 
+	// Version of the pin layout which the node class creates for the case count.
+	// Bump it when the pins of the node class are changed, so that the nodes saved with the old layout are reconstructed on load.
+	// INDEX_NONE (default) always reconstructs the node, which is needed if the pins depend on others (ex. wildcard pins).
+	int32 CaseLayoutVersion = INDEX_NONE;
+
+	// If this matches the pins on load, ReconstructNode keeps the loaded pins instead of recreating them.
+	UPROPERTY()
+	FCasePinLayout SavedCaseLayout;
+
+	// Transient cache which maps a case index to the key/value pins and a pin to its case index.
+	// The cache is rebuilt from the pin names when the pin list is changed outside of the case pin functions.
+	mutable TArray<CasePinPair> CasePinPairCache;
+	mutable TMap<const UEdGraphPin*, FCasePinIndexEntry> CasePinIndexCache;
+	mutable int32 CasePinCachePinCount;
+	mutable bool bCasePinCacheValid;
+
+	// True while InsertCasePairs appends the case pins to splice them at once.
+	bool bAppendingCasePins = false;
+
 public:
 	UK2Node_CasePairedPinsNode(const FObjectInitializer& ObjectInitializer);
 
-	UEdGraphPin* GetCaseValuePinFromCaseKeyPin(const UEdGraphPin* CondPin) const;
-	UEdGraphPin* GetCaseKeyPinFromCaseValuePin(const UEdGraphPin* ExecPin) const;
-
-	int32 GetCasePinCount() const;
-	void AddCasePinLast();
+	// Override from UObject
+	virtual void Serialize(FArchive& Ar) override;
+
+	// Override from UEdGraphNode
+	virtual void ReconstructNode() override;
+
+	ADVANCEDCONTROLFLOW_API UEdGraphPin* GetCaseValuePinFromCaseKeyPin(const UEdGraphPin* CondPin) const;
+	ADVANCEDCONTROLFLOW_API UEdGraphPin* GetCaseKeyPinFromCaseValuePin(const UEdGraphPin* ExecPin) const;
+
+	ADVANCEDCONTROLFLOW_API int32 GetCasePinCount() const;
+	ADVANCEDCONTROLFLOW_API TArray<CasePinPair> GetCasePinPairs() const;
+	ADVANCEDCONTROLFLOW_API void AddCasePinLast();
+	// Same as the context menu actions on the case pin.
+	ADVANCEDCONTROLFLOW_API void AddCasePinAfter(UEdGraphPin* Pin);
+	ADVANCEDCONTROLFLOW_API void AddCasePinBefore(UEdGraphPin* Pin);
+	ADVANCEDCONTROLFLOW_API void RemoveCasePinAt(UEdGraphPin* Pin);
+
+	// Batch editing of the case pins.
+	// The following pins are renamed in one pass and the Blueprint is marked as structurally modified only once.
+	ADVANCEDCONTROLFLOW_API void InsertCases(int32 CaseIndex, int32 Count);
+	ADVANCEDCONTROLFLOW_API void RemoveCases(int32 CaseIndex, int32 Count);
+	ADVANCEDCONTROLFLOW_API void SetCaseCount(int32 CaseCount);
+
+	// If true, the node widget creates the pin widgets only for the cases which have any connected pin.
+	// This is toggled on the node widget, and keeps the graph editor responsive with many cases.
+	UPROPERTY()
+	bool bHideUnconnectedCases = false;
 };
@@ -30,13 +30,21 @@ class UK2Node_ConditionalSequence : public UK2Node_CasePairedPinsNode
 	virtual FText GetMenuCategory() const override;
 	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
 	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
 
 	void CreateExecTriggeringPin();
 	void CreateDefaultExecPin();
 	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
+	bool IsConditionReadOnEvaluation(const UEdGraphPin* CondPin) const;
 
 public:
 	UK2Node_ConditionalSequence(const FObjectInitializer& ObjectInitializer);
 
-	UEdGraphPin* GetDefaultExecPin() const;
+	ADVANCEDCONTROLFLOW_API UEdGraphPin* GetDefaultExecPin() const;
+
+	// If true, all case conditions are evaluated once before the first stage, and the stages run on this snapshot.
+	// The case executions can not change the conditions of the later stages, and the pure nodes connected to the conditions are
+	// evaluated once per execution even if they are shared by the several conditions.
+	UPROPERTY(EditAnywhere, Category = "Conditional Sequence")
+	bool bSnapshotConditions = false;
 };
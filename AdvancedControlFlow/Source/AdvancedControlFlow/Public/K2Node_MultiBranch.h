@@ -19,6 +19,7 @@ class UK2Node_MultiBranch : public UK2Node_CasePairedPinsNode
 {
 	GENERATED_BODY()
 
+protected:
 	// Override from UEdGraphNode
 	virtual void AllocateDefaultPins() override;
 	virtual FText GetTooltipText() const override;
@@ -27,6 +28,7 @@ class UK2Node_MultiBranch : public UK2Node_CasePairedPinsNode
 	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
 
 	// Override from UK2Node
+	virtual void GetNodeContextMenuActions(class UToolMenu* Menu, class UGraphNodeContextMenuContext* Context) const override;
 	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
 	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
 	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
@@ -36,6 +38,8 @@ class UK2Node_MultiBranch : public UK2Node_CasePairedPinsNode
 	void CreateExecTriggeringPin();
 	void CreateDefaultExecPin();
 	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
+	void ApplyRecordedCaseHits();
+	void ClearCaseHitCounts();
 
 	TSubclassOf<class UObject> ConditionPreProcessFuncClass;
 	FName ConditionPreProcessFuncName;
@@ -43,6 +47,20 @@ class UK2Node_MultiBranch : public UK2Node_CasePairedPinsNode
 public:
 	UK2Node_MultiBranch(const FObjectInitializer& ObjectInitializer);
 
-	UEdGraphPin* GetDefaultExecPin() const;
+	ADVANCEDCONTROLFLOW_API UEdGraphPin* GetDefaultExecPin() const;
 	UEdGraphPin* GetFunctionPin() const;
+
+	// Return the case indices in the order which the conditions are tested.
+	// If the cases are mutually exclusive, the most frequently taken case is tested first.
+	ADVANCEDCONTROLFLOW_API TArray<int32> GetCaseEvaluationOrder() const;
+
+	// If true, at most one condition is true at the same time, so the conditions may be tested in any order.
+	// The conditions are tested in descending order of the case hit counts (see "Apply Recorded Case Hits").
+	UPROPERTY(EditAnywhere, Category = "Multi-Branch")
+	bool bCasesMutuallyExclusive = false;
+
+	// Number of times each case was taken, keyed by the case execution pin ID.
+	// This is captured from the case hit counters and is not changed on compiling.
+	UPROPERTY()
+	TMap<FGuid, int64> CaseHitCounts;
 };
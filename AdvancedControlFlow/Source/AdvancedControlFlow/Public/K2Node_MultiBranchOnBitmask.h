@@ -0,0 +1,53 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "K2Node_CasePairedPinsNode.h"
+
+#include "K2Node_MultiBranchOnBitmask.generated.h"
+
+UCLASS(MinimalAPI, meta = (Keywords = "Switch Bit Flags Bitmask MultiBranch"))
+class UK2Node_MultiBranchOnBitmask : public UK2Node_CasePairedPinsNode
+{
+	GENERATED_BODY()
+
+	// Override from UEdGraphNode
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetTooltipText() const override;
+	virtual FLinearColor GetNodeTitleColor() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
+
+	// Override from UK2Node
+	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetMenuCategory() const override;
+	virtual bool IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const override;
+
+	void CreateFunctionPins();
+	void CreateExecTriggeringPin();
+	void CreateMaskPin();
+	void CreateDefaultExecPin();
+	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
+
+public:
+	UK2Node_MultiBranchOnBitmask(const FObjectInitializer& ObjectInitializer);
+
+	ADVANCEDCONTROLFLOW_API UEdGraphPin* GetDefaultExecPin() const;
+	ADVANCEDCONTROLFLOW_API UEdGraphPin* GetMaskPin() const;
+	UEdGraphPin* GetCompareFunctionPin() const;
+	UEdGraphPin* GetBitFunctionPin() const;
+
+	// Return true if the pin type can be used as the mask (int or int64).
+	static bool IsSupportedMaskType(const FEdGraphPinType& PinType);
+};
@@ -0,0 +1,44 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "K2Node_MultiBranch.h"
+
+#include "K2Node_MultiBranchOnChange.generated.h"
+
+// Multi-Branch which is executed again whenever any of the watched fields of the source is changed.
+// The source is bound to the field notifications on the first execution, so the node is executed once (ex. on Event Construct)
+// instead of polling the conditions on Event Tick. The pin layout is same as Multi-Branch, and the source pin is the last.
+UCLASS(MinimalAPI, meta = (Keywords = "If ElseIf Else Branch MultiBranch Change Changed Tick FieldNotify"))
+class UK2Node_MultiBranchOnChange : public UK2Node_MultiBranch
+{
+	GENERATED_BODY()
+
+	// Override from UEdGraphNode
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetTooltipText() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual bool IsCompatibleWithGraph(const UEdGraph* TargetGraph) const override;
+
+	// Override from UK2Node
+	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
+	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+
+	void CreateSourcePin();
+
+public:
+	UK2Node_MultiBranchOnChange(const FObjectInitializer& ObjectInitializer);
+
+	ADVANCEDCONTROLFLOW_API UEdGraphPin* GetSourcePin() const;
+
+	// Names of the fields of the source which execute this node when they are changed (ex. the FieldNotify variables).
+	UPROPERTY(EditAnywhere, Category = "Multi-Branch on Change")
+	TArray<FName> WatchedFields;
+};
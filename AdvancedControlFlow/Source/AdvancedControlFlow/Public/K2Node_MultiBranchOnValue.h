@@ -0,0 +1,69 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "K2Node_CasePairedPinsNode.h"
+
+#include "K2Node_MultiBranchOnValue.generated.h"
+
+UENUM()
+enum class EMultiBranchOnValueCompareMode : uint8
+{
+	// Execution goes where the value is equal to the case key.
+	Equal UMETA(DisplayName = "Equal (==)"),
+	// Execution goes where the value is less than the case threshold first.
+	LessThan UMETA(DisplayName = "Less Than (<)"),
+};
+
+UCLASS(MinimalAPI, meta = (Keywords = "Switch Range Threshold MultiBranch"))
+class UK2Node_MultiBranchOnValue : public UK2Node_CasePairedPinsNode
+{
+	GENERATED_BODY()
+
+	// Override from UEdGraphNode
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetTooltipText() const override;
+	virtual FLinearColor GetNodeTitleColor() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	// Override from UK2Node
+	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetMenuCategory() const override;
+	virtual bool IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const override;
+
+	void CreateFunctionPin();
+	void CreateExecTriggeringPin();
+	void CreateSelectionPin();
+	void CreateDefaultExecPin();
+	void UpdateCaseKeyPinFriendlyNamePrefix();
+	void ResetCaseKeyPinDefaultValue(UEdGraphPin* KeyPin, int32 CaseIndex) const;
+	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
+
+public:
+	UK2Node_MultiBranchOnValue(const FObjectInitializer& ObjectInitializer);
+
+	ADVANCEDCONTROLFLOW_API UEdGraphPin* GetDefaultExecPin() const;
+	ADVANCEDCONTROLFLOW_API UEdGraphPin* GetSelectionPin() const;
+	UEdGraphPin* GetFunctionPin() const;
+
+	// Return true if the pin type can be used as the value to branch on (integer, float or enum).
+	static bool IsSupportedSelectionType(const FEdGraphPinType& PinType);
+
+	// How the value is compared with the case keys.
+	// On Less Than mode, the case thresholds should be sorted in ascending order.
+	UPROPERTY(EditAnywhere, Category = "Multi-Branch on Value")
+	EMultiBranchOnValueCompareMode CompareMode;
+};
@@ -26,12 +26,13 @@ class UK2Node_MultiConditionalSelect : public UK2Node_CasePairedPinsNode
 	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
 	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
 	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 
 	// Override from UK2Node
 	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
 	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
 	virtual FText GetMenuCategory() const override;
-	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
 	virtual bool IsNodePure() const override
 	{
 		return true;
@@ -41,10 +42,17 @@ class UK2Node_MultiConditionalSelect : public UK2Node_CasePairedPinsNode
 	// Internal functions.
 	void CreateDefaultOptionPin();
 	void CreateReturnValuePin();
-	UEdGraphPin* GetDefaultOptionPin() const;
-	UEdGraphPin* GetReturnValuePin() const;
+	EPinContainerType GetOptionContainerType() const;
 	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
 
 public:
 	UK2Node_MultiConditionalSelect(const FObjectInitializer& ObjectInitializer);
+
+	ADVANCEDCONTROLFLOW_API UEdGraphPin* GetDefaultOptionPin() const;
+	ADVANCEDCONTROLFLOW_API UEdGraphPin* GetReturnValuePin() const;
+
+	// If true, the options, the conditions, the default and the return value are arrays, and the option is selected for each
+	// element. Each case is resolved for the whole arrays by one native call, instead of running the node in a loop.
+	UPROPERTY(EditAnywhere, Category = "Multi-Conditional Select")
+	bool bElementWise = false;
 };
@@ -22,8 +22,23 @@ class SGraphNodeCasePairedPinsNode : public SGraphNodeK2Base
 
 	void Construct(const FArguments& InArgs, UK2Node_CasePairedPinsNode* InNode);
 
+	// Override from SGraphNode
+	virtual void GetNodeInfoPopups(FNodeInfoContext* Context, TArray<FGraphInformationPopupInfo>& Popups) const override;
+
 protected:
 	virtual void CreateOutputSideAddButton(TSharedPtr<SVerticalBox> OutputBox) override;
 	virtual EVisibility IsAddPinButtonVisible() const override;
 	virtual FReply OnAddPin() override;
+
+	// Return false if the pin belongs to the case which is hidden by UK2Node_CasePairedPinsNode::bHideUnconnectedCases.
+	bool ShouldCreateCasePinWidget(const UEdGraphPin* Pin) const;
+
+private:
+	void CreateHideUnconnectedCasesButton(TSharedPtr<SVerticalBox> OutputBox);
+	EVisibility IsHideUnconnectedCasesButtonVisible() const;
+	FReply OnHideUnconnectedCasesButtonClicked();
+
+	// Insert the pin widgets of the last case without rebuilding the other widgets.
+	// Return false if the widgets can not be inserted, and the node widget must be updated.
+	bool InsertLastCasePinWidgets();
 };
\ No newline at end of file
@@ -0,0 +1,26 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "SGraphNodeCasePairedPinsNode.h"
+
+// Node widget of the nodes which branch on the selection pin (Multi-Branch on Value, Bitmask and Name).
+// The case key pins follow the execution and selection pins, and the default execution pin is placed after the case pins.
+class SGraphNodeMultiBranchOnSelection : public SGraphNodeCasePairedPinsNode
+{
+	SLATE_BEGIN_ARGS(SGraphNodeMultiBranchOnSelection)
+	{
+	}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, UK2Node_CasePairedPinsNode* InNode);
+
+	virtual void CreatePinWidgets() override;
+};
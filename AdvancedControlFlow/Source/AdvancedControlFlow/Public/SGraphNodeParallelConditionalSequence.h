@@ -0,0 +1,26 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "SGraphNodeCasePairedPinsNode.h"
+
+class UK2Node_ParallelConditionalSequence;
+
+class SGraphNodeParallelConditionalSequence : public SGraphNodeCasePairedPinsNode
+{
+	SLATE_BEGIN_ARGS(SGraphNodeParallelConditionalSequence)
+	{
+	}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, UK2Node_ParallelConditionalSequence* InNode);
+
+	virtual void CreatePinWidgets() override;
+};
\ No newline at end of file
@@ -0,0 +1,29 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "KismetPins/SGraphPinExec.h"
+
+// Pin widget of the default execution pin placed after the case pins, whose label is drawn in the default pin name style.
+class SGraphPinExecDefault : public SGraphPinExec
+{
+public:
+	SLATE_BEGIN_ARGS(SGraphPinExecDefault)
+	{
+	}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, UEdGraphPin* InPin)
+	{
+		SGraphPin::Construct(SGraphPin::FArguments().PinLabelStyle(FName("Graph.Node.DefaultPinName")), InPin);
+
+		CachePinIcons();
+	}
+};
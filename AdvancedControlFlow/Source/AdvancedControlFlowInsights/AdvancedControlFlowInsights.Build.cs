@@ -0,0 +1,30 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+using UnrealBuildTool;
+
+public class AdvancedControlFlowInsights : ModuleRules
+{
+	public AdvancedControlFlowInsights(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[]{
+			"Core",
+			"TraceAnalysis",
+			"TraceServices",
+		});
+
+		PrivateDependencyModuleNames.AddRange(new string[]{
+			"Slate",
+			"SlateCore",
+			"TraceInsights",
+		});
+	}
+}
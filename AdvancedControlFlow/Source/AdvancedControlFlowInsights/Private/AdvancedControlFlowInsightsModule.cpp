@@ -0,0 +1,47 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowInsightsModule.h"
+
+#if ACF_WITH_INSIGHTS
+#include "AdvancedControlFlowTimingTrack.h"
+#include "AdvancedControlFlowTraceAnalyzer.h"
+#include "Features/IModularFeatures.h"
+#include "Insights/ITimingViewExtender.h"
+#include "TraceServices/ModuleService.h"
+#endif
+
+void FAdvancedControlFlowInsightsModule::StartupModule()
+{
+#if ACF_WITH_INSIGHTS
+	TraceModule = MakeShared<FAdvancedControlFlowTraceModule>();
+	TimingViewExtender = MakeShared<FAdvancedControlFlowTimingViewExtender>();
+
+	IModularFeatures::Get().RegisterModularFeature(TraceServices::ModuleFeatureName, TraceModule.Get());
+	IModularFeatures::Get().RegisterModularFeature(UE::Insights::Timing::TimingViewExtenderFeatureName, TimingViewExtender.Get());
+#endif
+}
+
+void FAdvancedControlFlowInsightsModule::ShutdownModule()
+{
+#if ACF_WITH_INSIGHTS
+	IModularFeatures::Get().UnregisterModularFeature(UE::Insights::Timing::TimingViewExtenderFeatureName, TimingViewExtender.Get());
+	IModularFeatures::Get().UnregisterModularFeature(TraceServices::ModuleFeatureName, TraceModule.Get());
+
+	TimingViewExtender.Reset();
+	TraceModule.Reset();
+#endif
+}
+
+bool FAdvancedControlFlowInsightsModule::SupportsDynamicReloading()
+{
+	return true;
+}
+
+IMPLEMENT_MODULE(FAdvancedControlFlowInsightsModule, AdvancedControlFlowInsights);
@@ -0,0 +1,118 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowTimingTrack.h"
+
+#if ACF_WITH_INSIGHTS
+
+#include "AdvancedControlFlowTraceProvider.h"
+#include "Insights/ITimingViewSession.h"
+#include "Insights/ViewModels/TimingTrackViewport.h"
+#include "Misc/Paths.h"
+#include "TraceServices/Model/AnalysisSession.h"
+
+// ARGB colors of the cases. The default is gray.
+static const uint32 CaseColors[] = {0xFF4E79A7, 0xFFF28E2B, 0xFF59A14F, 0xFFE15759, 0xFF76B7B2, 0xFFEDC948, 0xFFB07AA1, 0xFFFF9DA7};
+static const uint32 DefaultCaseColor = 0xFF808080;
+
+static uint32 GetCaseColor(int32 CaseIndex)
+{
+	return (CaseIndex == INDEX_NONE) ? DefaultCaseColor : CaseColors[CaseIndex % UE_ARRAY_COUNT(CaseColors)];
+}
+
+FAdvancedControlFlowTimingTrack::FAdvancedControlFlowTimingTrack(
+	const TraceServices::IAnalysisSession& InAnalysisSession, int32 InBlueprintIndex, const FString& BlueprintPath)
+	: FTimingEventsTrack(FString::Printf(TEXT("Advanced Control Flow - %s"), *FPaths::GetExtension(BlueprintPath))),
+	  AnalysisSession(InAnalysisSession),
+	  BlueprintIndex(InBlueprintIndex)
+{
+}
+
+void FAdvancedControlFlowTimingTrack::BuildDrawState(
+	ITimingEventsTrackDrawStateBuilder& Builder, const ITimingTrackUpdateContext& Context)
+{
+	TraceServices::FAnalysisSessionReadScope ReadScope(AnalysisSession);
+
+	const FAdvancedControlFlowTraceProvider* Provider =
+		AnalysisSession.ReadProvider<FAdvancedControlFlowTraceProvider>(FAdvancedControlFlowTraceProvider::ProviderName);
+	if (Provider == nullptr)
+	{
+		return;
+	}
+
+	const FTimingTrackViewport& Viewport = Context.GetViewport();
+	Provider->EnumerateCases(BlueprintIndex, Viewport.GetStartTime(), Viewport.GetEndTime(),
+		[&Builder, Provider](const FAdvancedControlFlowTracedCase& Case, const FAdvancedControlFlowTracedNode& Node) {
+			Builder.AddEvent(Case.StartTime, Case.EndTime, Node.Lane, Provider->GetCaseName(Case.CaseIndex), Case.NodeId,
+				GetCaseColor(Case.CaseIndex));
+		});
+}
+
+void FAdvancedControlFlowTimingViewExtender::OnBeginSession(UE::Insights::Timing::ITimingViewSession& InSession)
+{
+	SessionTracks.Add(&InSession);
+}
+
+void FAdvancedControlFlowTimingViewExtender::OnEndSession(UE::Insights::Timing::ITimingViewSession& InSession)
+{
+	SessionTracks.Remove(&InSession);
+}
+
+void FAdvancedControlFlowTimingViewExtender::Tick(
+	UE::Insights::Timing::ITimingViewSession& InSession, const TraceServices::IAnalysisSession& InAnalysisSession)
+{
+	TArray<TSharedPtr<FAdvancedControlFlowTimingTrack>>* Tracks = SessionTracks.Find(&InSession);
+	if (Tracks == nullptr)
+	{
+		return;
+	}
+
+	TraceServices::FAnalysisSessionReadScope ReadScope(InAnalysisSession);
+
+	const FAdvancedControlFlowTraceProvider* Provider =
+		InAnalysisSession.ReadProvider<FAdvancedControlFlowTraceProvider>(FAdvancedControlFlowTraceProvider::ProviderName);
+	if (Provider == nullptr)
+	{
+		return;
+	}
+
+	// The Blueprints are only added to the provider, so the new tracks are appended.
+	const int32 BlueprintCount = Provider->GetBlueprintCount();
+	const bool bTrackAdded = Tracks->Num() < BlueprintCount;
+	for (int32 BlueprintIndex = Tracks->Num(); BlueprintIndex < BlueprintCount; ++BlueprintIndex)
+	{
+		TSharedPtr<FAdvancedControlFlowTimingTrack> Track = MakeShared<FAdvancedControlFlowTimingTrack>(
+			InAnalysisSession, BlueprintIndex, Provider->GetBlueprintPath(BlueprintIndex));
+		InSession.AddScrollableTrack(Track);
+		Tracks->Add(Track);
+	}
+	if (bTrackAdded)
+	{
+		InSession.InvalidateScrollableTracksOrder();
+	}
+
+	const bool bAnalysisComplete = InAnalysisSession.IsAnalysisComplete();
+	for (int32 BlueprintIndex = 0; BlueprintIndex < Tracks->Num(); ++BlueprintIndex)
+	{
+		FAdvancedControlFlowTimingTrack& Track = *(*Tracks)[BlueprintIndex];
+		const int32 NodeCount = Provider->GetNodeCount(BlueprintIndex);
+		if (Track.GetNumLanes() != NodeCount)
+		{
+			Track.SetNumLanes(NodeCount);
+			Track.SetDirtyFlag();
+		}
+		else if (!bAnalysisComplete)
+		{
+			// The events may be added while the trace is being analyzed.
+			Track.SetDirtyFlag();
+		}
+	}
+}
+
+#endif
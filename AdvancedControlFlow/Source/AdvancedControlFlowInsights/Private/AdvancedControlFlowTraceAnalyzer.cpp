@@ -0,0 +1,81 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowTraceAnalyzer.h"
+
+#if ACF_WITH_INSIGHTS
+
+#include "AdvancedControlFlowTraceProvider.h"
+#include "TraceServices/Model/AnalysisSession.h"
+
+FAdvancedControlFlowTraceAnalyzer::FAdvancedControlFlowTraceAnalyzer(
+	TraceServices::IAnalysisSession& InSession, FAdvancedControlFlowTraceProvider& InProvider)
+	: Session(InSession), Provider(InProvider)
+{
+}
+
+void FAdvancedControlFlowTraceAnalyzer::OnAnalysisBegin(const FOnAnalysisContext& Context)
+{
+	FInterfaceBuilder& Builder = Context.InterfaceBuilder;
+	Builder.RouteEvent(RouteId_NodeSpec, "AdvancedControlFlow", "NodeSpec");
+	Builder.RouteEvent(RouteId_CaseTaken, "AdvancedControlFlow", "CaseTaken");
+}
+
+bool FAdvancedControlFlowTraceAnalyzer::OnEvent(uint16 RouteId, EStyle Style, const FOnEventContext& Context)
+{
+	TraceServices::FAnalysisSessionEditScope EditScope(Session);
+
+	const FEventData& EventData = Context.EventData;
+	switch (RouteId)
+	{
+		case RouteId_NodeSpec:
+		{
+			FString BlueprintPath;
+			FString NodeGuid;
+			EventData.GetString("BlueprintPath", BlueprintPath);
+			EventData.GetString("NodeGuid", NodeGuid);
+			Provider.AddNode(EventData.GetValue<uint32>("NodeId"), BlueprintPath, NodeGuid);
+			break;
+		}
+		case RouteId_CaseTaken:
+		{
+			const double StartTime = Context.EventTime.AsSeconds(EventData.GetValue<uint64>("StartCycle"));
+			const double EndTime = Context.EventTime.AsSeconds(EventData.GetValue<uint64>("EndCycle"));
+			Provider.AddCase(EventData.GetValue<uint32>("NodeId"), EventData.GetValue<int32>("CaseIndex"), StartTime, EndTime);
+			Session.UpdateDurationSeconds(EndTime);
+			break;
+		}
+		default:
+			break;
+	}
+
+	return true;
+}
+
+void FAdvancedControlFlowTraceModule::GetModuleInfo(TraceServices::FModuleInfo& OutModuleInfo)
+{
+	OutModuleInfo.Name = TEXT("AdvancedControlFlow");
+	OutModuleInfo.DisplayName = TEXT("Advanced Control Flow");
+}
+
+void FAdvancedControlFlowTraceModule::OnAnalysisBegin(TraceServices::IAnalysisSession& Session)
+{
+	TSharedPtr<FAdvancedControlFlowTraceProvider> Provider = MakeShared<FAdvancedControlFlowTraceProvider>(Session);
+	Session.AddProvider(FAdvancedControlFlowTraceProvider::ProviderName, Provider);
+
+	// The session owns the analyzer.
+	Session.AddAnalyzer(new FAdvancedControlFlowTraceAnalyzer(Session, *Provider));
+}
+
+void FAdvancedControlFlowTraceModule::GetLoggers(TArray<const TCHAR*>& OutLoggers)
+{
+	OutLoggers.Add(TEXT("AdvancedControlFlow"));
+}
+
+#endif
@@ -0,0 +1,138 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowTraceProvider.h"
+
+#if ACF_WITH_INSIGHTS
+
+#include "Algo/BinarySearch.h"
+
+const FName FAdvancedControlFlowTraceProvider::ProviderName(TEXT("AdvancedControlFlowTraceProvider"));
+
+FAdvancedControlFlowTraceProvider::FAdvancedControlFlowTraceProvider(TraceServices::IAnalysisSession& InSession)
+	: Session(InSession)
+{
+}
+
+void FAdvancedControlFlowTraceProvider::AddNode(uint32 NodeId, const FString& BlueprintPath, const FString& NodeGuid)
+{
+	Session.WriteAccessCheck();
+
+	if (Nodes.Contains(NodeId))
+	{
+		return;
+	}
+
+	int32 BlueprintIndex = INDEX_NONE;
+	if (const int32* FoundIndex = BlueprintIndices.Find(BlueprintPath))
+	{
+		BlueprintIndex = *FoundIndex;
+	}
+	else
+	{
+		BlueprintIndex = Blueprints.AddDefaulted();
+		Blueprints[BlueprintIndex].BlueprintPath = BlueprintPath;
+		BlueprintIndices.Add(BlueprintPath, BlueprintIndex);
+	}
+
+	FAdvancedControlFlowTracedNode& Node = Nodes.Add(NodeId);
+	Node.NodeGuid = NodeGuid;
+	Node.BlueprintIndex = BlueprintIndex;
+	Node.Lane = Blueprints[BlueprintIndex].NodeCount++;
+}
+
+void FAdvancedControlFlowTraceProvider::AddCase(uint32 NodeId, int32 CaseIndex, double StartTime, double EndTime)
+{
+	Session.WriteAccessCheck();
+
+	const FAdvancedControlFlowTracedNode* Node = Nodes.Find(NodeId);
+	if (Node == nullptr)
+	{
+		return;
+	}
+
+	// The names are stored on edit, because the session strings can not be added on read.
+	if (!CaseNames.Contains(CaseIndex))
+	{
+		const FString CaseName = (CaseIndex == INDEX_NONE) ? TEXT("Default") : FString::Printf(TEXT("Case %d"), CaseIndex);
+		CaseNames.Add(CaseIndex, Session.StoreString(*CaseName));
+	}
+
+	FBlueprint& Blueprint = Blueprints[Node->BlueprintIndex];
+	Blueprint.Cases.Add({StartTime, EndTime, NodeId, CaseIndex});
+	Blueprint.MaxDuration = FMath::Max(Blueprint.MaxDuration, EndTime - StartTime);
+}
+
+int32 FAdvancedControlFlowTraceProvider::GetBlueprintCount() const
+{
+	Session.ReadAccessCheck();
+
+	return Blueprints.Num();
+}
+
+const FString& FAdvancedControlFlowTraceProvider::GetBlueprintPath(int32 BlueprintIndex) const
+{
+	Session.ReadAccessCheck();
+
+	return Blueprints[BlueprintIndex].BlueprintPath;
+}
+
+int32 FAdvancedControlFlowTraceProvider::GetNodeCount(int32 BlueprintIndex) const
+{
+	Session.ReadAccessCheck();
+
+	return Blueprints[BlueprintIndex].NodeCount;
+}
+
+const FAdvancedControlFlowTracedNode* FAdvancedControlFlowTraceProvider::FindNode(uint32 NodeId) const
+{
+	Session.ReadAccessCheck();
+
+	return Nodes.Find(NodeId);
+}
+
+void FAdvancedControlFlowTraceProvider::EnumerateCases(int32 BlueprintIndex, double StartTime, double EndTime,
+	TFunctionRef<void(const FAdvancedControlFlowTracedCase&, const FAdvancedControlFlowTracedNode&)> Callback) const
+{
+	Session.ReadAccessCheck();
+
+	if (!Blueprints.IsValidIndex(BlueprintIndex))
+	{
+		return;
+	}
+
+	// The cases are sorted by the end time, and no case is longer than MaxDuration.
+	const FBlueprint& Blueprint = Blueprints[BlueprintIndex];
+	const int32 FirstIndex =
+		Algo::LowerBoundBy(Blueprint.Cases, StartTime, [](const FAdvancedControlFlowTracedCase& Case) { return Case.EndTime; });
+	for (int32 Index = FirstIndex; Index < Blueprint.Cases.Num(); ++Index)
+	{
+		const FAdvancedControlFlowTracedCase& Case = Blueprint.Cases[Index];
+		if (Case.EndTime - Blueprint.MaxDuration > EndTime)
+		{
+			break;
+		}
+		if (Case.StartTime > EndTime)
+		{
+			continue;
+		}
+
+		Callback(Case, Nodes.FindChecked(Case.NodeId));
+	}
+}
+
+const TCHAR* FAdvancedControlFlowTraceProvider::GetCaseName(int32 CaseIndex) const
+{
+	Session.ReadAccessCheck();
+
+	const TCHAR* const* CaseName = CaseNames.Find(CaseIndex);
+	return (CaseName != nullptr) ? *CaseName : TEXT("");
+}
+
+#endif
@@ -0,0 +1,32 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Misc/EngineVersionComparison.h"
+#include "Modules/ModuleManager.h"
+
+// The trace analysis and Timing Insights APIs used by this module are available on UE 5.3 or later.
+// This module does nothing on the older engines.
+#define ACF_WITH_INSIGHTS !UE_VERSION_OLDER_THAN(5, 3, 0)
+
+class FAdvancedControlFlowTraceModule;
+class FAdvancedControlFlowTimingViewExtender;
+
+// Shows the events of AdvancedControlFlowChannel on Timing Insights.
+class FAdvancedControlFlowInsightsModule : public IModuleInterface
+{
+	TSharedPtr<FAdvancedControlFlowTraceModule> TraceModule;
+	TSharedPtr<FAdvancedControlFlowTimingViewExtender> TimingViewExtender;
+
+public:
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+	virtual bool SupportsDynamicReloading() override;
+};
@@ -0,0 +1,53 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "AdvancedControlFlowInsightsModule.h"
+
+#if ACF_WITH_INSIGHTS
+
+#include "CoreMinimal.h"
+#include "Insights/ITimingViewExtender.h"
+#include "Insights/ViewModels/TimingEventsTrack.h"
+
+namespace TraceServices
+{
+class IAnalysisSession;
+}
+
+// Track of the cases taken by the nodes of one Blueprint. Each node has its own lane, and each event is the traced case.
+class FAdvancedControlFlowTimingTrack : public FTimingEventsTrack
+{
+public:
+	FAdvancedControlFlowTimingTrack(
+		const TraceServices::IAnalysisSession& InAnalysisSession, int32 InBlueprintIndex, const FString& BlueprintPath);
+
+	virtual void BuildDrawState(ITimingEventsTrackDrawStateBuilder& Builder, const ITimingTrackUpdateContext& Context) override;
+
+private:
+	const TraceServices::IAnalysisSession& AnalysisSession;
+	int32 BlueprintIndex;
+};
+
+// Adds FAdvancedControlFlowTimingTrack for each Blueprint which has the traced nodes.
+class FAdvancedControlFlowTimingViewExtender : public UE::Insights::Timing::ITimingViewExtender
+{
+public:
+	virtual void OnBeginSession(UE::Insights::Timing::ITimingViewSession& InSession) override;
+	virtual void OnEndSession(UE::Insights::Timing::ITimingViewSession& InSession) override;
+	virtual void Tick(
+		UE::Insights::Timing::ITimingViewSession& InSession, const TraceServices::IAnalysisSession& InAnalysisSession) override;
+
+private:
+	// Tracks of the timing view sessions. The track at the index is for the Blueprint at the index of the provider.
+	TMap<UE::Insights::Timing::ITimingViewSession*, TArray<TSharedPtr<FAdvancedControlFlowTimingTrack>>> SessionTracks;
+};
+
+#endif
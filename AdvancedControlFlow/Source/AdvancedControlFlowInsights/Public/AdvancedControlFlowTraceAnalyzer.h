@@ -0,0 +1,56 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "AdvancedControlFlowInsightsModule.h"
+
+#if ACF_WITH_INSIGHTS
+
+#include "CoreMinimal.h"
+#include "Trace/Analyzer.h"
+#include "TraceServices/ModuleService.h"
+
+class FAdvancedControlFlowTraceProvider;
+
+namespace TraceServices
+{
+class IAnalysisSession;
+}
+
+// Reads the events of AdvancedControlFlowChannel to FAdvancedControlFlowTraceProvider.
+class FAdvancedControlFlowTraceAnalyzer : public UE::Trace::IAnalyzer
+{
+public:
+	FAdvancedControlFlowTraceAnalyzer(TraceServices::IAnalysisSession& InSession, FAdvancedControlFlowTraceProvider& InProvider);
+
+	virtual void OnAnalysisBegin(const FOnAnalysisContext& Context) override;
+	virtual bool OnEvent(uint16 RouteId, EStyle Style, const FOnEventContext& Context) override;
+
+private:
+	enum : uint16
+	{
+		RouteId_NodeSpec,
+		RouteId_CaseTaken,
+	};
+
+	TraceServices::IAnalysisSession& Session;
+	FAdvancedControlFlowTraceProvider& Provider;
+};
+
+// Adds FAdvancedControlFlowTraceAnalyzer and FAdvancedControlFlowTraceProvider to each analysis session.
+class FAdvancedControlFlowTraceModule : public TraceServices::IModule
+{
+public:
+	virtual void GetModuleInfo(TraceServices::FModuleInfo& OutModuleInfo) override;
+	virtual void OnAnalysisBegin(TraceServices::IAnalysisSession& Session) override;
+	virtual void GetLoggers(TArray<const TCHAR*>& OutLoggers) override;
+};
+
+#endif
@@ -0,0 +1,78 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "AdvancedControlFlowInsightsModule.h"
+
+#if ACF_WITH_INSIGHTS
+
+#include "CoreMinimal.h"
+#include "TraceServices/Model/AnalysisSession.h"
+
+struct FAdvancedControlFlowTracedCase
+{
+	double StartTime;
+	double EndTime;
+	uint32 NodeId;
+	// INDEX_NONE for the default.
+	int32 CaseIndex;
+};
+
+struct FAdvancedControlFlowTracedNode
+{
+	FString NodeGuid;
+	int32 BlueprintIndex;
+	// Lane of the node in the track of the Blueprint.
+	int32 Lane;
+};
+
+// Cases taken by the nodes (AdvancedControlFlow.CaseTaken), which are grouped by the Blueprint owning the node.
+// The session must be locked for read / edit while this is accessed.
+class FAdvancedControlFlowTraceProvider : public TraceServices::IProvider
+{
+public:
+	static const FName ProviderName;
+
+	explicit FAdvancedControlFlowTraceProvider(TraceServices::IAnalysisSession& InSession);
+
+	void AddNode(uint32 NodeId, const FString& BlueprintPath, const FString& NodeGuid);
+	// The cases must be added in the order of the end time. The cases of the unknown nodes are ignored.
+	void AddCase(uint32 NodeId, int32 CaseIndex, double StartTime, double EndTime);
+
+	int32 GetBlueprintCount() const;
+	const FString& GetBlueprintPath(int32 BlueprintIndex) const;
+	int32 GetNodeCount(int32 BlueprintIndex) const;
+	const FAdvancedControlFlowTracedNode* FindNode(uint32 NodeId) const;
+
+	// Call Callback for each case of the Blueprint which overlaps [StartTime, EndTime].
+	void EnumerateCases(int32 BlueprintIndex, double StartTime, double EndTime,
+		TFunctionRef<void(const FAdvancedControlFlowTracedCase&, const FAdvancedControlFlowTracedNode&)> Callback) const;
+
+	// Return the display name of the case ("Case 0", ..., "Default"), which lives as long as the session.
+	const TCHAR* GetCaseName(int32 CaseIndex) const;
+
+private:
+	struct FBlueprint
+	{
+		FString BlueprintPath;
+		int32 NodeCount = 0;
+		TArray<FAdvancedControlFlowTracedCase> Cases;
+		// To find the cases which start before the range.
+		double MaxDuration = 0.0;
+	};
+
+	TraceServices::IAnalysisSession& Session;
+	TMap<uint32, FAdvancedControlFlowTracedNode> Nodes;
+	TMap<FString, int32> BlueprintIndices;
+	TArray<FBlueprint> Blueprints;
+	TMap<int32, const TCHAR*> CaseNames;
+};
+
+#endif
@@ -0,0 +1,30 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+using UnrealBuildTool;
+
+public class AdvancedControlFlowRuntime : ModuleRules
+{
+	public AdvancedControlFlowRuntime(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[]{
+			"Core",
+			"CoreUObject",
+			"Engine",
+		});
+
+		// Multi-Branch on Change binds to the field notifications.
+		if ((Target.Version.MajorVersion > 5) || ((Target.Version.MajorVersion == 5) && (Target.Version.MinorVersion >= 1)))
+		{
+			PublicDependencyModuleNames.Add("FieldNotification");
+		}
+	}
+}
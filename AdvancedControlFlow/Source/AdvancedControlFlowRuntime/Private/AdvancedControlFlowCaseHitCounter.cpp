@@ -0,0 +1,119 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowCaseHitCounter.h"
+
+#if ACF_WITH_CASE_HIT_COUNTERS
+
+#include "AdvancedControlFlowRuntimeModule.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+static FAutoConsoleCommand ExportCaseHitsCommand(TEXT("acf.CaseHits.Export"),
+	TEXT("Export the case hit counts to CSV. Usage: acf.CaseHits.Export [FilePath]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) {
+		const FString FilePath = (Args.Num() > 0)
+									 ? Args[0]
+									 : FPaths::Combine(FPaths::ProfilingDir(), TEXT("AdvancedControlFlow"), TEXT("CaseHits.csv"));
+		if (FAdvancedControlFlowCaseHitCounter::Get().ExportToCSV(FilePath))
+		{
+			UE_LOG(LogAdvancedControlFlow, Display, TEXT("Case hit counts are exported to %s"), *FilePath);
+		}
+		else
+		{
+			UE_LOG(LogAdvancedControlFlow, Error, TEXT("Failed to export the case hit counts to %s"), *FilePath);
+		}
+	}));
+
+static FAutoConsoleCommand ResetCaseHitsCommand(TEXT("acf.CaseHits.Reset"), TEXT("Reset the case hit counts."),
+	FConsoleCommandDelegate::CreateLambda([]() { FAdvancedControlFlowCaseHitCounter::Get().Reset(); }));
+
+FAdvancedControlFlowCaseHitCounter& FAdvancedControlFlowCaseHitCounter::Get()
+{
+	static FAdvancedControlFlowCaseHitCounter Instance;
+	return Instance;
+}
+
+void FAdvancedControlFlowCaseHitCounter::RecordHit(FName NodeKey, int32 CaseIndex, int32 EvaluatedConditionCount)
+{
+	if (CaseIndex < INDEX_NONE)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&CriticalSection);
+
+	TArray<FAdvancedControlFlowCaseHit>& Hits = NodeHits.FindOrAdd(NodeKey);
+	const int32 HitIndex = CaseIndex + 1;
+	if (!Hits.IsValidIndex(HitIndex))
+	{
+		Hits.SetNum(HitIndex + 1);
+	}
+	Hits[HitIndex].HitCount++;
+	Hits[HitIndex].EvaluatedConditionCount += EvaluatedConditionCount;
+}
+
+bool FAdvancedControlFlowCaseHitCounter::GetHits(FName NodeKey, TArray<FAdvancedControlFlowCaseHit>& OutHits) const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	const TArray<FAdvancedControlFlowCaseHit>* Hits = NodeHits.Find(NodeKey);
+	if (Hits == nullptr)
+	{
+		return false;
+	}
+
+	OutHits = *Hits;
+
+	return true;
+}
+
+bool FAdvancedControlFlowCaseHitCounter::HasAnyHits() const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	return NodeHits.Num() > 0;
+}
+
+void FAdvancedControlFlowCaseHitCounter::Reset()
+{
+	FScopeLock Lock(&CriticalSection);
+
+	NodeHits.Reset();
+}
+
+bool FAdvancedControlFlowCaseHitCounter::ExportToCSV(const FString& FilePath) const
+{
+	FString CSV = TEXT("Node,Case,Hits,AverageEvaluatedConditions\n");
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		for (const TPair<FName, TArray<FAdvancedControlFlowCaseHit>>& Pair : NodeHits)
+		{
+			for (int32 HitIndex = 0; HitIndex < Pair.Value.Num(); ++HitIndex)
+			{
+				const FAdvancedControlFlowCaseHit& Hit = Pair.Value[HitIndex];
+				if (Hit.HitCount == 0)
+				{
+					continue;
+				}
+
+				const FString CaseName = (HitIndex == 0) ? TEXT("Default") : FString::FromInt(HitIndex - 1);
+				CSV += FString::Printf(TEXT("\"%s\",%s,%lld,%.3f\n"), *Pair.Key.ToString(), *CaseName, Hit.HitCount,
+					static_cast<double>(Hit.EvaluatedConditionCount) / Hit.HitCount);
+			}
+		}
+	}
+
+	return FFileHelper::SaveStringToFile(CSV, *FilePath);
+}
+
+#endif
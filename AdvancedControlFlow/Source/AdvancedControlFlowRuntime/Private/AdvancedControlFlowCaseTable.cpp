@@ -0,0 +1,32 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowCaseTable.h"
+
+int32 UAdvancedControlFlowCaseTable::FindNameCase(FName Key) const
+{
+	const int32* CaseIndex = NameCases.Find(Key);
+	return (CaseIndex != nullptr) ? *CaseIndex : -1;
+}
+
+int32 UAdvancedControlFlowCaseTable::FindStringCase(const FString& Key) const
+{
+	const int32* CaseIndex = StringCases.Find(Key);
+	return (CaseIndex != nullptr) ? *CaseIndex : -1;
+}
+
+void UAdvancedControlFlowCaseTable::AddNameCase(FName Key, int32 CaseIndex)
+{
+	NameCases.Add(Key, CaseIndex);
+}
+
+void UAdvancedControlFlowCaseTable::AddStringCase(const FString& Key, int32 CaseIndex)
+{
+	StringCases.Add(Key, CaseIndex);
+}
@@ -0,0 +1,248 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowLibrary.h"
+
+#include "AdvancedControlFlowCaseHitCounter.h"
+#include "AdvancedControlFlowRuntimeModule.h"
+#include "AdvancedControlFlowTrace.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+#if ACF_WITH_FIELD_NOTIFICATION
+#include "INotifyFieldValueChanged.h"
+#endif
+
+static TAutoConsoleVariable<bool> CVarParallelConditionalSequence(TEXT("acf.ParallelConditionalSequence"), true,
+	TEXT("If false, Parallel Conditional Sequence nodes call all functions on the calling thread in the case order."));
+
+// Dst[i] = Conditions[i] ? Src[i] : Dst[i]
+// The loop has no branch, so the compiler vectorizes it to the masked blend for the numeric element types.
+template <typename T>
+static void BlendArrayElements(T* Dst, const bool* Conditions, const T* Src, int32 Count)
+{
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		Dst[Index] = Conditions[Index] ? Src[Index] : Dst[Index];
+	}
+}
+
+template <typename T>
+static bool TryBlendArrayElements(uint8* Dst, const bool* Conditions, const uint8* Src, int32 Count)
+{
+	if (!IsAligned(Dst, alignof(T)) || !IsAligned(Src, alignof(T)))
+	{
+		return false;
+	}
+
+	BlendArrayElements(reinterpret_cast<T*>(Dst), Conditions, reinterpret_cast<const T*>(Src), Count);
+	return true;
+}
+
+int32 UAdvancedControlFlowLibrary::FindLowestSetBit(int32 Bits, int32 Mask)
+{
+	const uint32 MaskedBits = static_cast<uint32>(Bits & Mask);
+	return (MaskedBits != 0) ? static_cast<int32>(FMath::CountTrailingZeros(MaskedBits)) : INDEX_NONE;
+}
+
+int32 UAdvancedControlFlowLibrary::FindLowestSetBit64(int64 Bits, int64 Mask)
+{
+	const uint64 MaskedBits = static_cast<uint64>(Bits & Mask);
+	return (MaskedBits != 0) ? static_cast<int32>(FMath::CountTrailingZeros64(MaskedBits)) : INDEX_NONE;
+}
+
+void UAdvancedControlFlowLibrary::RecordCaseHit(FName NodeKey, int32 CaseIndex, int32 EvaluatedConditionCount)
+{
+#if ACF_WITH_CASE_HIT_COUNTERS
+	FAdvancedControlFlowCaseHitCounter::Get().RecordHit(NodeKey, CaseIndex, EvaluatedConditionCount);
+#endif
+}
+
+int64 UAdvancedControlFlowLibrary::BeginTraceCase()
+{
+#if ACF_WITH_TRACE
+	return static_cast<int64>(FAdvancedControlFlowTrace::BeginCase());
+#else
+	return 0;
+#endif
+}
+
+int64 UAdvancedControlFlowLibrary::TraceCaseTaken(FName NodeKey, int32 CaseIndex, int64 StartCycle)
+{
+#if ACF_WITH_TRACE
+	FAdvancedControlFlowTrace::OutputCaseTaken(NodeKey, CaseIndex, static_cast<uint64>(StartCycle));
+#endif
+	return 0;
+}
+
+void UAdvancedControlFlowLibrary::CallFunctionsInParallel(UObject* Target, const TArray<bool>& Conditions,
+	const TArray<FName>& FunctionNames, const TArray<UClass*>& ThreadSafeClasses)
+{
+	if (Target == nullptr)
+	{
+		return;
+	}
+
+	const bool bParallel = CVarParallelConditionalSequence.GetValueOnAnyThread();
+	TArray<UFunction*, TInlineAllocator<16>> ParallelFunctions;
+	TArray<UFunction*, TInlineAllocator<16>> SerialFunctions;
+	const int32 CaseCount = FMath::Min(Conditions.Num(), FunctionNames.Num());
+	for (int32 Index = 0; Index < CaseCount; ++Index)
+	{
+		if (!Conditions[Index])
+		{
+			continue;
+		}
+
+		// The functions are validated on compile, but the target may be a different class on runtime (ex. hot reload), and the
+		// derived class may override the function with the one which is not validated.
+		UFunction* Function = Target->FindFunction(FunctionNames[Index]);
+		if (Function == nullptr)
+		{
+			UE_LOG(LogAdvancedControlFlow, Warning, TEXT("%s does not have the case function %s"), *Target->GetName(),
+				*FunctionNames[Index].ToString());
+			continue;
+		}
+		if (Function->ParmsSize > 0)
+		{
+			UE_LOG(LogAdvancedControlFlow, Warning, TEXT("Case function %s of %s is skipped because it has parameters"),
+				*Function->GetName(), *Target->GetName());
+			continue;
+		}
+
+		const bool bThreadSafe = ThreadSafeClasses.IsValidIndex(Index) && (ThreadSafeClasses[Index] != nullptr) &&
+								 (Function->GetOwnerClass() == ThreadSafeClasses[Index]);
+		((bThreadSafe && bParallel) ? ParallelFunctions : SerialFunctions).Add(Function);
+	}
+
+	// The calling thread also runs the functions, and ParallelFor returns after all of them finish.
+	if (ParallelFunctions.Num() > 0)
+	{
+		ParallelFor(ParallelFunctions.Num(), [Target, &ParallelFunctions](int32 Index) {
+			Target->ProcessEvent(ParallelFunctions[Index], nullptr);
+		});
+	}
+
+	for (UFunction* Function : SerialFunctions)
+	{
+		Target->ProcessEvent(Function, nullptr);
+	}
+}
+
+bool UAdvancedControlFlowLibrary::BindFieldValueChanged(
+	UObject* Source, const TArray<FName>& FieldNames, FAdvancedControlFlowFieldValueChangedDelegate Delegate)
+{
+#if ACF_WITH_FIELD_NOTIFICATION
+	INotifyFieldValueChanged* Notifier = Cast<INotifyFieldValueChanged>(Source);
+	UObject* Listener = Delegate.GetUObject();
+	if ((Notifier == nullptr) || (Listener == nullptr))
+	{
+		UE_LOG(LogAdvancedControlFlow, Warning, TEXT("%s does not notify the field value changes"), *GetNameSafe(Source));
+		return false;
+	}
+
+	// The weak lambda is not executed after the listener is destroyed, so the binding is not removed explicitly.
+	const UE::FieldNotification::IClassDescriptor& Descriptor = Notifier->GetFieldNotificationDescriptor();
+	const INotifyFieldValueChanged::FFieldValueChangedDelegate FieldDelegate =
+		INotifyFieldValueChanged::FFieldValueChangedDelegate::CreateWeakLambda(
+			Listener, [Delegate](UObject* Object, UE::FieldNotification::FFieldId FieldId) { Delegate.ExecuteIfBound(); });
+	bool bBoundAll = true;
+	for (const FName& FieldName : FieldNames)
+	{
+		const UE::FieldNotification::FFieldId FieldId = Descriptor.GetField(Source->GetClass(), FieldName);
+		if (!FieldId.IsValid())
+		{
+			UE_LOG(LogAdvancedControlFlow, Warning, TEXT("%s does not have the field notification %s"), *Source->GetName(),
+				*FieldName.ToString());
+			bBoundAll = false;
+			continue;
+		}
+
+		Notifier->AddFieldValueChangedDelegate(FieldId, FieldDelegate);
+	}
+
+	return bBoundAll;
+#else
+	return false;
+#endif
+}
+
+void UAdvancedControlFlowLibrary::SelectArrayElements(
+	TArray<int32>& Result, const TArray<bool>& Conditions, const TArray<int32>& Options)
+{
+	// We should never hit this. Stubs to avoid NoExport on the class.
+	check(0);
+}
+
+void UAdvancedControlFlowLibrary::GenericSelectArrayElements(void* ResultArray, const FArrayProperty* ResultProperty,
+	const TArray<bool>& Conditions, const void* OptionArray, const FArrayProperty* OptionProperty)
+{
+	if ((ResultArray == nullptr) || (OptionArray == nullptr) || !ResultProperty->Inner->SameType(OptionProperty->Inner))
+	{
+		return;
+	}
+
+	FScriptArrayHelper ResultHelper(ResultProperty, ResultArray);
+	FScriptArrayHelper OptionHelper(OptionProperty, OptionArray);
+	const int32 Count = FMath::Min3(ResultHelper.Num(), OptionHelper.Num(), Conditions.Num());
+	if (Count == 0)
+	{
+		return;
+	}
+
+	const FProperty* InnerProperty = ResultProperty->Inner;
+	const int32 ElementSize = InnerProperty->ElementSize;
+	uint8* Dst = ResultHelper.GetRawPtr(0);
+	const uint8* Src = OptionHelper.GetRawPtr(0);
+	const bool* ConditionData = Conditions.GetData();
+
+	// The elements which do not own memory (ex. numbers, vectors) are copied as the raw bytes.
+	if (InnerProperty->HasAnyPropertyFlags(CPF_IsPlainOldData))
+	{
+		bool bBlended = false;
+		switch (ElementSize)
+		{
+			case 1:
+				bBlended = TryBlendArrayElements<uint8>(Dst, ConditionData, Src, Count);
+				break;
+			case 2:
+				bBlended = TryBlendArrayElements<uint16>(Dst, ConditionData, Src, Count);
+				break;
+			case 4:
+				bBlended = TryBlendArrayElements<uint32>(Dst, ConditionData, Src, Count);
+				break;
+			case 8:
+				bBlended = TryBlendArrayElements<uint64>(Dst, ConditionData, Src, Count);
+				break;
+			default:
+				break;
+		}
+		if (bBlended)
+		{
+			return;
+		}
+
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			if (ConditionData[Index])
+			{
+				FMemory::Memcpy(Dst + Index * ElementSize, Src + Index * ElementSize, ElementSize);
+			}
+		}
+		return;
+	}
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		if (ConditionData[Index])
+		{
+			InnerProperty->CopySingleValue(Dst + Index * ElementSize, Src + Index * ElementSize);
+		}
+	}
+}
@@ -0,0 +1,27 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowRuntimeModule.h"
+
+DEFINE_LOG_CATEGORY(LogAdvancedControlFlow);
+
+void FAdvancedControlFlowRuntimeModule::StartupModule()
+{
+}
+
+void FAdvancedControlFlowRuntimeModule::ShutdownModule()
+{
+}
+
+bool FAdvancedControlFlowRuntimeModule::SupportsDynamicReloading()
+{
+	return true;
+}
+
+IMPLEMENT_MODULE(FAdvancedControlFlowRuntimeModule, AdvancedControlFlowRuntime);
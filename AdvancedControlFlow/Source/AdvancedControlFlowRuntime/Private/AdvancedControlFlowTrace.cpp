@@ -0,0 +1,93 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowTrace.h"
+
+#if ACF_WITH_TRACE
+
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeRWLock.h"
+
+UE_TRACE_CHANNEL_DEFINE(AdvancedControlFlowChannel)
+
+// NodeSpec is important, so that it is sent to the analysis which connects after the node is traced first.
+UE_TRACE_EVENT_BEGIN(AdvancedControlFlow, NodeSpec, NoSync | Important)
+	UE_TRACE_EVENT_FIELD(uint32, NodeId)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, BlueprintPath)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, NodeGuid)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(AdvancedControlFlow, CaseTaken)
+	UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+	UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+	UE_TRACE_EVENT_FIELD(uint32, NodeId)
+	UE_TRACE_EVENT_FIELD(int32, CaseIndex)
+UE_TRACE_EVENT_END()
+
+bool FAdvancedControlFlowTrace::IsEnabled()
+{
+	return UE_TRACE_CHANNELEXPR_IS_ENABLED(AdvancedControlFlowChannel);
+}
+
+uint64 FAdvancedControlFlowTrace::BeginCase()
+{
+	return IsEnabled() ? FPlatformTime::Cycles64() : 0;
+}
+
+void FAdvancedControlFlowTrace::OutputCaseTaken(const FName& NodeKey, int32 CaseIndex, uint64 StartCycle)
+{
+	if ((StartCycle == 0) || !IsEnabled())
+	{
+		return;
+	}
+
+	const uint64 EndCycle = FPlatformTime::Cycles64();
+	const uint32 NodeId = GetNodeId(NodeKey);
+
+	UE_TRACE_LOG(AdvancedControlFlow, CaseTaken, AdvancedControlFlowChannel)
+		<< CaseTaken.StartCycle(StartCycle) << CaseTaken.EndCycle(EndCycle) << CaseTaken.NodeId(NodeId)
+		<< CaseTaken.CaseIndex(CaseIndex);
+}
+
+uint32 FAdvancedControlFlowTrace::GetNodeId(const FName& NodeKey)
+{
+	static FRWLock Lock;
+	static TMap<FName, uint32> NodeIds;
+
+	{
+		FReadScopeLock ReadLock(Lock);
+		if (const uint32* NodeId = NodeIds.Find(NodeKey))
+		{
+			return *NodeId;
+		}
+	}
+
+	FWriteScopeLock WriteLock(Lock);
+	if (const uint32* NodeId = NodeIds.Find(NodeKey))
+	{
+		return *NodeId;
+	}
+	const uint32 NodeId = NodeIds.Num() + 1;
+	NodeIds.Add(NodeKey, NodeId);
+
+	// The key is "<Blueprint path>:<Node GUID>", and the Blueprint path can also have ':' (ex. Level Blueprint).
+	const FString Key = NodeKey.ToString();
+	int32 SeparatorIndex = INDEX_NONE;
+	Key.FindLastChar(TEXT(':'), SeparatorIndex);
+	const FString BlueprintPath = (SeparatorIndex != INDEX_NONE) ? Key.Left(SeparatorIndex) : Key;
+	const FString NodeGuid = (SeparatorIndex != INDEX_NONE) ? Key.Mid(SeparatorIndex + 1) : FString();
+
+	UE_TRACE_LOG(AdvancedControlFlow, NodeSpec, AdvancedControlFlowChannel, (BlueprintPath.Len() + NodeGuid.Len()) * sizeof(TCHAR))
+		<< NodeSpec.NodeId(NodeId) << NodeSpec.BlueprintPath(*BlueprintPath, BlueprintPath.Len())
+		<< NodeSpec.NodeGuid(*NodeGuid, NodeGuid.Len());
+
+	return NodeId;
+}
+
+#endif
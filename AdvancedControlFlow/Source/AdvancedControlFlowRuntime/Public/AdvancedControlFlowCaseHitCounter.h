@@ -0,0 +1,52 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// The case hit counters are compiled out on Shipping build.
+#define ACF_WITH_CASE_HIT_COUNTERS (!UE_BUILD_SHIPPING)
+
+#if ACF_WITH_CASE_HIT_COUNTERS
+
+struct FAdvancedControlFlowCaseHit
+{
+	// Number of times the case was taken.
+	int64 HitCount = 0;
+	// Total number of the conditions evaluated until the case was taken.
+	int64 EvaluatedConditionCount = 0;
+};
+
+// Per-node and per-case hit counts recorded by the instrumented nodes (see acf.RecordCaseHits).
+// The nodes are identified by the key made from the Blueprint path and the node GUID.
+class ADVANCEDCONTROLFLOWRUNTIME_API FAdvancedControlFlowCaseHitCounter
+{
+public:
+	static FAdvancedControlFlowCaseHitCounter& Get();
+
+	// CaseIndex is INDEX_NONE for the default.
+	void RecordHit(FName NodeKey, int32 CaseIndex, int32 EvaluatedConditionCount);
+
+	// OutHits[0] is the default, and OutHits[1 + i] is the case i.
+	// Return false if the node has never been recorded.
+	bool GetHits(FName NodeKey, TArray<FAdvancedControlFlowCaseHit>& OutHits) const;
+
+	bool HasAnyHits() const;
+	void Reset();
+
+	// Columns: Node, Case, Hits, AverageEvaluatedConditions
+	bool ExportToCSV(const FString& FilePath) const;
+
+private:
+	mutable FCriticalSection CriticalSection;
+	TMap<FName, TArray<FAdvancedControlFlowCaseHit>> NodeHits;
+};
+
+#endif
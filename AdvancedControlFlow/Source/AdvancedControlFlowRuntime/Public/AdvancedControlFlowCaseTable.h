@@ -0,0 +1,43 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+
+#include "AdvancedControlFlowCaseTable.generated.h"
+
+// Hash table from the case keys to the case indices of Multi-Branch on Name.
+// The table is built on compile and saved as the subobject of the generated class, so the lookup does not compare the keys
+// one by one on runtime. The keys are compared ignoring case, same as the == nodes of name and string.
+UCLASS()
+class ADVANCEDCONTROLFLOWRUNTIME_API UAdvancedControlFlowCaseTable : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// Return the case index of the key, or -1 if no case has the key.
+	// These are called only from Multi-Branch on Name node.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	int32 FindNameCase(FName Key) const;
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	int32 FindStringCase(const FString& Key) const;
+
+	void AddNameCase(FName Key, int32 CaseIndex);
+	void AddStringCase(const FString& Key, int32 CaseIndex);
+
+private:
+	UPROPERTY()
+	TMap<FName, int32> NameCases;
+
+	UPROPERTY()
+	TMap<FString, int32> StringCases;
+};
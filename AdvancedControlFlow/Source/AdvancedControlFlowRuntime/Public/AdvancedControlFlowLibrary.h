@@ -0,0 +1,112 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Misc/EngineVersionComparison.h"
+
+#include "AdvancedControlFlowLibrary.generated.h"
+
+// Multi-Branch on Change binds to the field notifications (INotifyFieldValueChanged), which are available on UE 5.1 or later.
+#define ACF_WITH_FIELD_NOTIFICATION !UE_VERSION_OLDER_THAN(5, 1, 0)
+
+DECLARE_DYNAMIC_DELEGATE(FAdvancedControlFlowFieldValueChangedDelegate);
+
+// Native helpers which the nodes of this plugin can be compiled down to.
+// Except for CallFunctionsInParallel and BindFieldValueChanged, they do not allocate any memory, so they are cheap to call from any
+// Blueprint. (SelectArrayElements allocates only if the copied elements own memory, ex. strings, and RecordCaseHit only on the
+// first hit of the case.)
+UCLASS()
+class ADVANCEDCONTROLFLOWRUNTIME_API UAdvancedControlFlowLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Return the index of the lowest bit which is set in both the bits and the mask, or -1 if there is no such bit.
+	UFUNCTION(BlueprintPure, Category = "Utilities|Advanced Control Flow", meta = (BlueprintThreadSafe))
+	static int32 FindLowestSetBit(int32 Bits, int32 Mask);
+
+	// Same as FindLowestSetBit, but for 64-bit value.
+	UFUNCTION(BlueprintPure, Category = "Utilities|Advanced Control Flow", meta = (BlueprintThreadSafe))
+	static int32 FindLowestSetBit64(int64 Bits, int64 Mask);
+
+	// Record the case hit to FAdvancedControlFlowCaseHitCounter.
+	// This is called only from the instrumented nodes, and does nothing on Shipping build.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static void RecordCaseHit(FName NodeKey, int32 CaseIndex, int32 EvaluatedConditionCount);
+
+	// Return the start of the traced case, or 0 if AdvancedControlFlowChannel is disabled.
+	// This is called only from the instrumented nodes (see acf.TraceCases), and returns 0 on Shipping build.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static int64 BeginTraceCase();
+
+	// Trace the case of the node from StartCycle returned by BeginTraceCase, and return 0 to clear StartCycle.
+	// Nothing is traced if StartCycle is 0.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static int64 TraceCaseTaken(FName NodeKey, int32 CaseIndex, int64 StartCycle);
+
+	// Call the functions of the target whose conditions are true, and return after all of them finish.
+	// ThreadSafeClasses[i] is the class which defines the function validated as thread safe on compile, or null.
+	// The validated functions run in parallel on the worker threads, and the others (including the overrides of the validated
+	// functions) run on the calling thread in the case order after them. This is called only from Parallel Conditional Sequence
+	// node.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static void CallFunctionsInParallel(UObject* Target, const TArray<bool>& Conditions, const TArray<FName>& FunctionNames,
+		const TArray<UClass*>& ThreadSafeClasses);
+
+	// Execute the delegate whenever any of the fields of the source is changed, and return true if all fields are bound.
+	// The source must implement INotifyFieldValueChanged (ex. widgets, viewmodels), and the binding is removed when the object of
+	// the delegate is destroyed. This is called only from Multi-Branch on Change node, and returns false before UE 5.1.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static bool BindFieldValueChanged(
+		UObject* Source, const TArray<FName>& FieldNames, FAdvancedControlFlowFieldValueChangedDelegate Delegate);
+
+	// Copy Options[i] to Result[i] for each element whose condition is true.
+	// The elements beyond the length of the conditions or the options are not changed, so the length of the result is kept.
+	// This is called only from Multi-Conditional Select node on element-wise mode.
+	UFUNCTION(BlueprintCallable, CustomThunk,
+		meta = (BlueprintInternalUseOnly = "true", ArrayParm = "Result,Options", ArrayTypeDependentParams = "Options"))
+	static void SelectArrayElements(TArray<int32>& Result, const TArray<bool>& Conditions, const TArray<int32>& Options);
+
+	static void GenericSelectArrayElements(void* ResultArray, const FArrayProperty* ResultProperty, const TArray<bool>& Conditions,
+		const void* OptionArray, const FArrayProperty* OptionProperty);
+
+	DECLARE_FUNCTION(execSelectArrayElements)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* ResultAddr = Stack.MostRecentPropertyAddress;
+		FArrayProperty* ResultProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (ResultProperty == nullptr)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_GET_TARRAY_REF(bool, Conditions);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		const void* OptionAddr = Stack.MostRecentPropertyAddress;
+		FArrayProperty* OptionProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (OptionProperty == nullptr)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		GenericSelectArrayElements(ResultAddr, ResultProperty, Conditions, OptionAddr, OptionProperty);
+		P_NATIVE_END;
+	}
+};
@@ -0,0 +1,23 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Logging/LogMacros.h"
+#include "Modules/ModuleManager.h"
+
+ADVANCEDCONTROLFLOWRUNTIME_API DECLARE_LOG_CATEGORY_EXTERN(LogAdvancedControlFlow, Log, All);
+
+class FAdvancedControlFlowRuntimeModule : public IModuleInterface
+{
+public:
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+	virtual bool SupportsDynamicReloading() override;
+};
@@ -0,0 +1,46 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Trace/Trace.h"
+
+// The trace events are compiled out on Shipping build.
+// UE 4 has the trace API in the other namespace (ex. Trace::WideString), so the events are not traced on UE 4.
+#define ACF_WITH_TRACE (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING && !UE_VERSION_OLDER_THAN(5, 0, 0))
+
+#if ACF_WITH_TRACE
+
+// Enabled by "-trace=AdvancedControlFlow" or "Trace.Enable AdvancedControlFlow".
+UE_TRACE_CHANNEL_EXTERN(AdvancedControlFlowChannel, ADVANCEDCONTROLFLOWRUNTIME_API);
+
+// Trace events of the cases taken by the instrumented nodes (see acf.TraceCases).
+//   AdvancedControlFlow.NodeSpec:  NodeId, BlueprintPath, NodeGuid (once per node)
+//   AdvancedControlFlow.CaseTaken: StartCycle, EndCycle, NodeId, CaseIndex
+// CaseIndex is INDEX_NONE for the default.
+class ADVANCEDCONTROLFLOWRUNTIME_API FAdvancedControlFlowTrace
+{
+public:
+	static bool IsEnabled();
+
+	// Return the current cycle, or 0 if the channel is disabled.
+	static uint64 BeginCase();
+
+	// Trace the case from StartCycle to now. NodeKey is made by GetCaseHitCounterKey.
+	// Nothing is traced if StartCycle is 0 (ex. the channel was disabled on BeginCase).
+	static void OutputCaseTaken(const FName& NodeKey, int32 CaseIndex, uint64 StartCycle);
+
+private:
+	// Return the ID of the node, which is traced with NodeSpec event on the first call.
+	static uint32 GetNodeId(const FName& NodeKey);
+};
+
+#endif
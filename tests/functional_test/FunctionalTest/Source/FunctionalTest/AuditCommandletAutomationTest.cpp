@@ -0,0 +1,138 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+
+#include "AdvancedControlFlowAuditCommandlet.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "K2Node_MultiBranchOnValue.h"
+#include "TestBlueprintBuilder.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestAuditCommandlet, "AdvancedControlFlow.FunctionalTest.AuditCommandlet",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FFunctionalTestAuditCommandlet::RunTest(const FString& Parameters)
+{
+	const FEdGraphPinType BoolPinType = MakeTestPinType(UEdGraphSchema_K2::PC_Boolean);
+	const FEdGraphPinType IntPinType = MakeTestPinType(UEdGraphSchema_K2::PC_Int);
+
+	// Multi-Branch with the literal conditions.
+	{
+		const TArray<FString> Conditions = {TEXT(""), TEXT("true"), TEXT("false"), TEXT("")};
+
+		TArray<FTestMemberVariable> Members = MakeCaseMemberVariables(Conditions.Num(), GetConditionVariableName, BoolPinType);
+		Members.Add({ResultVariableName, IntPinType});
+		UBlueprint* Blueprint = CreateTestBlueprintWithMembers(TEXT("BP_AuditMultiBranch"), Members);
+
+		FTestFunctionGraph Function = AddTestFunctionGraph(Blueprint, TEXT("Test_AuditMultiBranch"));
+		if (!TestTrue(TEXT("Multi-Branch graph should be built"),
+				(Function.Entry != nullptr) &&
+					BuildLiteralConditionFunctionGraph(Blueprint, Function, ETestNodeType::MultiBranch, Conditions)))
+		{
+			return false;
+		}
+
+		TArray<FAdvancedControlFlowAuditEntry> Entries;
+		UAdvancedControlFlowAuditCommandlet::AuditBlueprint(Blueprint, Entries);
+		if (!TestEqual(TEXT("Multi-Branch should be reported"), Entries.Num(), 1))
+		{
+			return false;
+		}
+		TestEqual(TEXT("Multi-Branch case count"), Entries[0].CaseCount, Conditions.Num());
+		TestEqual(TEXT("Multi-Branch unconnected conditions"), Entries[0].UnconnectedConditionCount, 2);
+		TestEqual(TEXT("Multi-Branch always true conditions"), Entries[0].AlwaysTrueConditionCount, 1);
+		TestEqual(TEXT("Multi-Branch always false conditions"), Entries[0].AlwaysFalseConditionCount, 1);
+		TestTrue(TEXT("Multi-Branch bytecode should be counted"), Entries[0].BytecodeSize > 0);
+	}
+
+	// Conditional Sequence whose later conditions are evaluated by the intermediate Branch nodes.
+	for (const bool bSnapshotConditions : {false, true})
+	{
+		const int32 CaseCount = 3;
+
+		UBlueprint* Blueprint = CreateTestBlueprintWithMembers(
+			FString::Printf(TEXT("BP_AuditConditionalSequence_%s"), bSnapshotConditions ? TEXT("Snapshot") : TEXT("Lazy")),
+			{{ResultVariableName, IntPinType}});
+
+		FTestFunctionGraph Function = AddTestFunctionGraph(Blueprint, TEXT("Test_AuditConditionalSequence"));
+		if (!TestTrue(TEXT("Conditional Sequence graph should be built"),
+				(Function.Entry != nullptr) &&
+					BuildConditionalSequenceSnapshotFunctionGraph(Blueprint, Function, CaseCount, bSnapshotConditions)))
+		{
+			return false;
+		}
+
+		TArray<FAdvancedControlFlowAuditEntry> Entries;
+		UAdvancedControlFlowAuditCommandlet::AuditBlueprint(Blueprint, Entries);
+		if (!TestEqual(TEXT("Conditional Sequence should be reported"), Entries.Num(), 1))
+		{
+			return false;
+		}
+		TestEqual(TEXT("Conditional Sequence unconnected conditions"), Entries[0].UnconnectedConditionCount, 0);
+		TestEqual(TEXT("Conditional Sequence intermediate nodes"), Entries[0].IntermediateNodeCount,
+			bSnapshotConditions ? 0 : CaseCount - 1);
+		TestTrue(TEXT("Conditional Sequence bytecode should be counted"), Entries[0].BytecodeSize > 0);
+
+		const FString CSV = UAdvancedControlFlowAuditCommandlet::ToCSV(Entries);
+		TestTrue(TEXT("CSV should have the header"), CSV.StartsWith(TEXT("Blueprint,Graph,NodeClass,NodeGuid,CaseCount,")));
+		TestTrue(TEXT("JSON should have the node"),
+			UAdvancedControlFlowAuditCommandlet::ToJson(Entries).Contains(Entries[0].NodeGuid.ToString()));
+	}
+
+	// Parallel Conditional Sequence, which is expanded to the intermediate nodes.
+	{
+		const TArray<ETestCaseFunction> CaseFunctions = {ETestCaseFunction::ThreadSafe, ETestCaseFunction::ThreadSafe};
+
+		TArray<FTestMemberVariable> Members = MakeCaseMemberVariables(CaseFunctions.Num(), GetConditionVariableName, BoolPinType);
+		Members.Add({ResultVariableName, IntPinType});
+		UBlueprint* Blueprint = CreateTestBlueprintWithMembers(TEXT("BP_AuditParallelConditionalSequence"), Members);
+
+		FTestFunctionGraph Function = AddTestFunctionGraph(Blueprint, TEXT("Test_AuditParallelConditionalSequence"));
+		if (!TestTrue(TEXT("Parallel Conditional Sequence graph should be built"),
+				(Function.Entry != nullptr) && BuildParallelConditionalSequenceFunctionGraph(Blueprint, Function, CaseFunctions)))
+		{
+			return false;
+		}
+
+		TArray<FAdvancedControlFlowAuditEntry> Entries;
+		UAdvancedControlFlowAuditCommandlet::AuditBlueprint(Blueprint, Entries);
+		if (!TestEqual(TEXT("Parallel Conditional Sequence should be reported"), Entries.Num(), 1))
+		{
+			return false;
+		}
+		TestEqual(TEXT("Parallel Conditional Sequence case count"), Entries[0].CaseCount, CaseFunctions.Num());
+		TestEqual(TEXT("Parallel Conditional Sequence unconnected conditions"), Entries[0].UnconnectedConditionCount, 0);
+		TestTrue(TEXT("Parallel Conditional Sequence intermediate nodes should be counted"),
+			Entries[0].IntermediateNodeCount > 0);
+	}
+
+	// Multi-Branch on Value, whose literal keys are not the conditions.
+	{
+		const TArray<int32> Keys = {0, 1, 2};
+
+		UBlueprint* Blueprint = CreateTestBlueprintWithMembers(
+			TEXT("BP_AuditMultiBranchOnValue"), {{ResultVariableName, IntPinType}, {SelectionVariableName, IntPinType}});
+
+		FTestFunctionGraph Function = AddTestFunctionGraph(Blueprint, TEXT("Test_AuditMultiBranchOnValue"));
+		if (!TestTrue(TEXT("Multi-Branch on Value graph should be built"),
+				(Function.Entry != nullptr) &&
+					BuildMultiBranchOnValueFunctionGraph(Blueprint, Function, EMultiBranchOnValueCompareMode::Equal, Keys)))
+		{
+			return false;
+		}
+
+		TArray<FAdvancedControlFlowAuditEntry> Entries;
+		UAdvancedControlFlowAuditCommandlet::AuditBlueprint(Blueprint, Entries);
+		if (!TestEqual(TEXT("Multi-Branch on Value should be reported"), Entries.Num(), 1))
+		{
+			return false;
+		}
+		TestEqual(TEXT("Multi-Branch on Value case count"), Entries[0].CaseCount, Keys.Num());
+		TestEqual(TEXT("Multi-Branch on Value unconnected conditions"), Entries[0].UnconnectedConditionCount, 0);
+		TestTrue(TEXT("Multi-Branch on Value bytecode should be counted"), Entries[0].BytecodeSize > 0);
+	}
+
+	return true;
+}
+
+#endif
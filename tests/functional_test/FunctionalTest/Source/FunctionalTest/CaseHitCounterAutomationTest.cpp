@@ -0,0 +1,195 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+
+#include "AdvancedControlFlowCaseHitCounter.h"
+#include "AdvancedControlFlowCompilerUtils.h"
+#include "EdGraph/EdGraph.h"
+#include "Engine/Blueprint.h"
+#include "HAL/IConsoleManager.h"
+#include "K2Node_CasePairedPinsNode.h"
+#include "K2Node_MultiBranch.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "TestBlueprintBuilder.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestCaseHitCounter, "AdvancedControlFlow.FunctionalTest.CaseHitCounter",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestMultiBranchMutuallyExclusive,
+	"AdvancedControlFlow.FunctionalTest.MultiBranch.MutuallyExclusive",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+static UK2Node_CasePairedPinsNode* FindPluginNode(UBlueprint* Blueprint)
+{
+	for (UEdGraph* Graph : Blueprint->FunctionGraphs)
+	{
+		if (Graph->GetFName() != BenchmarkPluginFunctionName)
+		{
+			continue;
+		}
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (UK2Node_CasePairedPinsNode* CasePairedPinsNode = Cast<UK2Node_CasePairedPinsNode>(Node))
+			{
+				return CasePairedPinsNode;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+#if ACF_WITH_CASE_HIT_COUNTERS
+
+bool FFunctionalTestCaseHitCounter::RunTest(const FString& Parameters)
+{
+	IConsoleVariable* RecordCaseHits = IConsoleManager::Get().FindConsoleVariable(TEXT("acf.RecordCaseHits"));
+	if (!TestNotNull(TEXT("acf.RecordCaseHits should exist"), RecordCaseHits))
+	{
+		return false;
+	}
+	const bool bOldRecordCaseHits = RecordCaseHits->GetBool();
+	RecordCaseHits->Set(true);
+
+	FAdvancedControlFlowCaseHitCounter& Counter = FAdvancedControlFlowCaseHitCounter::Get();
+	Counter.Reset();
+
+	const int32 CaseCount = 4;
+	const int32 CallCount = 10;
+	TArray<FName> NodeKeys;
+	for (ETestNodeType NodeType :
+		{ETestNodeType::MultiBranch, ETestNodeType::ConditionalSequence, ETestNodeType::MultiConditionalSelect})
+	{
+		const FString NodeTypeName = GetTestNodeTypeName(NodeType);
+
+		// Only the last condition is true.
+		UBlueprint* Blueprint = BuildBenchmarkBlueprint(NodeType, CaseCount);
+		UK2Node_CasePairedPinsNode* Node = (Blueprint != nullptr) ? FindPluginNode(Blueprint) : nullptr;
+		UFunction* Function =
+			(Blueprint != nullptr) ? Blueprint->GeneratedClass->FindFunctionByName(BenchmarkPluginFunctionName) : nullptr;
+		if (!TestTrue(FString::Printf(TEXT("%s: Blueprint should be compiled"), *NodeTypeName),
+				(Node != nullptr) && (Function != nullptr)))
+		{
+			continue;
+		}
+
+		UObject* Object = NewObject<UObject>(GetTransientPackage(), Blueprint->GeneratedClass);
+		for (int32 Index = 0; Index < CallCount; ++Index)
+		{
+			Object->ProcessEvent(Function, nullptr);
+		}
+
+		const FName NodeKey = GetCaseHitCounterKey(Node);
+		NodeKeys.Add(NodeKey);
+
+		TArray<FAdvancedControlFlowCaseHit> Hits;
+		if (!TestTrue(FString::Printf(TEXT("%s: Hits should be recorded"), *NodeTypeName), Counter.GetHits(NodeKey, Hits)) ||
+			!TestEqual(FString::Printf(TEXT("%s: Last case should be recorded"), *NodeTypeName), Hits.Num(), CaseCount + 1))
+		{
+			continue;
+		}
+
+		for (int32 CaseIndex = 0; CaseIndex < CaseCount - 1; ++CaseIndex)
+		{
+			TestEqual(FString::Printf(TEXT("%s: Hits of case %d"), *NodeTypeName, CaseIndex), Hits[1 + CaseIndex].HitCount,
+				int64(0));
+		}
+		TestEqual(FString::Printf(TEXT("%s: Hits of last case"), *NodeTypeName), Hits[CaseCount].HitCount, int64(CallCount));
+		TestEqual(FString::Printf(TEXT("%s: Evaluated conditions of last case"), *NodeTypeName),
+			Hits[CaseCount].EvaluatedConditionCount, int64(CallCount * CaseCount));
+	}
+
+	const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AdvancedControlFlow"), TEXT("CaseHits.csv"));
+	FString CSV;
+	if (TestTrue(TEXT("Case hits should be exported"), Counter.ExportToCSV(FilePath)) &&
+		TestTrue(TEXT("Exported case hits should be loaded"), FFileHelper::LoadFileToString(CSV, *FilePath)))
+	{
+		TestTrue(TEXT("CSV should have the header"), CSV.StartsWith(TEXT("Node,Case,Hits,AverageEvaluatedConditions")));
+		for (const FName& NodeKey : NodeKeys)
+		{
+			const FString NodeKeyString = NodeKey.ToString();
+			TestTrue(FString::Printf(TEXT("CSV should have the node %s"), *NodeKeyString),
+				CSV.Contains(FString::Printf(
+					TEXT("\"%s\",%d,%d,%.3f"), *NodeKeyString, CaseCount - 1, CallCount, float(CaseCount))));
+		}
+	}
+
+	Counter.Reset();
+	RecordCaseHits->Set(bOldRecordCaseHits);
+
+	return true;
+}
+
+#else
+
+bool FFunctionalTestCaseHitCounter::RunTest(const FString& Parameters)
+{
+	return true;
+}
+
+#endif
+
+bool FFunctionalTestMultiBranchMutuallyExclusive::RunTest(const FString& Parameters)
+{
+	// Only the last condition is true.
+	const int32 CaseCount = 4;
+	UBlueprint* Blueprint = CreateBenchmarkBlueprint(ETestNodeType::MultiBranch, CaseCount);
+	UK2Node_MultiBranch* Node = (Blueprint != nullptr) ? Cast<UK2Node_MultiBranch>(FindPluginNode(Blueprint)) : nullptr;
+	if (!TestNotNull(TEXT("Multi-Branch node should be built"), Node))
+	{
+		return false;
+	}
+
+	TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+	Node->CaseHitCounts.Add(CasePairs[3].Value->PinId, 100);
+	Node->CaseHitCounts.Add(CasePairs[1].Value->PinId, 10);
+
+	TestTrue(TEXT("Cases should be tested in the pin order"), Node->GetCaseEvaluationOrder() == TArray<int32>({0, 1, 2, 3}));
+	Node->bCasesMutuallyExclusive = true;
+	TestTrue(
+		TEXT("Cases should be tested in the order of the hits"), Node->GetCaseEvaluationOrder() == TArray<int32>({3, 1, 0, 2}));
+
+	IConsoleVariable* RecordCaseHits = IConsoleManager::Get().FindConsoleVariable(TEXT("acf.RecordCaseHits"));
+	const bool bOldRecordCaseHits = (RecordCaseHits != nullptr) && RecordCaseHits->GetBool();
+	if (RecordCaseHits != nullptr)
+	{
+		RecordCaseHits->Set(true);
+	}
+#if ACF_WITH_CASE_HIT_COUNTERS
+	FAdvancedControlFlowCaseHitCounter::Get().Reset();
+#endif
+
+	bool bSucceeded = TestTrue(TEXT("Blueprint should be compiled"), CompileTestBlueprint(Blueprint));
+	if (bSucceeded)
+	{
+		UObject* Object = NewObject<UObject>(GetTransientPackage(), Blueprint->GeneratedClass);
+		UFunction* Function = Blueprint->GeneratedClass->FindFunctionByName(BenchmarkPluginFunctionName);
+		FIntProperty* ResultProperty = FindFProperty<FIntProperty>(Blueprint->GeneratedClass, ResultVariableName);
+		if (TestTrue(TEXT("Generated class should have the test members"), (Function != nullptr) && (ResultProperty != nullptr)))
+		{
+			Object->ProcessEvent(Function, nullptr);
+			TestEqual(TEXT("Last case should be taken"), ResultProperty->GetPropertyValue_InContainer(Object), CaseCount - 1);
+
+#if ACF_WITH_CASE_HIT_COUNTERS
+			// The last case is tested first.
+			TArray<FAdvancedControlFlowCaseHit> Hits;
+			if (TestTrue(TEXT("Hits should be recorded"),
+					FAdvancedControlFlowCaseHitCounter::Get().GetHits(GetCaseHitCounterKey(Node), Hits)) &&
+				TestEqual(TEXT("Last case should be recorded"), Hits.Num(), CaseCount + 1))
+			{
+				TestEqual(TEXT("Evaluated conditions of last case"), Hits[CaseCount].EvaluatedConditionCount, int64(1));
+			}
+			FAdvancedControlFlowCaseHitCounter::Get().Reset();
+#endif
+		}
+	}
+
+	if (RecordCaseHits != nullptr)
+	{
+		RecordCaseHits->Set(bOldRecordCaseHits);
+	}
+
+	return bSucceeded;
+}
+
+#endif
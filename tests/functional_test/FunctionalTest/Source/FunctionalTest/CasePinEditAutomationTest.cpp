@@ -0,0 +1,326 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+
+#include "EdGraph/EdGraph.h"
+#include "EdGraphSchema_K2.h"
+#include "Editor.h"
+#include "Editor/TransBuffer.h"
+#include "Engine/Blueprint.h"
+#include "K2Node_MultiBranch.h"
+#include "K2Node_MultiConditionalSelect.h"
+#include "K2Node_VariableGet.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "TestBlueprintBuilder.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestCasePinBatchEdit, "AdvancedControlFlow.FunctionalTest.CasePinBatchEdit",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestCasePinReconstruction, "AdvancedControlFlow.FunctionalTest.CasePinReconstruction",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestCasePinUndo, "AdvancedControlFlow.FunctionalTest.CasePinUndo",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestCasePinLayoutOnLoad, "AdvancedControlFlow.FunctionalTest.CasePinLayoutOnLoad",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+// Case pins must be named "<Prefix>_<Index>" in the order of the case index after the batch editing.
+static bool TestCasePinNames(FAutomationTestBase* AutomationTest, const UK2Node_CasePairedPinsNode* Node, int32 ExpectedCount)
+{
+	TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+	if (!AutomationTest->TestEqual(TEXT("Case pin count"), CasePairs.Num(), ExpectedCount))
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+	{
+		const FName ExpectedKeyPinName(CasePairs[0].Key->PinName, NAME_EXTERNAL_TO_INTERNAL(Index));
+		const FName ExpectedValuePinName(CasePairs[0].Value->PinName, NAME_EXTERNAL_TO_INTERNAL(Index));
+		AutomationTest->TestEqual(FString::Printf(TEXT("Case key pin name %d"), Index), CasePairs[Index].Key->PinName.ToString(),
+			ExpectedKeyPinName.ToString());
+		AutomationTest->TestEqual(FString::Printf(TEXT("Case value pin name %d"), Index),
+			CasePairs[Index].Value->PinName.ToString(), ExpectedValuePinName.ToString());
+	}
+
+	// The pins on the node are also in the order of the case index, which the node widget shows.
+	for (int32 Index = 1; Index < CasePairs.Num(); ++Index)
+	{
+		AutomationTest->TestEqual(FString::Printf(TEXT("Case key pin %d should follow the previous case"), Index),
+			Node->Pins.Find(CasePairs[Index].Key), Node->Pins.Find(CasePairs[Index - 1].Key) + 1);
+		AutomationTest->TestEqual(FString::Printf(TEXT("Case value pin %d should follow the previous case"), Index),
+			Node->Pins.Find(CasePairs[Index].Value), Node->Pins.Find(CasePairs[Index - 1].Value) + 1);
+	}
+
+	return true;
+}
+
+bool FFunctionalTestCasePinBatchEdit::RunTest(const FString& Parameters)
+{
+	UBlueprint* Blueprint = CreateTestBlueprint(TEXT("BP_CasePinBatchEdit"));
+	FTestFunctionGraph Function = AddTestFunctionGraph(Blueprint, TEXT("Test_BatchEdit"));
+	if (!TestNotNull(TEXT("Function graph should be created"), Function.Graph))
+	{
+		return false;
+	}
+
+	FGraphNodeCreator<UK2Node_MultiBranch> NodeCreator(*Function.Graph);
+	UK2Node_MultiBranch* MultiBranch = NodeCreator.CreateNode(false);
+	NodeCreator.Finalize();
+
+	MultiBranch->SetCaseCount(60);
+	if (!TestCasePinNames(this, MultiBranch, 60))
+	{
+		return false;
+	}
+
+	// Inserted pins are placed at the index, and the following pins are shifted.
+	const CasePinPair PairAt10 = MultiBranch->GetCasePinPairs()[10];
+	MultiBranch->InsertCases(10, 5);
+	TestCasePinNames(this, MultiBranch, 65);
+	TestTrue(TEXT("Following case pins should be shifted by the inserted count"), MultiBranch->GetCasePinPairs()[15] == PairAt10);
+
+	// Removed count is clamped to the number of the cases.
+	const CasePinPair PairAt20 = MultiBranch->GetCasePinPairs()[20];
+	MultiBranch->RemoveCases(0, 3);
+	MultiBranch->RemoveCases(60, 100);
+	TestCasePinNames(this, MultiBranch, 60);
+	TestTrue(TEXT("Following case pins should be shifted by the removed count"), MultiBranch->GetCasePinPairs()[17] == PairAt20);
+
+	MultiBranch->SetCaseCount(4);
+	TestCasePinNames(this, MultiBranch, 4);
+
+	// The node must be compiled with the renamed pins.
+	TestTrue(TEXT("Blueprint should be compiled"), CompileTestBlueprint(Blueprint));
+
+	return true;
+}
+
+bool FFunctionalTestCasePinReconstruction::RunTest(const FString& Parameters)
+{
+	static const int32 CaseCount = 32;
+
+	UBlueprint* Blueprint = CreateTestBlueprint(TEXT("BP_CasePinReconstruction"));
+	FEdGraphPinType IntPinType;
+	IntPinType.PinCategory = UEdGraphSchema_K2::PC_Int;
+	FBlueprintEditorUtils::AddMemberVariable(Blueprint, TEXT("DefaultValue"), IntPinType);
+	FTestFunctionGraph Function = AddTestFunctionGraph(Blueprint, TEXT("Test_Reconstruction"));
+	if (!TestNotNull(TEXT("Function graph should be created"), Function.Graph))
+	{
+		return false;
+	}
+
+	FGraphNodeCreator<UK2Node_VariableGet> VariableGetCreator(*Function.Graph);
+	UK2Node_VariableGet* VariableGet = VariableGetCreator.CreateNode(false);
+	VariableGet->VariableReference.SetSelfMember(TEXT("DefaultValue"));
+	VariableGetCreator.Finalize();
+
+	FGraphNodeCreator<UK2Node_MultiConditionalSelect> NodeCreator(*Function.Graph);
+	UK2Node_MultiConditionalSelect* MultiConditionalSelect = NodeCreator.CreateNode(false);
+	NodeCreator.Finalize();
+
+	// Wildcard pins are resolved to int by the connection.
+	MultiConditionalSelect->SetCaseCount(CaseCount);
+	const bool bConnected = GetDefault<UEdGraphSchema_K2>()->TryCreateConnection(
+		VariableGet->FindPin(TEXT("DefaultValue")), MultiConditionalSelect->GetDefaultOptionPin());
+	if (!TestTrue(TEXT("Default option pin should be connected"), bConnected))
+	{
+		return false;
+	}
+
+	TArray<CasePinPair> CasePairs = MultiConditionalSelect->GetCasePinPairs();
+	for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+	{
+		CasePairs[Index].Key->DefaultValue = FString::FromInt(Index * 10);
+		CasePairs[Index].Value->DefaultValue = (Index % 2 == 0) ? TEXT("true") : TEXT("false");
+	}
+
+	MultiConditionalSelect->ReconstructNode();
+
+	CasePairs = MultiConditionalSelect->GetCasePinPairs();
+	if (!TestEqual(TEXT("Case pin count"), CasePairs.Num(), CaseCount))
+	{
+		return false;
+	}
+	for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+	{
+		TestEqual(FString::Printf(TEXT("Option pin type %d"), Index), CasePairs[Index].Key->PinType.PinCategory.ToString(),
+			UEdGraphSchema_K2::PC_Int.ToString());
+		TestEqual(FString::Printf(TEXT("Option pin default value %d"), Index), CasePairs[Index].Key->DefaultValue,
+			FString::FromInt(Index * 10));
+		TestEqual(FString::Printf(TEXT("Condition pin default value %d"), Index), CasePairs[Index].Value->DefaultValue,
+			FString((Index % 2 == 0) ? TEXT("true") : TEXT("false")));
+	}
+	TestEqual(TEXT("Return value pin type"), MultiConditionalSelect->GetReturnValuePin()->PinType.PinCategory.ToString(),
+		UEdGraphSchema_K2::PC_Int.ToString());
+
+	return true;
+}
+
+static TArray<FGuid> GetCasePinIds(const UK2Node_CasePairedPinsNode* Node)
+{
+	TArray<FGuid> PinIds;
+	for (const CasePinPair& Pair : Node->GetCasePinPairs())
+	{
+		PinIds.Add(Pair.Key->PinId);
+		PinIds.Add(Pair.Value->PinId);
+	}
+
+	return PinIds;
+}
+
+bool FFunctionalTestCasePinUndo::RunTest(const FString& Parameters)
+{
+	static const int32 CaseCount = 256;
+	static const int32 EditCount = 16;
+	// The snapshot of the node with CaseCount cases is far larger than this.
+	static const SIZE_T MaxUndoSizePerEdit = 1024;
+
+	UTransBuffer* TransBuffer = (GEditor != nullptr) ? Cast<UTransBuffer>(GEditor->Trans) : nullptr;
+	if (!TestNotNull(TEXT("Transaction buffer should exist"), TransBuffer))
+	{
+		return false;
+	}
+
+	UBlueprint* Blueprint = CreateTestBlueprint(TEXT("BP_CasePinUndo"));
+	FTestFunctionGraph Function = AddTestFunctionGraph(Blueprint, TEXT("Test_Undo"));
+	if (!TestNotNull(TEXT("Function graph should be created"), Function.Graph))
+	{
+		return false;
+	}
+
+	FGraphNodeCreator<UK2Node_MultiBranch> NodeCreator(*Function.Graph);
+	UK2Node_MultiBranch* MultiBranch = NodeCreator.CreateNode(false);
+	NodeCreator.Finalize();
+	MultiBranch->SetCaseCount(CaseCount);
+	const TArray<FGuid> InitialPinIds = GetCasePinIds(MultiBranch);
+
+	// Each edit is one transaction which records only the edited cases.
+	const SIZE_T InitialUndoSize = TransBuffer->GetUndoSize();
+	for (int32 Index = 0; Index < EditCount; ++Index)
+	{
+		if (Index % 2 == 0)
+		{
+			MultiBranch->InsertCases(CaseCount / 2, 1);
+		}
+		else
+		{
+			MultiBranch->RemoveCases(0, 1);
+		}
+	}
+	TestCasePinNames(this, MultiBranch, CaseCount);
+	TestTrue(TEXT("Undo buffer growth by the edits should be bounded"),
+		TransBuffer->GetUndoSize() - InitialUndoSize <= MaxUndoSizePerEdit * EditCount);
+
+	// Undo restores the removed cases with their pin IDs.
+	for (int32 Index = 0; Index < EditCount; ++Index)
+	{
+		GEditor->UndoTransaction();
+	}
+	TestCasePinNames(this, MultiBranch, CaseCount);
+	TestTrue(TEXT("Pin IDs should be restored by undo"), GetCasePinIds(MultiBranch) == InitialPinIds);
+
+	for (int32 Index = 0; Index < EditCount; ++Index)
+	{
+		GEditor->RedoTransaction();
+	}
+	TestCasePinNames(this, MultiBranch, CaseCount);
+	TestFalse(TEXT("First cases should be removed by redo"), GetCasePinIds(MultiBranch)[0] == InitialPinIds[0]);
+	TestTrue(TEXT("Undo buffer growth by undo and redo should be bounded"),
+		TransBuffer->GetUndoSize() - InitialUndoSize <= MaxUndoSizePerEdit * EditCount);
+
+	TestTrue(TEXT("Blueprint should be compiled"), CompileTestBlueprint(Blueprint));
+
+	return true;
+}
+
+// Reconstruct the node as the Blueprint is loaded.
+static void ReconstructNodeOnLoad(UBlueprint* Blueprint, UEdGraphNode* Node)
+{
+	Blueprint->bIsRegeneratingOnLoad = true;
+	Node->ReconstructNode();
+	Blueprint->bIsRegeneratingOnLoad = false;
+}
+
+bool FFunctionalTestCasePinLayoutOnLoad::RunTest(const FString& Parameters)
+{
+	static const int32 CaseCount = 4;
+
+	UBlueprint* Blueprint = CreateTestBlueprint(TEXT("BP_CasePinLayoutOnLoad"));
+	FEdGraphPinType BoolPinType;
+	BoolPinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+	FEdGraphPinType IntPinType;
+	IntPinType.PinCategory = UEdGraphSchema_K2::PC_Int;
+	for (int32 Index = 0; Index < CaseCount + 1; ++Index)
+	{
+		FBlueprintEditorUtils::AddMemberVariable(Blueprint, GetConditionVariableName(Index), BoolPinType);
+	}
+	FBlueprintEditorUtils::AddMemberVariable(Blueprint, ResultVariableName, IntPinType);
+
+	FTestFunctionGraph Function = AddTestFunctionGraph(Blueprint, TEXT("Test_LayoutOnLoad"));
+	if (!TestTrue(TEXT("Function graph should be built"),
+			(Function.Entry != nullptr) &&
+				BuildPluginFunctionGraph(Blueprint, Function, ETestNodeType::MultiBranch, CaseCount)))
+	{
+		return false;
+	}
+
+	UK2Node_MultiBranch* MultiBranch = nullptr;
+	for (UEdGraphNode* Node : Function.Graph->Nodes)
+	{
+		MultiBranch = Cast<UK2Node_MultiBranch>(Node);
+		if (MultiBranch != nullptr)
+		{
+			break;
+		}
+	}
+	if (!TestNotNull(TEXT("Multi-Branch should be built"), MultiBranch))
+	{
+		return false;
+	}
+
+	// The layout is not saved yet, so the node is reconstructed.
+	TArray<UEdGraphPin*> OldPins = MultiBranch->Pins;
+	ReconstructNodeOnLoad(Blueprint, MultiBranch);
+	TestFalse(TEXT("Pins should be recreated without the saved layout"), MultiBranch->Pins == OldPins);
+
+	// The pins loaded with the saved layout are kept.
+	TArray<uint8> Bytes;
+	FMemoryWriter MemoryWriter(Bytes, true);
+	FObjectAndNameAsStringProxyArchive Writer(MemoryWriter, false);
+	MultiBranch->Serialize(Writer);
+	OldPins = MultiBranch->Pins;
+	ReconstructNodeOnLoad(Blueprint, MultiBranch);
+	TestTrue(TEXT("Pins should be kept with the saved layout"), MultiBranch->Pins == OldPins);
+
+	// The reconstruction on the editor always recreates the pins.
+	MultiBranch->ReconstructNode();
+	TestFalse(TEXT("Pins should be recreated out of loading"), MultiBranch->Pins == OldPins);
+
+	// The changed case count does not match the saved layout.
+	MultiBranch->SetCaseCount(CaseCount + 1);
+	OldPins = MultiBranch->Pins;
+	ReconstructNodeOnLoad(Blueprint, MultiBranch);
+	TestFalse(TEXT("Pins should be recreated with the changed case count"), MultiBranch->Pins == OldPins);
+	TestCasePinNames(this, MultiBranch, CaseCount + 1);
+
+	// The pin which is loaded with the different type does not match the saved layout even if the pin count is same.
+	MultiBranch->Serialize(Writer);
+	UEdGraphPin** ConditionPin = MultiBranch->Pins.FindByPredicate(
+		[](const UEdGraphPin* Pin) { return Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Boolean; });
+	if (!TestNotNull(TEXT("Multi-Branch should have the condition pin"), ConditionPin))
+	{
+		return false;
+	}
+	(*ConditionPin)->PinType.PinCategory = UEdGraphSchema_K2::PC_Int;
+	OldPins = MultiBranch->Pins;
+	ReconstructNodeOnLoad(Blueprint, MultiBranch);
+	TestFalse(TEXT("Pins should be recreated with the changed pin type"), MultiBranch->Pins == OldPins);
+	TestCasePinNames(this, MultiBranch, CaseCount + 1);
+
+	TestTrue(TEXT("Blueprint should be compiled"), CompileTestBlueprint(Blueprint));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,86 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+
+#include "AdvancedControlFlowLibrary.h"
+#include "AdvancedControlFlowTrace.h"
+#include "Engine/Blueprint.h"
+#include "HAL/IConsoleManager.h"
+#include "TestBlueprintBuilder.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestCaseTrace, "AdvancedControlFlow.FunctionalTest.CaseTrace",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+#if ACF_WITH_TRACE
+
+bool FFunctionalTestCaseTrace::RunTest(const FString& Parameters)
+{
+	IConsoleVariable* TraceCases = IConsoleManager::Get().FindConsoleVariable(TEXT("acf.TraceCases"));
+	if (!TestNotNull(TEXT("acf.TraceCases should exist"), TraceCases))
+	{
+		return false;
+	}
+	const bool bOldTraceCases = TraceCases->GetBool();
+	const bool bOldChannelEnabled = FAdvancedControlFlowTrace::IsEnabled();
+
+	// Nothing is traced while the channel is disabled.
+	UE::Trace::ToggleChannel(TEXT("AdvancedControlFlow"), false);
+	TestEqual(TEXT("Disabled channel should not begin the case"), FAdvancedControlFlowTrace::BeginCase(), uint64(0));
+	TestEqual(TEXT("Disabled channel should return 0"), UAdvancedControlFlowLibrary::BeginTraceCase(), int64(0));
+
+	UE::Trace::ToggleChannel(TEXT("AdvancedControlFlow"), true);
+	if (TestTrue(TEXT("Channel should be enabled"), FAdvancedControlFlowTrace::IsEnabled()))
+	{
+		const int64 StartCycle = UAdvancedControlFlowLibrary::BeginTraceCase();
+		TestNotEqual(TEXT("Enabled channel should begin the case"), StartCycle, int64(0));
+		TestEqual(TEXT("Traced case should be cleared"),
+			UAdvancedControlFlowLibrary::TraceCaseTaken(TEXT("/Temp/BP_CaseTrace.BP_CaseTrace:Node"), 0, StartCycle), int64(0));
+	}
+
+	// The instrumented nodes take the same case as the nodes which are not instrumented, with both the channel states.
+	TraceCases->Set(true);
+	const int32 CaseCount = 4;
+	for (ETestNodeType NodeType :
+		{ETestNodeType::MultiBranch, ETestNodeType::ConditionalSequence, ETestNodeType::MultiConditionalSelect})
+	{
+		const FString NodeTypeName = GetTestNodeTypeName(NodeType);
+
+		// Only the last condition is true.
+		UBlueprint* Blueprint = BuildBenchmarkBlueprint(NodeType, CaseCount);
+		UFunction* Function =
+			(Blueprint != nullptr) ? Blueprint->GeneratedClass->FindFunctionByName(BenchmarkPluginFunctionName) : nullptr;
+		FIntProperty* ResultProperty =
+			(Blueprint != nullptr) ? FindFProperty<FIntProperty>(Blueprint->GeneratedClass, ResultVariableName) : nullptr;
+		if (!TestTrue(FString::Printf(TEXT("%s: Blueprint should be compiled"), *NodeTypeName),
+				(Function != nullptr) && (ResultProperty != nullptr)))
+		{
+			continue;
+		}
+
+		UObject* Object = NewObject<UObject>(GetTransientPackage(), Blueprint->GeneratedClass);
+		for (bool bChannelEnabled : {true, false})
+		{
+			UE::Trace::ToggleChannel(TEXT("AdvancedControlFlow"), bChannelEnabled);
+			ResultProperty->SetPropertyValue_InContainer(Object, -1);
+			Object->ProcessEvent(Function, nullptr);
+			TestEqual(FString::Printf(TEXT("%s: Last case should be taken (Channel: %d)"), *NodeTypeName, bChannelEnabled),
+				ResultProperty->GetPropertyValue_InContainer(Object), CaseCount - 1);
+		}
+	}
+
+	TraceCases->Set(bOldTraceCases);
+	UE::Trace::ToggleChannel(TEXT("AdvancedControlFlow"), bOldChannelEnabled);
+
+	return true;
+}
+
+#else
+
+bool FFunctionalTestCaseTrace::RunTest(const FString& Parameters)
+{
+	return true;
+}
+
+#endif
+
+#endif
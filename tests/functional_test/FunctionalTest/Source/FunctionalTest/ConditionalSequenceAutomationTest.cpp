@@ -0,0 +1,64 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "TestBlueprintBuilder.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestConditionalSequenceSnapshot,
+	"AdvancedControlFlow.FunctionalTest.ConditionalSequence.SnapshotConditions",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+static const FName SequenceFunctionName(TEXT("Test_Sequence"));
+
+// Run the function and return "Result", or INDEX_NONE - 1 if the Blueprint could not be built.
+static int32 RunConditionalSequence(
+	FAutomationTestBase* AutomationTest, int32 CaseCount, bool bSnapshotConditions, bool bShareCondition)
+{
+	const TArray<FTestMemberVariable> Members = {{ResultVariableName, MakeTestPinType(UEdGraphSchema_K2::PC_Int)}};
+	UBlueprint* Blueprint = CreateTestBlueprintWithMembers(TEXT("BP_ConditionalSequence"), Members);
+
+	FTestFunctionGraph Function = AddTestFunctionGraph(Blueprint, SequenceFunctionName);
+	if (!AutomationTest->TestTrue(TEXT("Blueprint should be compiled"),
+			(Function.Entry != nullptr) &&
+				BuildConditionalSequenceSnapshotFunctionGraph(
+					Blueprint, Function, CaseCount, bSnapshotConditions, bShareCondition) &&
+				CompileTestBlueprint(Blueprint)))
+	{
+		return INDEX_NONE - 1;
+	}
+
+	FTestBlueprintInstance Instance;
+	if (!InstantiateTestBlueprint(AutomationTest, Blueprint, SequenceFunctionName, Members, Instance))
+	{
+		return INDEX_NONE - 1;
+	}
+
+	Instance.SetResult(-1);
+	Instance.Call();
+
+	return Instance.GetResult();
+}
+
+bool FFunctionalTestConditionalSequenceSnapshot::RunTest(const FString& Parameters)
+{
+	for (bool bShareCondition : {false, true})
+	{
+		const TCHAR* ConditionType = bShareCondition ? TEXT("shared") : TEXT("separate");
+		for (int32 CaseCount : {1, 2, 5})
+		{
+			// The first case execution makes the later conditions false.
+			TestEqual(FString::Printf(TEXT("Lazy %s conditions with %d cases"), ConditionType, CaseCount),
+				RunConditionalSequence(this, CaseCount, false, bShareCondition), 0);
+
+			// All conditions are true on the snapshot, so the last case execution wins.
+			TestEqual(FString::Printf(TEXT("Snapshot %s conditions with %d cases"), ConditionType, CaseCount),
+				RunConditionalSequence(this, CaseCount, true, bShareCondition), CaseCount - 1);
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,91 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+
+#include "EdGraphSchema_K2.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "TestBlueprintBuilder.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestConstantFolding, "AdvancedControlFlow.FunctionalTest.ConstantFolding",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+struct FConstantFoldingTestCase
+{
+	ETestNodeType NodeType;
+	// Literal condition, or empty if the condition is read from the variable.
+	TArray<FString> Conditions;
+	// Number of the pruned cases reported to the compiler log.
+	int32 PrunedCaseCount;
+};
+
+// Expected "Result" computed from the conditions without folding, where the bit Index of the bits is "Cond_<Index>".
+static int32 GetExpectedFoldingResult(const FConstantFoldingTestCase& TestCase, int32 Bits)
+{
+	int32 Result = -1;
+	for (int32 Index = 0; Index < TestCase.Conditions.Num(); ++Index)
+	{
+		const bool bCondition =
+			TestCase.Conditions[Index].IsEmpty() ? ((Bits & (1 << Index)) != 0) : TestCase.Conditions[Index].ToBool();
+		if (!bCondition)
+		{
+			continue;
+		}
+
+		Result = Index;
+		if (TestCase.NodeType != ETestNodeType::ConditionalSequence)
+		{
+			break;
+		}
+	}
+
+	return Result;
+}
+
+// Dispatch all combinations of the variable conditions.
+static bool RunConstantFoldingTest(FAutomationTestBase* AutomationTest, const FConstantFoldingTestCase& TestCase)
+{
+	const int32 ConditionCount = TestCase.Conditions.Num();
+
+	FTestDispatchTable Table;
+	Table.BlueprintName = FString::Printf(TEXT("BP_Folding_%s"), *GetTestNodeTypeName(TestCase.NodeType));
+	Table.Members = MakeCaseMemberVariables(
+		ConditionCount, GetConditionVariableName, MakeTestPinType(UEdGraphSchema_K2::PC_Boolean));
+	Table.Members.Add({ResultVariableName, MakeTestPinType(UEdGraphSchema_K2::PC_Int)});
+	Table.Members.Add({DefaultValueVariableName, MakeTestPinType(UEdGraphSchema_K2::PC_Int), TEXT("-1")});
+	Table.BuildFunctionGraph = [&TestCase](UBlueprint* Blueprint, const FTestFunctionGraph& Function)
+	{ return BuildLiteralConditionFunctionGraph(Blueprint, Function, TestCase.NodeType, TestCase.Conditions); };
+	Table.InputCount = 1 << ConditionCount;
+	Table.SetInput = [ConditionCount](const FTestBlueprintInstance& Instance, int32 Bits)
+	{
+		Instance.SetConditions(ConditionCount, Bits);
+		return FString::Printf(TEXT("variables 0x%x"), Bits);
+	};
+	Table.GetExpectedResult = [&TestCase](int32 Bits) { return GetExpectedFoldingResult(TestCase, Bits); };
+	Table.InitialResult = -1;
+
+	FCompilerResultsLog Results;
+	Results.bSilentMode = true;
+	const bool bSucceeded = RunTestDispatchTable(AutomationTest, Table, &Results);
+	AutomationTest->TestEqual(FString::Printf(TEXT("%s: Pruned cases should be noted"), *Table.BlueprintName), Results.NumNotes,
+		TestCase.PrunedCaseCount);
+
+	return bSucceeded;
+}
+
+bool FFunctionalTestConstantFolding::RunTest(const FString& Parameters)
+{
+	// Multi-Branch and Multi-Conditional Select: Case 0 and Case 2 are always false, Case 4 is always true and Case 5 and the
+	// default are never reached.
+	// Conditional Sequence: Case 0 and Case 2 are always false, and the other stages are kept.
+	const TArray<FString> Conditions = {TEXT("false"), TEXT(""), TEXT("false"), TEXT(""), TEXT("true"), TEXT("")};
+
+	bool bSucceeded = true;
+	bSucceeded &= RunConstantFoldingTest(this, {ETestNodeType::MultiBranch, Conditions, 4});
+	bSucceeded &= RunConstantFoldingTest(this, {ETestNodeType::ConditionalSequence, Conditions, 2});
+	bSucceeded &= RunConstantFoldingTest(this, {ETestNodeType::MultiConditionalSelect, Conditions, 3});
+	bSucceeded &= RunConstantFoldingTest(this, {ETestNodeType::MultiBranch, {TEXT(""), TEXT("")}, 0});
+
+	return bSucceeded;
+}
+
+#endif
@@ -0,0 +1,227 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+
+#include "Dom/JsonObject.h"
+#include "Engine/Blueprint.h"
+#include "HAL/PlatformTime.h"
+#include "K2Node_CasePairedPinsNode.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "TestBlueprintBuilder.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPerformanceTestEditorScaling, "AdvancedControlFlow.Performance.EditorScaling",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter);
+
+// Number of the edits per operation can be changed by -ACFEditorBenchmarkIterations=<N>, and the output file of the scaling
+// curves by -ACFEditorBenchmarkOutput=<Path>.
+static const int32 DefaultEditorBenchmarkIterations = 8;
+static const int32 EditorBenchmarkCaseCounts[] = {1, 8, 32, 128, 512};
+
+// The edits of the case pins should be linear in the number of the cases (the following pins are renamed).
+// The growth is reported as the exponent of the curve between the two largest case counts, and warned if it is quadratic.
+static const double MaxEditExponent = 1.5;
+
+struct FEditorOperation
+{
+	const TCHAR* Name;
+	// Run the operation once on the node which has the original number of the cases, and return the elapsed seconds.
+	// The operation restores the number of the cases untimed, so that each iteration measures the same node size.
+	TFunction<double(UBlueprint*, UK2Node_CasePairedPinsNode*)> Run;
+	bool bIsCaseEdit;
+};
+
+static double TimeSeconds(TFunctionRef<void()> Function)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	Function();
+	return FPlatformTime::Seconds() - StartTime;
+}
+
+// The pins are edited at the middle of the cases, so that the half of the cases follow them.
+static int32 GetMiddleCaseIndex(UK2Node_CasePairedPinsNode* Node)
+{
+	return Node->GetCasePinCount() / 2;
+}
+
+static UEdGraphPin* GetCaseKeyPin(UK2Node_CasePairedPinsNode* Node, int32 CaseIndex)
+{
+	return Node->GetCasePinPairs()[CaseIndex].Key;
+}
+
+static TArray<FEditorOperation> GetEditorOperations()
+{
+	// The added case is removed (or the removed case is added) again, so the connected cases of the benchmark graph are kept.
+	return {
+		{TEXT("AddCasePinLast"),
+			[](UBlueprint* Blueprint, UK2Node_CasePairedPinsNode* Node)
+			{
+				const double Elapsed = TimeSeconds([Node]() { Node->AddCasePinLast(); });
+				Node->RemoveCases(Node->GetCasePinCount() - 1, 1);
+				return Elapsed;
+			},
+			true},
+		{TEXT("AddCasePinAfter"),
+			[](UBlueprint* Blueprint, UK2Node_CasePairedPinsNode* Node)
+			{
+				const int32 CaseIndex = GetMiddleCaseIndex(Node);
+				UEdGraphPin* Pin = GetCaseKeyPin(Node, CaseIndex);
+				const double Elapsed = TimeSeconds([Node, Pin]() { Node->AddCasePinAfter(Pin); });
+				Node->RemoveCases(CaseIndex + 1, 1);
+				return Elapsed;
+			},
+			true},
+		{TEXT("AddCasePinBefore"),
+			[](UBlueprint* Blueprint, UK2Node_CasePairedPinsNode* Node)
+			{
+				const int32 CaseIndex = GetMiddleCaseIndex(Node);
+				UEdGraphPin* Pin = GetCaseKeyPin(Node, CaseIndex);
+				const double Elapsed = TimeSeconds([Node, Pin]() { Node->AddCasePinBefore(Pin); });
+				Node->RemoveCases(CaseIndex, 1);
+				return Elapsed;
+			},
+			true},
+		{TEXT("RemoveCasePinAt"),
+			[](UBlueprint* Blueprint, UK2Node_CasePairedPinsNode* Node)
+			{
+				const int32 CaseIndex = GetMiddleCaseIndex(Node);
+				Node->InsertCases(CaseIndex, 1);
+				UEdGraphPin* Pin = GetCaseKeyPin(Node, CaseIndex);
+				return TimeSeconds([Node, Pin]() { Node->RemoveCasePinAt(Pin); });
+			},
+			true},
+		{TEXT("ReconstructNode"),
+			[](UBlueprint* Blueprint, UK2Node_CasePairedPinsNode* Node)
+			{ return TimeSeconds([Node]() { Node->ReconstructNode(); }); },
+			true},
+		{TEXT("CompileBlueprint"),
+			[](UBlueprint* Blueprint, UK2Node_CasePairedPinsNode* Node)
+			{ return TimeSeconds([Blueprint]() { CompileTestBlueprint(Blueprint); }); },
+			false},
+	};
+}
+
+// Return E where Seconds = C * Cases^E between the two largest case counts.
+static double GetScalingExponent(const TArray<double>& Curve)
+{
+	const int32 Last = UE_ARRAY_COUNT(EditorBenchmarkCaseCounts) - 1;
+	const double CaseRatio = static_cast<double>(EditorBenchmarkCaseCounts[Last]) / EditorBenchmarkCaseCounts[Last - 1];
+	const double TimeRatio = FMath::Max(Curve[Last], 1.0e-9) / FMath::Max(Curve[Last - 1], 1.0e-9);
+
+	return FMath::Loge(TimeRatio) / FMath::Loge(CaseRatio);
+}
+
+bool FPerformanceTestEditorScaling::RunTest(const FString& Parameters)
+{
+	int32 Iterations = DefaultEditorBenchmarkIterations;
+	FParse::Value(FCommandLine::Get(), TEXT("ACFEditorBenchmarkIterations="), Iterations);
+	Iterations = FMath::Max(Iterations, 1);
+	FString OutputPath =
+		FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AdvancedControlFlow"), TEXT("EditorScaling.json"));
+	FParse::Value(FCommandLine::Get(), TEXT("ACFEditorBenchmarkOutput="), OutputPath);
+
+	// Multi-Branch on Change is not measured, because it compiles only in the event graph of the Blueprint whose objects notify
+	// the field value changes, and the benchmark Blueprint is a plain UObject with the function graph.
+	const ETestNodeType NodeTypes[] = {ETestNodeType::MultiBranch, ETestNodeType::ConditionalSequence,
+		ETestNodeType::MultiConditionalSelect, ETestNodeType::MultiBranchOnValue, ETestNodeType::MultiBranchOnBitmask,
+		ETestNodeType::MultiBranchOnName, ETestNodeType::ParallelConditionalSequence};
+	const TArray<FEditorOperation> Operations = GetEditorOperations();
+
+	// {"Iterations": N, "CaseCounts": [...], "Nodes": {"<Node>": {"<Operation>": {"Seconds": [...], "Exponent": E}}}}
+	TArray<TSharedPtr<FJsonValue>> CaseCountValues;
+	for (int32 CaseCount : EditorBenchmarkCaseCounts)
+	{
+		CaseCountValues.Add(MakeShared<FJsonValueNumber>(CaseCount));
+	}
+	TSharedRef<FJsonObject> NodesObject = MakeShared<FJsonObject>();
+
+	for (ETestNodeType NodeType : NodeTypes)
+	{
+		const FString NodeTypeName = GetTestNodeTypeName(NodeType);
+		TArray<TArray<double>> Curves;
+		Curves.SetNum(Operations.Num());
+
+		for (int32 CaseCount : EditorBenchmarkCaseCounts)
+		{
+			UBlueprint* Blueprint = CreateBenchmarkBlueprint(NodeType, CaseCount, false);
+			TArray<UK2Node_CasePairedPinsNode*> Nodes;
+			if (Blueprint != nullptr)
+			{
+				FBlueprintEditorUtils::GetAllNodesOfClass(Blueprint, Nodes);
+			}
+			if (!TestTrue(TEXT("Benchmark Blueprint should be built"), (Nodes.Num() == 1) && CompileTestBlueprint(Blueprint)))
+			{
+				return false;
+			}
+			UK2Node_CasePairedPinsNode* Node = Nodes[0];
+
+			for (int32 OperationIndex = 0; OperationIndex < Operations.Num(); ++OperationIndex)
+			{
+				const FEditorOperation& Operation = Operations[OperationIndex];
+
+				double Elapsed = 0.0;
+				for (int32 Index = 0; Index < Iterations; ++Index)
+				{
+					Elapsed += Operation.Run(Blueprint, Node);
+				}
+				const double SecondsPerCall = Elapsed / Iterations;
+				Curves[OperationIndex].Add(SecondsPerCall);
+
+				const FString Context = FString::Printf(TEXT("%s.%s.Cases%d"), *NodeTypeName, Operation.Name, CaseCount);
+				AddInfo(FString::Printf(TEXT("%s: %.3f ms/call"), *Context, SecondsPerCall * 1.0e3));
+				AddTelemetryData(TEXT("SecondsPerCall"), SecondsPerCall, Context);
+			}
+
+			TestEqual(FString::Printf(TEXT("%s.Cases%d: Case count should be restored"), *NodeTypeName, CaseCount),
+				Node->GetCasePinCount(), CaseCount);
+		}
+
+		TSharedRef<FJsonObject> NodeObject = MakeShared<FJsonObject>();
+		for (int32 OperationIndex = 0; OperationIndex < Operations.Num(); ++OperationIndex)
+		{
+			const FEditorOperation& Operation = Operations[OperationIndex];
+			const TArray<double>& Curve = Curves[OperationIndex];
+
+			const double Exponent = GetScalingExponent(Curve);
+			if (Operation.bIsCaseEdit && (Exponent > MaxEditExponent))
+			{
+				AddWarning(FString::Printf(
+					TEXT("%s.%s grows as Cases^%.2f, which is more than linear"), *NodeTypeName, Operation.Name, Exponent));
+			}
+
+			TArray<TSharedPtr<FJsonValue>> SecondsValues;
+			for (double Seconds : Curve)
+			{
+				SecondsValues.Add(MakeShared<FJsonValueNumber>(Seconds));
+			}
+			TSharedRef<FJsonObject> OperationObject = MakeShared<FJsonObject>();
+			OperationObject->SetArrayField(TEXT("Seconds"), SecondsValues);
+			OperationObject->SetNumberField(TEXT("Exponent"), Exponent);
+			NodeObject->SetObjectField(Operation.Name, OperationObject);
+		}
+		NodesObject->SetObjectField(NodeTypeName, NodeObject);
+	}
+
+	TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+	RootObject->SetNumberField(TEXT("Iterations"), Iterations);
+	RootObject->SetArrayField(TEXT("CaseCounts"), CaseCountValues);
+	RootObject->SetObjectField(TEXT("Nodes"), NodesObject);
+
+	FString Output;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	FJsonSerializer::Serialize(RootObject, Writer);
+	if (!TestTrue(TEXT("Scaling curves should be saved"), FFileHelper::SaveStringToFile(Output, *OutputPath)))
+	{
+		return false;
+	}
+	AddInfo(FString::Printf(TEXT("Scaling curves are saved to %s"), *OutputPath));
+
+	return true;
+}
+
+#endif
@@ -12,6 +12,14 @@ public class FunctionalTest : ModuleRules
 
 		PrivateDependencyModuleNames.AddRange(new string[]{});
 
+		// Benchmarks build the Blueprints on the fly.
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.AddRange(new string[]{
+				"AdvancedControlFlow", "AdvancedControlFlowRuntime", "BlueprintGraph", "Json", "Kismet", "KismetCompiler",
+				"UnrealEd"});
+		}
+
 		// Uncomment if you are using Slate UI
 		// PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
 
@@ -0,0 +1,40 @@
+#include "FunctionalTestThreadSafeLibrary.h"
+
+#include "Misc/ScopeLock.h"
+
+static FCriticalSection CallCountCriticalSection;
+static TMap<int32, int32> CallCounts;
+static TMap<int32, int32> GameThreadCallCounts;
+
+void UFunctionalTestThreadSafeLibrary::CountCall(int32 Key)
+{
+	FScopeLock Lock(&CallCountCriticalSection);
+
+	CallCounts.FindOrAdd(Key)++;
+	if (IsInGameThread())
+	{
+		GameThreadCallCounts.FindOrAdd(Key)++;
+	}
+}
+
+int32 UFunctionalTestThreadSafeLibrary::GetCallCount(int32 Key)
+{
+	FScopeLock Lock(&CallCountCriticalSection);
+
+	return CallCounts.FindRef(Key);
+}
+
+int32 UFunctionalTestThreadSafeLibrary::GetGameThreadCallCount(int32 Key)
+{
+	FScopeLock Lock(&CallCountCriticalSection);
+
+	return GameThreadCallCounts.FindRef(Key);
+}
+
+void UFunctionalTestThreadSafeLibrary::ResetCallCounts()
+{
+	FScopeLock Lock(&CallCountCriticalSection);
+
+	CallCounts.Reset();
+	GameThreadCallCounts.Reset();
+}
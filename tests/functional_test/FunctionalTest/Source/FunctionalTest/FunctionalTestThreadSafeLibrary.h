@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "FunctionalTestThreadSafeLibrary.generated.h"
+
+// Thread safe functions which the test Blueprints call from the worker threads instead of writing their members.
+UCLASS()
+class UFunctionalTestThreadSafeLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Count the call with the key, and whether it is called on the game thread.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe))
+	static void CountCall(int32 Key);
+
+	static int32 GetCallCount(int32 Key);
+	static int32 GetGameThreadCallCount(int32 Key);
+	static void ResetCallCounts();
+};
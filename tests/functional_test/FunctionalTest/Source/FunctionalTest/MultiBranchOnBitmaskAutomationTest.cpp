@@ -0,0 +1,76 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+
+#include "EdGraphSchema_K2.h"
+#include "K2Node_MultiBranchOnBitmask.h"
+#include "TestBlueprintBuilder.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestMultiBranchOnBitmask, "AdvancedControlFlow.FunctionalTest.MultiBranchOnBitmask",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+// Expected case index computed by testing the bits one by one from the lowest, or -1 (default).
+static int32 GetExpectedBitmaskCaseIndex(const TArray<int32>& Bits, int32 Mask)
+{
+	for (int32 Bit = 0; Bit < 32; ++Bit)
+	{
+		if ((Mask & (1 << Bit)) == 0)
+		{
+			continue;
+		}
+		for (int32 Index = 0; Index < Bits.Num(); ++Index)
+		{
+			if (Bits[Index] == Bit)
+			{
+				return Index;
+			}
+		}
+	}
+
+	return -1;
+}
+
+static bool RunBitmaskDispatchTest(FAutomationTestBase* AutomationTest, const TArray<int32>& Bits, const TArray<int32>& Masks)
+{
+	FTestDispatchTable Table;
+	Table.BlueprintName = TEXT("BP_MultiBranchOnBitmask");
+	Table.Members = {
+		{ResultVariableName, MakeTestPinType(UEdGraphSchema_K2::PC_Int)},
+		{SelectionVariableName, MakeTestPinType(UEdGraphSchema_K2::PC_Int)},
+	};
+	Table.BuildFunctionGraph = [&Bits](UBlueprint* Blueprint, const FTestFunctionGraph& Function)
+	{ return BuildMultiBranchOnBitmaskFunctionGraph(Blueprint, Function, Bits); };
+	Table.InputCount = Masks.Num();
+	Table.SetInput = [&Masks](const FTestBlueprintInstance& Instance, int32 InputIndex)
+	{
+		Instance.SetSelection(Masks[InputIndex]);
+		return FString::Printf(TEXT("mask 0x%08x"), Masks[InputIndex]);
+	};
+	Table.GetExpectedResult = [&Bits, &Masks](int32 InputIndex) { return GetExpectedBitmaskCaseIndex(Bits, Masks[InputIndex]); };
+
+	return RunTestDispatchTable(AutomationTest, Table);
+}
+
+bool FFunctionalTestMultiBranchOnBitmask::RunTest(const FString& Parameters)
+{
+	// Unsorted, sparse and duplicated bits. The sign bit is also mapped.
+	const TArray<int32> Bits = {5, 1, 31, 8, 1, 16, 3};
+
+	TArray<int32> Masks = {0, -1, 0x7fffffff, 0x00000004, 0x00000005, 0x00010100, MIN_int32, MIN_int32 | 1};
+	for (int32 Bit = 0; Bit < 32; ++Bit)
+	{
+		Masks.Add(1 << Bit);
+		Masks.Add(~((1 << Bit) - 1));
+	}
+
+	bool bSucceeded = true;
+	for (int32 CaseCount = 0; CaseCount <= Bits.Num(); ++CaseCount)
+	{
+		TArray<int32> SubBits(Bits.GetData(), CaseCount);
+		bSucceeded &= RunBitmaskDispatchTest(this, SubBits, Masks);
+	}
+
+	return bSucceeded;
+}
+
+#endif
@@ -0,0 +1,88 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+
+#include "AdvancedControlFlowLibrary.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "TestBlueprintBuilder.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestMultiBranchOnChange, "AdvancedControlFlow.FunctionalTest.MultiBranchOnChange",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestMultiBranchOnChangeInFunction,
+	"AdvancedControlFlow.FunctionalTest.MultiBranchOnChangeInFunction",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+static const FName MultiBranchOnChangeEventName(TEXT("Test_OnChange"));
+
+static TArray<FTestMemberVariable> MakeMultiBranchOnChangeMembers(int32 CaseCount)
+{
+	TArray<FTestMemberVariable> Members = MakeCaseMemberVariables(
+		CaseCount, GetConditionVariableName, MakeTestPinType(UEdGraphSchema_K2::PC_Boolean));
+	Members.Add({ResultVariableName, MakeTestPinType(UEdGraphSchema_K2::PC_Int)});
+
+	return Members;
+}
+
+// Return true if the Blueprint fails to compile with the errors.
+static bool FailsToCompile(UBlueprint* Blueprint)
+{
+	FCompilerResultsLog Results;
+	Results.bSilentMode = true;
+
+	return !CompileTestBlueprint(Blueprint, &Results) && (Results.NumErrors > 0);
+}
+
+bool FFunctionalTestMultiBranchOnChange::RunTest(const FString& Parameters)
+{
+	const int32 CaseCount = 3;
+	const TArray<FName> WatchedFields = {GetConditionVariableName(0), GetConditionVariableName(1)};
+
+	// UObject does not notify the field value changes, so the source must be rejected on compile instead of polling it.
+	UBlueprint* Blueprint =
+		CreateTestBlueprintWithMembers(TEXT("BP_MultiBranchOnChange"), MakeMultiBranchOnChangeMembers(CaseCount));
+	if (!TestTrue(TEXT("Event graph should be built"),
+			BuildMultiBranchOnChangeEventGraph(Blueprint, MultiBranchOnChangeEventName, CaseCount, WatchedFields)))
+	{
+		return false;
+	}
+	TestTrue(TEXT("Source which does not notify the field value changes should fail to compile"), FailsToCompile(Blueprint));
+
+	UBlueprint* NoFieldsBlueprint =
+		CreateTestBlueprintWithMembers(TEXT("BP_MultiBranchOnChangeNoFields"), MakeMultiBranchOnChangeMembers(CaseCount));
+	if (!TestTrue(TEXT("Event graph should be built"),
+			BuildMultiBranchOnChangeEventGraph(NoFieldsBlueprint, MultiBranchOnChangeEventName, CaseCount, {})))
+	{
+		return false;
+	}
+	TestTrue(TEXT("Node without the watched fields should fail to compile"), FailsToCompile(NoFieldsBlueprint));
+
+	// The runtime binding also rejects the object which does not notify the field value changes.
+	UObject* Source = NewObject<UObject>(GetTransientPackage(), UObject::StaticClass());
+	FAdvancedControlFlowFieldValueChangedDelegate Delegate;
+	TestFalse(TEXT("Object which does not notify the field value changes should not be bound"),
+		UAdvancedControlFlowLibrary::BindFieldValueChanged(Source, WatchedFields, Delegate));
+
+	return true;
+}
+
+bool FFunctionalTestMultiBranchOnChangeInFunction::RunTest(const FString& Parameters)
+{
+	UBlueprint* Blueprint =
+		CreateTestBlueprintWithMembers(TEXT("BP_MultiBranchOnChangeInFunction"), MakeMultiBranchOnChangeMembers(2));
+
+	FTestFunctionGraph Function = AddTestFunctionGraph(Blueprint, TEXT("Test_OnChangeInFunction"));
+	if (!TestTrue(TEXT("Function graph should be built"),
+			(Function.Entry != nullptr) &&
+				BuildMultiBranchOnChangeFunctionGraph(Blueprint, Function, 2, {GetConditionVariableName(0)})))
+	{
+		return false;
+	}
+
+	TestTrue(TEXT("Multi-Branch on Change in the function should fail to compile"), FailsToCompile(Blueprint));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,84 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+
+#include "AdvancedControlFlowCaseTable.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "TestBlueprintBuilder.h"
+#include "UObject/UObjectHash.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestMultiBranchOnName, "AdvancedControlFlow.FunctionalTest.MultiBranchOnName",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+// Expected case index computed by comparing the value with the keys one by one ignoring case, or -1 (default).
+static int32 GetExpectedNameCaseIndex(const TArray<FString>& Keys, const FString& Value)
+{
+	for (int32 Index = 0; Index < Keys.Num(); ++Index)
+	{
+		if (Keys[Index].Equals(Value, ESearchCase::IgnoreCase))
+		{
+			return Index;
+		}
+	}
+
+	return -1;
+}
+
+static bool RunNameDispatchTest(
+	FAutomationTestBase* AutomationTest, const FName& PinCategory, const TArray<FString>& Keys, const TArray<FString>& Values)
+{
+	FTestDispatchTable Table;
+	Table.BlueprintName = FString::Printf(TEXT("BP_MultiBranchOn%s"), *PinCategory.ToString());
+	Table.Members = {
+		{ResultVariableName, MakeTestPinType(UEdGraphSchema_K2::PC_Int)},
+		{SelectionVariableName, MakeTestPinType(PinCategory)},
+	};
+	Table.BuildFunctionGraph = [&Keys](UBlueprint* Blueprint, const FTestFunctionGraph& Function)
+	{ return BuildMultiBranchOnNameFunctionGraph(Blueprint, Function, Keys); };
+	Table.InputCount = Values.Num();
+	Table.SetInput = [&Values](const FTestBlueprintInstance& Instance, int32 InputIndex)
+	{
+		Instance.SetSelection(Values[InputIndex]);
+		return FString::Printf(TEXT("'%s'"), *Values[InputIndex]);
+	};
+	Table.GetExpectedResult = [&Keys, &Values](int32 InputIndex) { return GetExpectedNameCaseIndex(Keys, Values[InputIndex]); };
+	// The table of the previous compile must not be referred after the recompile.
+	Table.CompileCount = 2;
+
+	UBlueprint* Blueprint = nullptr;
+	const bool bSucceeded = RunTestDispatchTable(AutomationTest, Table, nullptr, &Blueprint);
+	if (Blueprint != nullptr)
+	{
+		UClass* GeneratedClass = Blueprint->GeneratedClass;
+		TArray<UObject*> CaseTables;
+		GetObjectsOfClass(UAdvancedControlFlowCaseTable::StaticClass(), CaseTables, false);
+		CaseTables.RemoveAll([GeneratedClass](const UObject* CaseTable) { return CaseTable->GetOuter() != GeneratedClass; });
+		AutomationTest->TestEqual(TEXT("Generated class should have one case table"), CaseTables.Num(), 1);
+	}
+
+	return bSucceeded;
+}
+
+bool FFunctionalTestMultiBranchOnName::RunTest(const FString& Parameters)
+{
+	// Dialog-like keys including the duplicated one which differs only in case.
+	const TArray<FString> Keys = {
+		TEXT("Greeting"), TEXT("Quest_Accept"), TEXT("Quest_Decline"), TEXT("greeting"), TEXT("Farewell"), TEXT("Shop")};
+	const TArray<FString> Values = {TEXT("Greeting"), TEXT("GREETING"), TEXT("Quest_Accept"), TEXT("Quest_Decline"),
+		TEXT("Farewell"), TEXT("Shop"), TEXT("Shop_"), TEXT("Quest"), TEXT("None"), TEXT("")};
+
+	bool bSucceeded = true;
+	for (const FName& PinCategory : {UEdGraphSchema_K2::PC_Name, UEdGraphSchema_K2::PC_String})
+	{
+		for (int32 CaseCount = 0; CaseCount <= Keys.Num(); ++CaseCount)
+		{
+			TArray<FString> SubKeys(Keys.GetData(), CaseCount);
+			bSucceeded &= RunNameDispatchTest(this, PinCategory, SubKeys, Values);
+		}
+	}
+
+	return bSucceeded;
+}
+
+#endif
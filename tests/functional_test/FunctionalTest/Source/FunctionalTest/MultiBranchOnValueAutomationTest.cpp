@@ -0,0 +1,103 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+
+#include "EdGraphSchema_K2.h"
+#include "K2Node_MultiBranchOnValue.h"
+#include "TestBlueprintBuilder.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestMultiBranchOnValueEqual,
+	"AdvancedControlFlow.FunctionalTest.MultiBranchOnValue.Equal",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestMultiBranchOnValueLessThan,
+	"AdvancedControlFlow.FunctionalTest.MultiBranchOnValue.LessThan",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+// Expected case index computed in the same way as the node, or -1 (default).
+static int32 GetExpectedCaseIndex(EMultiBranchOnValueCompareMode CompareMode, const TArray<int32>& Keys, int32 Value)
+{
+	for (int32 Index = 0; Index < Keys.Num(); ++Index)
+	{
+		if (CompareMode == EMultiBranchOnValueCompareMode::Equal)
+		{
+			if (Value == Keys[Index])
+			{
+				return Index;
+			}
+		}
+		else
+		{
+			if (Value < Keys[Index])
+			{
+				return Index;
+			}
+		}
+	}
+
+	return -1;
+}
+
+// Dispatch the values from (the minimum key - 2) to (the maximum key + 2).
+static bool RunDispatchTest(
+	FAutomationTestBase* AutomationTest, EMultiBranchOnValueCompareMode CompareMode, const TArray<int32>& Keys)
+{
+	int32 MinKey = 0;
+	int32 MaxKey = 0;
+	for (int32 Key : Keys)
+	{
+		MinKey = FMath::Min(MinKey, Key);
+		MaxKey = FMath::Max(MaxKey, Key);
+	}
+	const int32 FirstValue = MinKey - 2;
+
+	FTestDispatchTable Table;
+	Table.BlueprintName = TEXT("BP_MultiBranchOnValue");
+	Table.Members = {
+		{ResultVariableName, MakeTestPinType(UEdGraphSchema_K2::PC_Int)},
+		{SelectionVariableName, MakeTestPinType(UEdGraphSchema_K2::PC_Int)},
+	};
+	Table.BuildFunctionGraph = [CompareMode, &Keys](UBlueprint* Blueprint, const FTestFunctionGraph& Function)
+	{ return BuildMultiBranchOnValueFunctionGraph(Blueprint, Function, CompareMode, Keys); };
+	Table.InputCount = (MaxKey + 2) - FirstValue + 1;
+	Table.SetInput = [FirstValue](const FTestBlueprintInstance& Instance, int32 InputIndex)
+	{
+		Instance.SetSelection(FirstValue + InputIndex);
+		return FString::Printf(TEXT("value %d"), FirstValue + InputIndex);
+	};
+	Table.GetExpectedResult = [CompareMode, &Keys, FirstValue](int32 InputIndex)
+	{ return GetExpectedCaseIndex(CompareMode, Keys, FirstValue + InputIndex); };
+
+	return RunTestDispatchTable(AutomationTest, Table);
+}
+
+bool FFunctionalTestMultiBranchOnValueEqual::RunTest(const FString& Parameters)
+{
+	// Unsorted, non-contiguous and duplicated keys.
+	const TArray<int32> Keys = {7, 3, 12, 0, 5, 6, 3, 20, -4, 9, 10, 11};
+
+	bool bSucceeded = true;
+	for (int32 CaseCount = 0; CaseCount <= Keys.Num(); ++CaseCount)
+	{
+		TArray<int32> SubKeys(Keys.GetData(), CaseCount);
+		bSucceeded &= RunDispatchTest(this, EMultiBranchOnValueCompareMode::Equal, SubKeys);
+	}
+
+	return bSucceeded;
+}
+
+bool FFunctionalTestMultiBranchOnValueLessThan::RunTest(const FString& Parameters)
+{
+	// The threshold 8 is never reached.
+	const TArray<int32> Keys = {-5, 0, 10, 25, 8, 50, 51, 100, 1000};
+
+	bool bSucceeded = true;
+	for (int32 CaseCount = 0; CaseCount <= Keys.Num(); ++CaseCount)
+	{
+		TArray<int32> SubKeys(Keys.GetData(), CaseCount);
+		bSucceeded &= RunDispatchTest(this, EMultiBranchOnValueCompareMode::LessThan, SubKeys);
+	}
+
+	return bSucceeded;
+}
+
+#endif
@@ -0,0 +1,224 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "TestBlueprintBuilder.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestMultiConditionalSelectContainer,
+	"AdvancedControlFlow.FunctionalTest.MultiConditionalSelectContainer",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestMultiConditionalSelectElementWise,
+	"AdvancedControlFlow.FunctionalTest.MultiConditionalSelectElementWise",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+static const FName ContainerSelectFunctionName(TEXT("Test_ContainerSelect"));
+static const FName ElementWiseSelectFunctionName(TEXT("Test_ElementWiseSelect"));
+
+static TArray<int32> MakeArrayOption(int32 CaseIndex)
+{
+	// The options have the different lengths, so the copied array is checked as a whole.
+	TArray<int32> Option;
+	for (int32 Index = 0; Index <= CaseIndex; ++Index)
+	{
+		Option.Add(CaseIndex * 10 + Index);
+	}
+
+	return Option;
+}
+
+bool FFunctionalTestMultiConditionalSelectContainer::RunTest(const FString& Parameters)
+{
+	const int32 CaseCount = 4;
+
+	const FEdGraphPinType IntArrayPinType = MakeTestPinType(UEdGraphSchema_K2::PC_Int, EPinContainerType::Array);
+	TArray<FTestMemberVariable> Members =
+		MakeCaseMemberVariables(CaseCount, GetConditionVariableName, MakeTestPinType(UEdGraphSchema_K2::PC_Boolean));
+	Members.Append(MakeCaseMemberVariables(CaseCount, GetArrayOptionVariableName, IntArrayPinType));
+	Members.Add({DefaultArrayVariableName, IntArrayPinType});
+	Members.Add({ResultArrayVariableName, IntArrayPinType});
+	UBlueprint* Blueprint = CreateTestBlueprintWithMembers(TEXT("BP_MultiConditionalSelectContainer"), Members);
+
+	FTestFunctionGraph Function = AddTestFunctionGraph(Blueprint, ContainerSelectFunctionName);
+	if (!TestTrue(TEXT("Blueprint should be compiled"),
+			(Function.Entry != nullptr) && BuildMultiConditionalSelectArrayFunctionGraph(Blueprint, Function, CaseCount) &&
+				CompileTestBlueprint(Blueprint)))
+	{
+		return false;
+	}
+
+	FTestBlueprintInstance Instance;
+	if (!InstantiateTestBlueprint(this, Blueprint, ContainerSelectFunctionName, Members, Instance))
+	{
+		return false;
+	}
+	UObject* Object = Instance.Object;
+	FArrayProperty* DefaultProperty = Instance.GetMemberProperty<FArrayProperty>(DefaultArrayVariableName);
+	FArrayProperty* ResultProperty = Instance.GetMemberProperty<FArrayProperty>(ResultArrayVariableName);
+	TArray<FArrayProperty*> OptionProperties;
+	for (int32 Index = 0; Index < CaseCount; ++Index)
+	{
+		OptionProperties.Add(Instance.GetMemberProperty<FArrayProperty>(GetArrayOptionVariableName(Index)));
+	}
+
+	// The selected option is copied to the return value once, and Set reads the return value in place.
+	// An intermediate copy (ex. through the Select node) would add another array to the frame.
+	int32 ArrayLocalCount = 0;
+	for (TFieldIterator<FArrayProperty> It(Instance.Function); It; ++It)
+	{
+		if (!It->HasAnyPropertyFlags(CPF_Parm))
+		{
+			++ArrayLocalCount;
+		}
+	}
+	TestEqual(TEXT("Selected array should be copied only to the return value"), ArrayLocalCount, 1);
+
+	const TArray<int32> DefaultOption = {-1};
+	*DefaultProperty->ContainerPtrToValuePtr<TArray<int32>>(Object) = DefaultOption;
+	for (int32 Index = 0; Index < CaseCount; ++Index)
+	{
+		*OptionProperties[Index]->ContainerPtrToValuePtr<TArray<int32>>(Object) = MakeArrayOption(Index);
+	}
+
+	for (int32 Bits = 0; Bits < (1 << CaseCount); ++Bits)
+	{
+		int32 ExpectedCaseIndex = INDEX_NONE;
+		for (int32 Index = 0; Index < CaseCount; ++Index)
+		{
+			if (((Bits & (1 << Index)) != 0) && (ExpectedCaseIndex == INDEX_NONE))
+			{
+				ExpectedCaseIndex = Index;
+			}
+		}
+		Instance.SetConditions(CaseCount, Bits);
+		ResultProperty->ContainerPtrToValuePtr<TArray<int32>>(Object)->Reset();
+
+		Instance.Call();
+
+		const TArray<int32> Expected = (ExpectedCaseIndex != INDEX_NONE) ? MakeArrayOption(ExpectedCaseIndex) : DefaultOption;
+		TestTrue(FString::Printf(TEXT("Selected array with conditions 0x%x"), Bits),
+			*ResultProperty->ContainerPtrToValuePtr<TArray<int32>>(Object) == Expected);
+	}
+
+	// The options must not be moved out of by the selection.
+	for (int32 Index = 0; Index < CaseCount; ++Index)
+	{
+		TestTrue(FString::Printf(TEXT("Option %d should be kept"), Index),
+			*OptionProperties[Index]->ContainerPtrToValuePtr<TArray<int32>>(Object) == MakeArrayOption(Index));
+	}
+
+	return true;
+}
+
+// Run the element-wise select on the arrays of the element type, whose option Index at the element is MakeElement(Index, Element).
+// The default is MakeElement(-1, Element).
+template <typename ElementType, typename MakeElementType>
+static bool RunElementWiseTest(FAutomationTestBase* AutomationTest, const FString& TypeName, const FEdGraphPinType& ElementPinType,
+	MakeElementType MakeElement)
+{
+	const int32 CaseCount = 3;
+	const int32 ElementCount = 1 << CaseCount;
+
+	FEdGraphPinType ArrayPinType = ElementPinType;
+	ArrayPinType.ContainerType = EPinContainerType::Array;
+	TArray<FTestMemberVariable> Members = MakeCaseMemberVariables(
+		CaseCount, GetConditionVariableName, MakeTestPinType(UEdGraphSchema_K2::PC_Boolean, EPinContainerType::Array));
+	Members.Append(MakeCaseMemberVariables(CaseCount, GetArrayOptionVariableName, ArrayPinType));
+	Members.Add({DefaultArrayVariableName, ArrayPinType});
+	Members.Add({ResultArrayVariableName, ArrayPinType});
+	UBlueprint* Blueprint =
+		CreateTestBlueprintWithMembers(FString::Printf(TEXT("BP_MultiConditionalSelectElementWise_%s"), *TypeName), Members);
+
+	FTestFunctionGraph Function = AddTestFunctionGraph(Blueprint, ElementWiseSelectFunctionName);
+	if (!AutomationTest->TestTrue(FString::Printf(TEXT("%s: Blueprint should be compiled"), *TypeName),
+			(Function.Entry != nullptr) && BuildMultiConditionalSelectArrayFunctionGraph(Blueprint, Function, CaseCount, true) &&
+				CompileTestBlueprint(Blueprint)))
+	{
+		return false;
+	}
+
+	FTestBlueprintInstance Instance;
+	if (!InstantiateTestBlueprint(AutomationTest, Blueprint, ElementWiseSelectFunctionName, Members, Instance))
+	{
+		return false;
+	}
+	UObject* Object = Instance.Object;
+	FArrayProperty* DefaultProperty = Instance.GetMemberProperty<FArrayProperty>(DefaultArrayVariableName);
+	FArrayProperty* ResultProperty = Instance.GetMemberProperty<FArrayProperty>(ResultArrayVariableName);
+
+	// The element Element has the conditions of its bits, so all combinations are tested in one call.
+	// The last option is shorter than the others, so its last element is never selected.
+	TArray<ElementType> DefaultOption;
+	for (int32 Element = 0; Element < ElementCount; ++Element)
+	{
+		DefaultOption.Add(MakeElement(-1, Element));
+	}
+	*DefaultProperty->ContainerPtrToValuePtr<TArray<ElementType>>(Object) = DefaultOption;
+	for (int32 Index = 0; Index < CaseCount; ++Index)
+	{
+		FArrayProperty* ConditionProperty = Instance.GetMemberProperty<FArrayProperty>(GetConditionVariableName(Index));
+		FArrayProperty* OptionProperty = Instance.GetMemberProperty<FArrayProperty>(GetArrayOptionVariableName(Index));
+		TArray<bool>& Conditions = *ConditionProperty->ContainerPtrToValuePtr<TArray<bool>>(Object);
+		TArray<ElementType>& Option = *OptionProperty->ContainerPtrToValuePtr<TArray<ElementType>>(Object);
+		const int32 OptionCount = (Index == CaseCount - 1) ? ElementCount - 1 : ElementCount;
+		for (int32 Element = 0; Element < ElementCount; ++Element)
+		{
+			Conditions.Add((Element & (1 << Index)) != 0);
+			if (Element < OptionCount)
+			{
+				Option.Add(MakeElement(Index, Element));
+			}
+		}
+	}
+
+	Instance.Call();
+
+	const TArray<ElementType>& Result = *ResultProperty->ContainerPtrToValuePtr<TArray<ElementType>>(Object);
+	if (!AutomationTest->TestEqual(FString::Printf(TEXT("%s: Result should have the length of Default"), *TypeName), Result.Num(),
+			ElementCount))
+	{
+		return false;
+	}
+	for (int32 Element = 0; Element < ElementCount; ++Element)
+	{
+		int32 ExpectedCaseIndex = -1;
+		for (int32 Index = 0; Index < CaseCount; ++Index)
+		{
+			const bool bHasOption = (Index != CaseCount - 1) || (Element < ElementCount - 1);
+			if (((Element & (1 << Index)) != 0) && bHasOption)
+			{
+				ExpectedCaseIndex = Index;
+				break;
+			}
+		}
+		AutomationTest->TestTrue(FString::Printf(TEXT("%s: Element %d"), *TypeName, Element),
+			Result[Element] == MakeElement(ExpectedCaseIndex, Element));
+	}
+
+	return true;
+}
+
+bool FFunctionalTestMultiConditionalSelectElementWise::RunTest(const FString& Parameters)
+{
+	// 4 bytes (blended), 24 bytes (copied as the raw bytes) and the type which owns memory.
+	FEdGraphPinType IntPinType;
+	IntPinType.PinCategory = UEdGraphSchema_K2::PC_Int;
+	RunElementWiseTest<int32>(
+		this, TEXT("Int"), IntPinType, [](int32 CaseIndex, int32 Element) { return CaseIndex * 100 + Element; });
+
+	FEdGraphPinType VectorPinType;
+	VectorPinType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+	VectorPinType.PinSubCategoryObject = TBaseStructure<FVector>::Get();
+	RunElementWiseTest<FVector>(this, TEXT("Vector"), VectorPinType,
+		[](int32 CaseIndex, int32 Element) { return FVector(CaseIndex, Element, CaseIndex * Element); });
+
+	FEdGraphPinType StringPinType;
+	StringPinType.PinCategory = UEdGraphSchema_K2::PC_String;
+	RunElementWiseTest<FString>(this, TEXT("String"), StringPinType,
+		[](int32 CaseIndex, int32 Element) { return FString::Printf(TEXT("Case %d Element %d"), CaseIndex, Element); });
+
+	return true;
+}
+
+#endif
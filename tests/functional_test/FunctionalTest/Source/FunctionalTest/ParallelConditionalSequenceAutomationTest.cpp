@@ -0,0 +1,134 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "FunctionalTestThreadSafeLibrary.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "TestBlueprintBuilder.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestParallelConditionalSequence,
+	"AdvancedControlFlow.FunctionalTest.ParallelConditionalSequence",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestParallelConditionalSequenceNotThreadSafe,
+	"AdvancedControlFlow.FunctionalTest.ParallelConditionalSequenceNotThreadSafe",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+static const FName ParallelSequenceFunctionName(TEXT("Test_ParallelSequence"));
+
+static TArray<FTestMemberVariable> MakeParallelConditionalSequenceMembers(int32 CaseCount)
+{
+	TArray<FTestMemberVariable> Members = MakeCaseMemberVariables(
+		CaseCount, GetConditionVariableName, MakeTestPinType(UEdGraphSchema_K2::PC_Boolean));
+	Members.Append(MakeCaseMemberVariables(
+		CaseCount, GetCaseFunctionHitVariableName, MakeTestPinType(UEdGraphSchema_K2::PC_Int)));
+	Members.Add({ResultVariableName, MakeTestPinType(UEdGraphSchema_K2::PC_Int)});
+
+	return Members;
+}
+
+bool FFunctionalTestParallelConditionalSequence::RunTest(const FString& Parameters)
+{
+	// The thread safe cases run on the worker threads and count the calls, and the other cases run on the calling thread and
+	// write the members.
+	const TArray<ETestCaseFunction> CaseFunctions = {ETestCaseFunction::ThreadSafe, ETestCaseFunction::NotThreadSafe,
+		ETestCaseFunction::ThreadSafe, ETestCaseFunction::NotThreadSafe, ETestCaseFunction::ThreadSafe,
+		ETestCaseFunction::ThreadSafe};
+	const int32 CaseCount = CaseFunctions.Num();
+
+	const TArray<FTestMemberVariable> Members = MakeParallelConditionalSequenceMembers(CaseCount);
+	UBlueprint* Blueprint = CreateTestBlueprintWithMembers(TEXT("BP_ParallelConditionalSequence"), Members);
+
+	FTestFunctionGraph Function = AddTestFunctionGraph(Blueprint, ParallelSequenceFunctionName);
+	if (!TestTrue(TEXT("Blueprint should be compiled"),
+			(Function.Entry != nullptr) && BuildParallelConditionalSequenceFunctionGraph(Blueprint, Function, CaseFunctions) &&
+				CompileTestBlueprint(Blueprint)))
+	{
+		return false;
+	}
+
+	// The derived class overrides the thread safe case 0 with the function which is not validated, so it must run on the
+	// calling thread.
+	const int32 OverrideCallKey = CaseCount;
+	UBlueprint* DerivedBlueprint = CreateTestBlueprint(TEXT("BP_ParallelConditionalSequenceDerived"), Blueprint->GeneratedClass);
+	if (!TestTrue(TEXT("Derived Blueprint should be compiled"),
+			BuildCountCallFunctionOverrideGraph(DerivedBlueprint, GetCaseFunctionName(0), OverrideCallKey) &&
+				CompileTestBlueprint(DerivedBlueprint)))
+	{
+		return false;
+	}
+
+	FTestBlueprintInstance Instance;
+	FTestBlueprintInstance DerivedInstance;
+	if (!InstantiateTestBlueprint(this, Blueprint, ParallelSequenceFunctionName, Members, Instance) ||
+		!InstantiateTestBlueprint(this, DerivedBlueprint, ParallelSequenceFunctionName, Members, DerivedInstance))
+	{
+		return false;
+	}
+
+	for (int32 Bits : {0x00, 0x3f, 0x15, 0x2a, 0x21})
+	{
+		UFunctionalTestThreadSafeLibrary::ResetCallCounts();
+		Instance.SetConditions(CaseCount, Bits);
+		for (int32 Index = 0; Index < CaseCount; ++Index)
+		{
+			Instance.GetMemberProperty<FIntProperty>(GetCaseFunctionHitVariableName(Index))
+				->SetPropertyValue_InContainer(Instance.Object, 0);
+		}
+		Instance.SetResult(-1);
+
+		Instance.Call();
+
+		for (int32 Index = 0; Index < CaseCount; ++Index)
+		{
+			const int32 Hit = (CaseFunctions[Index] == ETestCaseFunction::ThreadSafe)
+								  ? UFunctionalTestThreadSafeLibrary::GetCallCount(Index)
+								  : Instance.GetMemberProperty<FIntProperty>(GetCaseFunctionHitVariableName(Index))
+										->GetPropertyValue_InContainer(Instance.Object);
+			TestEqual(
+				FString::Printf(TEXT("Case %d with conditions 0x%x"), Index, Bits), Hit, ((Bits & (1 << Index)) != 0) ? 1 : 0);
+		}
+		TestEqual(FString::Printf(TEXT("Default with conditions 0x%x"), Bits), Instance.GetResult(), CaseCount);
+	}
+
+	UFunctionalTestThreadSafeLibrary::ResetCallCounts();
+	DerivedInstance.SetConditions(CaseCount, 0x01);
+	DerivedInstance.Call();
+	TestEqual(TEXT("Overridden case 0 should be called"), UFunctionalTestThreadSafeLibrary::GetCallCount(OverrideCallKey), 1);
+	TestEqual(TEXT("Overridden case 0 should run on the calling thread"),
+		UFunctionalTestThreadSafeLibrary::GetGameThreadCallCount(OverrideCallKey), 1);
+	TestEqual(TEXT("Original case 0 should not be called"), UFunctionalTestThreadSafeLibrary::GetCallCount(0), 0);
+
+	return true;
+}
+
+bool FFunctionalTestParallelConditionalSequenceNotThreadSafe::RunTest(const FString& Parameters)
+{
+	for (ETestCaseFunction CaseFunction : {ETestCaseFunction::ThreadSafeWritingMember,
+			 ETestCaseFunction::ThreadSafeCallingNotThreadSafe, ETestCaseFunction::ThreadSafeWithParameter})
+	{
+		// The thread safe case is placed next to the valid thread safe case which may run at the same time.
+		const TArray<ETestCaseFunction> CaseFunctions = {ETestCaseFunction::ThreadSafe, CaseFunction};
+
+		UBlueprint* Blueprint = CreateTestBlueprintWithMembers(TEXT("BP_ParallelConditionalSequenceNotThreadSafe"),
+			MakeParallelConditionalSequenceMembers(CaseFunctions.Num()));
+
+		FTestFunctionGraph Function = AddTestFunctionGraph(Blueprint, ParallelSequenceFunctionName);
+		if (!TestTrue(TEXT("Function graph should be built"),
+				(Function.Entry != nullptr) && BuildParallelConditionalSequenceFunctionGraph(Blueprint, Function, CaseFunctions)))
+		{
+			return false;
+		}
+
+		FCompilerResultsLog Results;
+		Results.bSilentMode = true;
+		const FString Context = FString::Printf(TEXT("Case function %d"), static_cast<int32>(CaseFunction));
+		TestFalse(Context + TEXT(" should fail to compile"), CompileTestBlueprint(Blueprint, &Results));
+		TestTrue(Context + TEXT(" should report the error"), Results.NumErrors > 0);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,160 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "TestBlueprintBuilder.h"
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FPerformanceTestMultiBranch, "AdvancedControlFlow.Performance.MultiBranch",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter);
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FPerformanceTestConditionalSequence, "AdvancedControlFlow.Performance.ConditionalSequence",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter);
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FPerformanceTestMultiConditionalSelect, "AdvancedControlFlow.Performance.MultiConditionalSelect",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter);
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FPerformanceTestMultiBranchOnValue, "AdvancedControlFlow.Performance.MultiBranchOnValue",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPerformanceTestFrameSize, "AdvancedControlFlow.Performance.FrameSize",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter);
+
+// Number of the calls can be changed by -ACFBenchmarkIterations=<N>.
+static const int32 DefaultBenchmarkIterations = 100000;
+static const int32 BenchmarkCaseCounts[] = {2, 8, 32, 128};
+
+void GetBenchmarkTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands)
+{
+	for (int32 CaseCount : BenchmarkCaseCounts)
+	{
+		OutBeautifiedNames.Add(FString::Printf(TEXT("Cases%d"), CaseCount));
+		OutTestCommands.Add(FString::FromInt(CaseCount));
+	}
+}
+
+bool RunBenchmark(FAutomationTestBase* AutomationTest, ETestNodeType NodeType, const FString& Parameters)
+{
+	const int32 CaseCount = FCString::Atoi(*Parameters);
+	int32 Iterations = DefaultBenchmarkIterations;
+	FParse::Value(FCommandLine::Get(), TEXT("ACFBenchmarkIterations="), Iterations);
+
+	UBlueprint* Blueprint = BuildBenchmarkBlueprint(NodeType, CaseCount);
+	if (!AutomationTest->TestNotNull(TEXT("Benchmark Blueprint should be compiled"), Blueprint))
+	{
+		return false;
+	}
+
+	UClass* GeneratedClass = Blueprint->GeneratedClass;
+	UObject* Object = NewObject<UObject>(GetTransientPackage(), GeneratedClass);
+
+	for (const FName& FunctionName : {BenchmarkPluginFunctionName, BenchmarkVanillaFunctionName})
+	{
+		UFunction* Function = GeneratedClass->FindFunctionByName(FunctionName);
+		if (!AutomationTest->TestNotNull(TEXT("Benchmark function should exist"), Function))
+		{
+			return false;
+		}
+
+		// Warm up
+		Object->ProcessEvent(Function, nullptr);
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < Iterations; ++Index)
+		{
+			Object->ProcessEvent(Function, nullptr);
+		}
+		const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+		const double NsPerCall = ElapsedTime * 1.0e9 / FMath::Max(Iterations, 1);
+		const FString Context =
+			FString::Printf(TEXT("%s.%s.Cases%d"), *GetTestNodeTypeName(NodeType), *FunctionName.ToString(), CaseCount);
+
+		AutomationTest->AddInfo(FString::Printf(TEXT("%s: %.2f ns/call, bytecode %d bytes, frame %d bytes"), *Context, NsPerCall,
+			Function->Script.Num(), Function->PropertiesSize));
+		AutomationTest->AddTelemetryData(TEXT("NsPerCall"), NsPerCall, Context);
+		AutomationTest->AddTelemetryData(TEXT("BytecodeSize"), Function->Script.Num(), Context);
+		AutomationTest->AddTelemetryData(TEXT("FrameSize"), Function->PropertiesSize, Context);
+	}
+
+	return true;
+}
+
+void FPerformanceTestMultiBranch::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	GetBenchmarkTests(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FPerformanceTestMultiBranch::RunTest(const FString& Parameters)
+{
+	return RunBenchmark(this, ETestNodeType::MultiBranch, Parameters);
+}
+
+void FPerformanceTestConditionalSequence::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	GetBenchmarkTests(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FPerformanceTestConditionalSequence::RunTest(const FString& Parameters)
+{
+	return RunBenchmark(this, ETestNodeType::ConditionalSequence, Parameters);
+}
+
+void FPerformanceTestMultiConditionalSelect::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	GetBenchmarkTests(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FPerformanceTestMultiConditionalSelect::RunTest(const FString& Parameters)
+{
+	return RunBenchmark(this, ETestNodeType::MultiConditionalSelect, Parameters);
+}
+
+void FPerformanceTestMultiBranchOnValue::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	GetBenchmarkTests(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FPerformanceTestMultiBranchOnValue::RunTest(const FString& Parameters)
+{
+	return RunBenchmark(this, ETestNodeType::MultiBranchOnValue, Parameters);
+}
+
+bool FPerformanceTestFrameSize::RunTest(const FString& Parameters)
+{
+	// The comparison result is stored to the scratch terminal shared in the function, so the frame size must not grow with the
+	// number of the nodes.
+	TArray<int32> FrameSizes;
+	for (int32 NodeCount : {1, 30})
+	{
+		UBlueprint* Blueprint = CreateTestBlueprint(FString::Printf(TEXT("BP_FrameSize_%d"), NodeCount));
+		FEdGraphPinType IntPinType;
+		IntPinType.PinCategory = UEdGraphSchema_K2::PC_Int;
+		FBlueprintEditorUtils::AddMemberVariable(Blueprint, TEXT("Result"), IntPinType);
+		FBlueprintEditorUtils::AddMemberVariable(Blueprint, SelectionVariableName, IntPinType);
+
+		FTestFunctionGraph Function = AddTestFunctionGraph(Blueprint, BenchmarkPluginFunctionName);
+		if (!TestTrue(TEXT("Benchmark Blueprint should be compiled"),
+				(Function.Entry != nullptr) && BuildMultiBranchOnValueChainFunctionGraph(Blueprint, Function, NodeCount, 4) &&
+					CompileTestBlueprint(Blueprint)))
+		{
+			return false;
+		}
+
+		UFunction* CompiledFunction = Blueprint->GeneratedClass->FindFunctionByName(BenchmarkPluginFunctionName);
+		if (!TestNotNull(TEXT("Benchmark function should exist"), CompiledFunction))
+		{
+			return false;
+		}
+
+		const FString Context = FString::Printf(TEXT("MultiBranchOnValue.Nodes%d"), NodeCount);
+		AddInfo(FString::Printf(TEXT("%s: frame %d bytes"), *Context, CompiledFunction->PropertiesSize));
+		AddTelemetryData(TEXT("FrameSize"), CompiledFunction->PropertiesSize, Context);
+		FrameSizes.Add(CompiledFunction->PropertiesSize);
+	}
+
+	return TestEqual(TEXT("Frame size should not grow with the number of nodes"), FrameSizes.Last(), FrameSizes[0]);
+}
+
+#endif
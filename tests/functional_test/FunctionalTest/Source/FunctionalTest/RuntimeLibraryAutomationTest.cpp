@@ -0,0 +1,81 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+
+#include "AdvancedControlFlowLibrary.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestFindLowestSetBit,
+	"AdvancedControlFlow.FunctionalTest.RuntimeLibrary.FindLowestSetBit",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFunctionalTestSelectArrayElements,
+	"AdvancedControlFlow.FunctionalTest.RuntimeLibrary.SelectArrayElements",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FFunctionalTestFindLowestSetBit::RunTest(const FString& Parameters)
+{
+	TestEqual(TEXT("No bits"), UAdvancedControlFlowLibrary::FindLowestSetBit(0, -1), -1);
+	TestEqual(TEXT("Masked out bits"), UAdvancedControlFlowLibrary::FindLowestSetBit(0x0f, 0xf0), -1);
+	TestEqual(TEXT("Lowest bit"), UAdvancedControlFlowLibrary::FindLowestSetBit(0x0c, -1), 2);
+	TestEqual(TEXT("Lowest masked bit"), UAdvancedControlFlowLibrary::FindLowestSetBit(0x0c, 0x08), 3);
+	TestEqual(TEXT("Sign bit"), UAdvancedControlFlowLibrary::FindLowestSetBit(MIN_int32, -1), 31);
+	TestEqual(TEXT("No bits (64)"), UAdvancedControlFlowLibrary::FindLowestSetBit64(0, -1), -1);
+	TestEqual(TEXT("Upper bit (64)"), UAdvancedControlFlowLibrary::FindLowestSetBit64(int64(1) << 40, -1), 40);
+	TestEqual(TEXT("Sign bit (64)"), UAdvancedControlFlowLibrary::FindLowestSetBit64(MIN_int64, -1), 63);
+
+	return true;
+}
+
+bool FFunctionalTestSelectArrayElements::RunTest(const FString& Parameters)
+{
+	UFunction* Function = UAdvancedControlFlowLibrary::StaticClass()->FindFunctionByName(TEXT("SelectArrayElements"));
+	if (!TestNotNull(TEXT("SelectArrayElements should exist"), Function))
+	{
+		return false;
+	}
+
+	FArrayProperty* ResultProperty = FindFProperty<FArrayProperty>(Function, TEXT("Result"));
+	FArrayProperty* ConditionsProperty = FindFProperty<FArrayProperty>(Function, TEXT("Conditions"));
+	FArrayProperty* OptionsProperty = FindFProperty<FArrayProperty>(Function, TEXT("Options"));
+	if ((ResultProperty == nullptr) || (ConditionsProperty == nullptr) || (OptionsProperty == nullptr))
+	{
+		AddError(TEXT("SelectArrayElements does not have the expected parameters"));
+		return false;
+	}
+
+	// Only the elements in all arrays are selected, and the length of Result is kept.
+	struct FCase
+	{
+		const TCHAR* Name;
+		TArray<bool> Conditions;
+		TArray<int32> Options;
+		TArray<int32> Expected;
+	};
+	const TArray<int32> Result = {-1, -2, -3, -4};
+	const FCase Cases[] = {
+		{TEXT("Same lengths"), {true, false, true, false}, {10, 20, 30, 40}, {10, -2, 30, -4}},
+		{TEXT("Short conditions"), {true, true}, {10, 20, 30, 40}, {10, 20, -3, -4}},
+		{TEXT("Short options"), {true, true, true, true}, {10}, {10, -2, -3, -4}},
+		{TEXT("Long arrays"), {false, true, false, true, true}, {10, 20, 30, 40, 50}, {-1, 20, -3, 40}},
+		{TEXT("Empty arrays"), {}, {}, {-1, -2, -3, -4}},
+	};
+
+	UObject* Library = UAdvancedControlFlowLibrary::StaticClass()->GetDefaultObject();
+	for (const FCase& Case : Cases)
+	{
+		uint8* Params = static_cast<uint8*>(FMemory_AllocaAligned(Function->ParmsSize, Function->GetMinAlignment()));
+		Function->InitializeStruct(Params);
+
+		*ResultProperty->ContainerPtrToValuePtr<TArray<int32>>(Params) = Result;
+		*ConditionsProperty->ContainerPtrToValuePtr<TArray<bool>>(Params) = Case.Conditions;
+		*OptionsProperty->ContainerPtrToValuePtr<TArray<int32>>(Params) = Case.Options;
+		Library->ProcessEvent(Function, Params);
+
+		TestTrue(Case.Name, *ResultProperty->ContainerPtrToValuePtr<TArray<int32>>(Params) == Case.Expected);
+
+		Function->DestroyStruct(Params);
+	}
+
+	return true;
+}
+
+#endif
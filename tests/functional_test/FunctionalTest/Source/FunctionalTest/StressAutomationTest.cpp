@@ -0,0 +1,100 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+
+#include "BlueprintCompilationManager.h"
+#include "Engine/Blueprint.h"
+#include "TestBlueprintBuilder.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStressTestBatchCompile, "AdvancedControlFlow.Stress.BatchCompile",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::StressFilter);
+
+static const int32 StressCopyCount = 8;
+static const int32 StressCaseCount = 16;
+static const int32 StressCompileRounds = 2;
+
+// Compile all Blueprints in one batch, so that the compiler contexts of every Blueprint are alive at the same time.
+static void CompileBlueprintsInBatch(const TArray<UBlueprint*>& Blueprints)
+{
+	for (UBlueprint* Blueprint : Blueprints)
+	{
+		FBlueprintCompilationManager::QueueForCompilation(Blueprint);
+	}
+	FBlueprintCompilationManager::FlushCompilationQueueAndReinstance();
+}
+
+bool FStressTestBatchCompile::RunTest(const FString& Parameters)
+{
+	const ETestNodeType NodeTypes[] = {ETestNodeType::MultiBranch, ETestNodeType::ConditionalSequence,
+		ETestNodeType::MultiConditionalSelect, ETestNodeType::MultiBranchOnValue};
+
+	TArray<UBlueprint*> Blueprints;
+	for (ETestNodeType NodeType : NodeTypes)
+	{
+		for (int32 Index = 0; Index < StressCopyCount; ++Index)
+		{
+			UBlueprint* Blueprint = CreateBenchmarkBlueprint(NodeType, StressCaseCount);
+			if (!TestNotNull(TEXT("Stress Blueprint should be built"), Blueprint))
+			{
+				return false;
+			}
+			Blueprints.Add(Blueprint);
+		}
+	}
+
+	// Bytecode can not be compared byte by byte because it embeds the property addresses, so the sizes are compared instead.
+	TMap<FString, TPair<int32, int32>> ExpectedSizes;
+	for (int32 Round = 0; Round < StressCompileRounds; ++Round)
+	{
+		CompileBlueprintsInBatch(Blueprints);
+
+		for (int32 BlueprintIndex = 0; BlueprintIndex < Blueprints.Num(); ++BlueprintIndex)
+		{
+			UBlueprint* Blueprint = Blueprints[BlueprintIndex];
+			const ETestNodeType NodeType = NodeTypes[BlueprintIndex / StressCopyCount];
+			if (!TestTrue(TEXT("Stress Blueprint should be compiled"), Blueprint->Status != BS_Error))
+			{
+				return false;
+			}
+
+			UClass* GeneratedClass = Blueprint->GeneratedClass;
+			UObject* Object = NewObject<UObject>(GetTransientPackage(), GeneratedClass);
+			FIntProperty* ResultProperty = FindFProperty<FIntProperty>(GeneratedClass, ResultVariableName);
+			if (!TestNotNull(TEXT("Generated class should have the result variable"), ResultProperty))
+			{
+				return false;
+			}
+
+			for (const FName& FunctionName : {BenchmarkPluginFunctionName, BenchmarkVanillaFunctionName})
+			{
+				UFunction* Function = GeneratedClass->FindFunctionByName(FunctionName);
+				if (!TestNotNull(TEXT("Stress function should exist"), Function))
+				{
+					return false;
+				}
+
+				const FString Context = FString::Printf(TEXT("%s.%s"), *GetTestNodeTypeName(NodeType), *FunctionName.ToString());
+
+				ResultProperty->SetPropertyValue_InContainer(Object, -2);
+				Object->ProcessEvent(Function, nullptr);
+				TestEqual(FString::Printf(TEXT("%s: Result (Round %d)"), *Context, Round),
+					ResultProperty->GetPropertyValue_InContainer(Object), StressCaseCount - 1);
+
+				const TPair<int32, int32> Sizes(Function->Script.Num(), Function->PropertiesSize);
+				if (const TPair<int32, int32>* Expected = ExpectedSizes.Find(Context))
+				{
+					TestEqual(FString::Printf(TEXT("%s: Bytecode size (Round %d)"), *Context, Round), Sizes.Key, Expected->Key);
+					TestEqual(FString::Printf(TEXT("%s: Frame size (Round %d)"), *Context, Round), Sizes.Value, Expected->Value);
+				}
+				else
+				{
+					ExpectedSizes.Add(Context, Sizes);
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,1077 @@
+#include "TestBlueprintBuilder.h"
+
+#if WITH_EDITOR
+
+#include "EdGraph/EdGraph.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "FunctionalTestThreadSafeLibrary.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_ConditionalSequence.h"
+#include "K2Node_CustomEvent.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_MultiBranch.h"
+#include "K2Node_MultiBranchOnBitmask.h"
+#include "K2Node_MultiBranchOnChange.h"
+#include "K2Node_MultiBranchOnName.h"
+#include "K2Node_MultiBranchOnValue.h"
+#include "K2Node_MultiConditionalSelect.h"
+#include "K2Node_ParallelConditionalSequence.h"
+#include "K2Node_Select.h"
+#include "K2Node_SwitchInteger.h"
+#include "K2Node_SwitchName.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/AutomationTest.h"
+
+const FName BenchmarkPluginFunctionName(TEXT("Bench_Plugin"));
+const FName BenchmarkVanillaFunctionName(TEXT("Bench_Vanilla"));
+
+static const FName DispatchTableFunctionName(TEXT("Test_Dispatch"));
+
+const FName ResultVariableName(TEXT("Result"));
+const FName DefaultValueVariableName(TEXT("DefaultValue"));
+const FName SelectionVariableName(TEXT("Selection"));
+const FName DefaultArrayVariableName(TEXT("DefaultArray"));
+const FName ResultArrayVariableName(TEXT("ResultArray"));
+
+FName GetConditionVariableName(int32 CaseIndex)
+{
+	return *FString::Printf(TEXT("Cond_%d"), CaseIndex);
+}
+
+FName GetArrayOptionVariableName(int32 CaseIndex)
+{
+	return *FString::Printf(TEXT("ArrayOption_%d"), CaseIndex);
+}
+
+FName GetCaseFunctionName(int32 CaseIndex)
+{
+	return *FString::Printf(TEXT("CaseFunction_%d"), CaseIndex);
+}
+
+FName GetCaseFunctionHitVariableName(int32 CaseIndex)
+{
+	return *FString::Printf(TEXT("Hit_%d"), CaseIndex);
+}
+
+template <typename NodeType>
+static NodeType* SpawnTestNode(UEdGraph* Graph)
+{
+	FGraphNodeCreator<NodeType> NodeCreator(*Graph);
+	NodeType* Node = NodeCreator.CreateNode(false);
+	NodeCreator.Finalize();
+
+	return Node;
+}
+
+static UEdGraphPin* SpawnVariableGet(UEdGraph* Graph, const FName& VariableName)
+{
+	FGraphNodeCreator<UK2Node_VariableGet> NodeCreator(*Graph);
+	UK2Node_VariableGet* Node = NodeCreator.CreateNode(false);
+	Node->VariableReference.SetSelfMember(VariableName);
+	NodeCreator.Finalize();
+
+	return Node->FindPin(VariableName, EGPD_Output);
+}
+
+static UK2Node_VariableSet* SpawnIntVariableSet(UEdGraph* Graph, const FName& VariableName, int32 Value)
+{
+	FGraphNodeCreator<UK2Node_VariableSet> NodeCreator(*Graph);
+	UK2Node_VariableSet* Node = NodeCreator.CreateNode(false);
+	Node->VariableReference.SetSelfMember(VariableName);
+	NodeCreator.Finalize();
+
+	UEdGraphPin* ValuePin = Node->FindPinChecked(VariableName, EGPD_Input);
+	GetDefault<UEdGraphSchema_K2>()->TrySetDefaultValue(*ValuePin, FString::FromInt(Value));
+
+	return Node;
+}
+
+static UK2Node_VariableSet* SpawnResultVariableSet(UEdGraph* Graph, int32 Value)
+{
+	return SpawnIntVariableSet(Graph, ResultVariableName, Value);
+}
+
+static bool Connect(UEdGraphPin* A, UEdGraphPin* B)
+{
+	if ((A == nullptr) || (B == nullptr))
+	{
+		return false;
+	}
+
+	return GetDefault<UEdGraphSchema_K2>()->TryCreateConnection(A, B);
+}
+
+// Bit of the case Index of the benchmark Multi-Branch on Bitmask. The later cases of the same bit are never executed.
+static int32 GetBenchmarkCaseBit(int32 CaseIndex)
+{
+	return CaseIndex % 32;
+}
+
+// Key of the case Index of the benchmark Multi-Branch on Name.
+static FName GetBenchmarkCaseKey(int32 CaseIndex)
+{
+	return *FString::Printf(TEXT("Case_%d"), CaseIndex);
+}
+
+FString GetTestNodeTypeName(ETestNodeType NodeType)
+{
+	switch (NodeType)
+	{
+		case ETestNodeType::MultiBranch:
+			return TEXT("MultiBranch");
+		case ETestNodeType::ConditionalSequence:
+			return TEXT("ConditionalSequence");
+		case ETestNodeType::MultiConditionalSelect:
+			return TEXT("MultiConditionalSelect");
+		case ETestNodeType::MultiBranchOnValue:
+			return TEXT("MultiBranchOnValue");
+		case ETestNodeType::MultiBranchOnBitmask:
+			return TEXT("MultiBranchOnBitmask");
+		case ETestNodeType::MultiBranchOnName:
+			return TEXT("MultiBranchOnName");
+		case ETestNodeType::ParallelConditionalSequence:
+			return TEXT("ParallelConditionalSequence");
+	}
+
+	return TEXT("Unknown");
+}
+
+UBlueprint* CreateTestBlueprint(const FString& Name, UClass* ParentClass)
+{
+	UPackage* Package = GetTransientPackage();
+	FName BlueprintName = MakeUniqueObjectName(Package, UBlueprint::StaticClass(), *Name);
+
+	return FKismetEditorUtilities::CreateBlueprint(ParentClass, Package, BlueprintName, BPTYPE_Normal,
+		UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+}
+
+FTestFunctionGraph AddTestFunctionGraph(UBlueprint* Blueprint, const FName& FunctionName)
+{
+	FTestFunctionGraph Function;
+
+	Function.Graph = FBlueprintEditorUtils::CreateNewGraph(
+		Blueprint, FunctionName, UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
+	FBlueprintEditorUtils::AddFunctionGraph<UClass>(Blueprint, Function.Graph, true, nullptr);
+
+	for (UEdGraphNode* Node : Function.Graph->Nodes)
+	{
+		if (UK2Node_FunctionEntry* Entry = Cast<UK2Node_FunctionEntry>(Node))
+		{
+			Function.Entry = Entry;
+			break;
+		}
+	}
+
+	return Function;
+}
+
+bool CompileTestBlueprint(UBlueprint* Blueprint, FCompilerResultsLog* OutResults)
+{
+	FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection, OutResults);
+
+	return Blueprint->Status != BS_Error;
+}
+
+FEdGraphPinType MakeTestPinType(const FName& PinCategory, EPinContainerType ContainerType)
+{
+	FEdGraphPinType PinType;
+	PinType.PinCategory = PinCategory;
+	PinType.ContainerType = ContainerType;
+
+	return PinType;
+}
+
+TArray<FTestMemberVariable> MakeCaseMemberVariables(int32 CaseCount, FName (*GetName)(int32), const FEdGraphPinType& PinType)
+{
+	TArray<FTestMemberVariable> Members;
+	for (int32 Index = 0; Index < CaseCount; ++Index)
+	{
+		Members.Add({GetName(Index), PinType});
+	}
+
+	return Members;
+}
+
+UBlueprint* CreateTestBlueprintWithMembers(const FString& Name, const TArray<FTestMemberVariable>& Members, UClass* ParentClass)
+{
+	UBlueprint* Blueprint = CreateTestBlueprint(Name, ParentClass);
+	if (Blueprint == nullptr)
+	{
+		return nullptr;
+	}
+
+	for (const FTestMemberVariable& Member : Members)
+	{
+		FBlueprintEditorUtils::AddMemberVariable(Blueprint, Member.Name, Member.PinType, Member.DefaultValue);
+	}
+
+	return Blueprint;
+}
+
+void FTestBlueprintInstance::SetConditions(int32 CaseCount, int32 Bits) const
+{
+	for (int32 Index = 0; Index < CaseCount; ++Index)
+	{
+		GetMemberProperty<FBoolProperty>(GetConditionVariableName(Index))
+			->SetPropertyValue_InContainer(Object, (Bits & (1 << Index)) != 0);
+	}
+}
+
+void FTestBlueprintInstance::SetSelection(int32 Selection) const
+{
+	GetMemberProperty<FIntProperty>(SelectionVariableName)->SetPropertyValue_InContainer(Object, Selection);
+}
+
+void FTestBlueprintInstance::SetSelection(const FString& Selection) const
+{
+	FProperty* SelectionProperty = GetMemberProperty<FProperty>(SelectionVariableName);
+	if (FNameProperty* NameProperty = CastField<FNameProperty>(SelectionProperty))
+	{
+		NameProperty->SetPropertyValue_InContainer(Object, FName(*Selection));
+	}
+	else
+	{
+		CastFieldChecked<FStrProperty>(SelectionProperty)->SetPropertyValue_InContainer(Object, Selection);
+	}
+}
+
+int32 FTestBlueprintInstance::GetResult() const
+{
+	return GetMemberProperty<FIntProperty>(ResultVariableName)->GetPropertyValue_InContainer(Object);
+}
+
+void FTestBlueprintInstance::SetResult(int32 Result) const
+{
+	GetMemberProperty<FIntProperty>(ResultVariableName)->SetPropertyValue_InContainer(Object, Result);
+}
+
+void FTestBlueprintInstance::Call() const
+{
+	Object->ProcessEvent(Function, nullptr);
+}
+
+bool InstantiateTestBlueprint(FAutomationTestBase* AutomationTest, UBlueprint* Blueprint, const FName& FunctionName,
+	const TArray<FTestMemberVariable>& Members, FTestBlueprintInstance& OutInstance)
+{
+	UClass* GeneratedClass = Blueprint->GeneratedClass;
+	UFunction* Function = (GeneratedClass != nullptr) ? GeneratedClass->FindFunctionByName(FunctionName) : nullptr;
+	bool bHasMembers = (Function != nullptr);
+	for (const FTestMemberVariable& Member : Members)
+	{
+		bHasMembers &= (GeneratedClass != nullptr) && (FindFProperty<FProperty>(GeneratedClass, Member.Name) != nullptr);
+	}
+	if (!bHasMembers)
+	{
+		AutomationTest->AddError(TEXT("Generated class does not have the test members"));
+		return false;
+	}
+
+	OutInstance.Object = NewObject<UObject>(GetTransientPackage(), GeneratedClass);
+	OutInstance.Function = Function;
+
+	return true;
+}
+
+bool RunTestDispatchTable(FAutomationTestBase* AutomationTest, const FTestDispatchTable& Table, FCompilerResultsLog* OutResults,
+	UBlueprint** OutBlueprint)
+{
+	UBlueprint* Blueprint = CreateTestBlueprintWithMembers(Table.BlueprintName, Table.Members);
+	if (!AutomationTest->TestNotNull(FString::Printf(TEXT("%s: Blueprint should be created"), *Table.BlueprintName), Blueprint))
+	{
+		return false;
+	}
+
+	FTestFunctionGraph Function = AddTestFunctionGraph(Blueprint, DispatchTableFunctionName);
+	if (!AutomationTest->TestTrue(FString::Printf(TEXT("%s: Function graph should be built"), *Table.BlueprintName),
+			(Function.Entry != nullptr) && Table.BuildFunctionGraph(Blueprint, Function)))
+	{
+		return false;
+	}
+	for (int32 Compile = 0; Compile < Table.CompileCount; ++Compile)
+	{
+		if (!AutomationTest->TestTrue(FString::Printf(TEXT("%s: Blueprint should be compiled"), *Table.BlueprintName),
+				CompileTestBlueprint(Blueprint, OutResults)))
+		{
+			return false;
+		}
+	}
+	if (OutBlueprint != nullptr)
+	{
+		*OutBlueprint = Blueprint;
+	}
+
+	FTestBlueprintInstance Instance;
+	if (!InstantiateTestBlueprint(AutomationTest, Blueprint, DispatchTableFunctionName, Table.Members, Instance))
+	{
+		return false;
+	}
+	for (int32 InputIndex = 0; InputIndex < Table.InputCount; ++InputIndex)
+	{
+		const FString Input = Table.SetInput(Instance, InputIndex);
+		Instance.SetResult(Table.InitialResult);
+		Instance.Call();
+
+		AutomationTest->TestEqual(FString::Printf(TEXT("%s: Result for %s"), *Table.BlueprintName, *Input), Instance.GetResult(),
+			Table.GetExpectedResult(InputIndex));
+	}
+
+	return true;
+}
+
+bool BuildPluginFunctionGraph(UBlueprint* Blueprint, const FTestFunctionGraph& Function, ETestNodeType NodeType, int32 CaseCount)
+{
+	UEdGraph* Graph = Function.Graph;
+	UEdGraphPin* EntryThenPin = Function.Entry->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+	bool bSucceeded = true;
+
+	switch (NodeType)
+	{
+		case ETestNodeType::MultiBranch:
+		{
+			UK2Node_MultiBranch* MultiBranch = SpawnTestNode<UK2Node_MultiBranch>(Graph);
+			for (int32 Index = 0; Index < CaseCount; ++Index)
+			{
+				MultiBranch->AddCasePinLast();
+			}
+
+			bSucceeded &= Connect(EntryThenPin, MultiBranch->GetExecPin());
+			TArray<CasePinPair> CasePairs = MultiBranch->GetCasePinPairs();
+			for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+			{
+				bSucceeded &= Connect(SpawnVariableGet(Graph, GetConditionVariableName(Index)), CasePairs[Index].Key);
+				bSucceeded &= Connect(CasePairs[Index].Value, SpawnResultVariableSet(Graph, Index)->GetExecPin());
+			}
+			break;
+		}
+		case ETestNodeType::ConditionalSequence:
+		{
+			UK2Node_ConditionalSequence* ConditionalSequence = SpawnTestNode<UK2Node_ConditionalSequence>(Graph);
+			for (int32 Index = 0; Index < CaseCount; ++Index)
+			{
+				ConditionalSequence->AddCasePinLast();
+			}
+
+			bSucceeded &= Connect(EntryThenPin, ConditionalSequence->GetExecPin());
+			TArray<CasePinPair> CasePairs = ConditionalSequence->GetCasePinPairs();
+			for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+			{
+				bSucceeded &= Connect(SpawnVariableGet(Graph, GetConditionVariableName(Index)), CasePairs[Index].Key);
+				bSucceeded &= Connect(CasePairs[Index].Value, SpawnResultVariableSet(Graph, Index)->GetExecPin());
+			}
+			break;
+		}
+		case ETestNodeType::MultiConditionalSelect:
+		{
+			UK2Node_MultiConditionalSelect* MultiConditionalSelect = SpawnTestNode<UK2Node_MultiConditionalSelect>(Graph);
+			for (int32 Index = MultiConditionalSelect->GetCasePinCount(); Index < CaseCount; ++Index)
+			{
+				MultiConditionalSelect->AddCasePinLast();
+			}
+
+			// Wildcard pins are resolved to int by the first connection.
+			bSucceeded &= Connect(SpawnVariableGet(Graph, DefaultValueVariableName), MultiConditionalSelect->GetDefaultOptionPin());
+			TArray<CasePinPair> CasePairs = MultiConditionalSelect->GetCasePinPairs();
+			for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+			{
+				GetDefault<UEdGraphSchema_K2>()->TrySetDefaultValue(*CasePairs[Index].Key, FString::FromInt(Index));
+				bSucceeded &= Connect(SpawnVariableGet(Graph, GetConditionVariableName(Index)), CasePairs[Index].Value);
+			}
+
+			UK2Node_VariableSet* ResultSet = SpawnResultVariableSet(Graph, 0);
+			bSucceeded &= Connect(EntryThenPin, ResultSet->GetExecPin());
+			bSucceeded &=
+				Connect(MultiConditionalSelect->GetReturnValuePin(), ResultSet->FindPinChecked(ResultVariableName, EGPD_Input));
+			break;
+		}
+		case ETestNodeType::MultiBranchOnValue:
+		{
+			TArray<int32> Keys;
+			for (int32 Index = 0; Index < CaseCount; ++Index)
+			{
+				Keys.Add(Index);
+			}
+			bSucceeded &= BuildMultiBranchOnValueFunctionGraph(Blueprint, Function, EMultiBranchOnValueCompareMode::Equal, Keys);
+			break;
+		}
+		case ETestNodeType::MultiBranchOnBitmask:
+		{
+			TArray<int32> Bits;
+			for (int32 Index = 0; Index < CaseCount; ++Index)
+			{
+				Bits.Add(GetBenchmarkCaseBit(Index));
+			}
+			bSucceeded &= BuildMultiBranchOnBitmaskFunctionGraph(Blueprint, Function, Bits);
+			break;
+		}
+		case ETestNodeType::MultiBranchOnName:
+		{
+			TArray<FString> Keys;
+			for (int32 Index = 0; Index < CaseCount; ++Index)
+			{
+				Keys.Add(GetBenchmarkCaseKey(Index).ToString());
+			}
+			bSucceeded &= BuildMultiBranchOnNameFunctionGraph(Blueprint, Function, Keys);
+			break;
+		}
+		case ETestNodeType::ParallelConditionalSequence:
+		{
+			TArray<ETestCaseFunction> CaseFunctions;
+			CaseFunctions.Init(ETestCaseFunction::ThreadSafe, CaseCount);
+			bSucceeded &= BuildParallelConditionalSequenceFunctionGraph(Blueprint, Function, CaseFunctions);
+			break;
+		}
+	}
+
+	return bSucceeded;
+}
+
+bool BuildMultiBranchOnValueFunctionGraph(UBlueprint* Blueprint, const FTestFunctionGraph& Function,
+	EMultiBranchOnValueCompareMode CompareMode, const TArray<int32>& Keys)
+{
+	UEdGraph* Graph = Function.Graph;
+	UEdGraphPin* EntryThenPin = Function.Entry->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+	bool bSucceeded = true;
+
+	UK2Node_MultiBranchOnValue* MultiBranchOnValue = SpawnTestNode<UK2Node_MultiBranchOnValue>(Graph);
+	MultiBranchOnValue->CompareMode = CompareMode;
+	MultiBranchOnValue->ReconstructNode();
+	for (int32 Index = 0; Index < Keys.Num(); ++Index)
+	{
+		MultiBranchOnValue->AddCasePinLast();
+	}
+
+	// Wildcard pins are resolved to int by the connection.
+	bSucceeded &= Connect(EntryThenPin, MultiBranchOnValue->GetExecPin());
+	bSucceeded &= Connect(SpawnVariableGet(Graph, SelectionVariableName), MultiBranchOnValue->GetSelectionPin());
+	TArray<CasePinPair> CasePairs = MultiBranchOnValue->GetCasePinPairs();
+	for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+	{
+		GetDefault<UEdGraphSchema_K2>()->TrySetDefaultValue(*CasePairs[Index].Key, FString::FromInt(Keys[Index]));
+		bSucceeded &= Connect(CasePairs[Index].Value, SpawnResultVariableSet(Graph, Index)->GetExecPin());
+	}
+	bSucceeded &= Connect(MultiBranchOnValue->GetDefaultExecPin(), SpawnResultVariableSet(Graph, -1)->GetExecPin());
+
+	return bSucceeded;
+}
+
+bool BuildMultiConditionalSelectArrayFunctionGraph(
+	UBlueprint* Blueprint, const FTestFunctionGraph& Function, int32 CaseCount, bool bElementWise)
+{
+	UEdGraph* Graph = Function.Graph;
+	UEdGraphPin* EntryThenPin = Function.Entry->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+	bool bSucceeded = true;
+
+	UK2Node_MultiConditionalSelect* MultiConditionalSelect = SpawnTestNode<UK2Node_MultiConditionalSelect>(Graph);
+	MultiConditionalSelect->bElementWise = bElementWise;
+	MultiConditionalSelect->ReconstructNode();
+	for (int32 Index = MultiConditionalSelect->GetCasePinCount(); Index < CaseCount; ++Index)
+	{
+		MultiConditionalSelect->AddCasePinLast();
+	}
+
+	// Wildcard pins are resolved to the array by the first connection.
+	bSucceeded &= Connect(SpawnVariableGet(Graph, DefaultArrayVariableName), MultiConditionalSelect->GetDefaultOptionPin());
+	TArray<CasePinPair> CasePairs = MultiConditionalSelect->GetCasePinPairs();
+	for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+	{
+		bSucceeded &= Connect(SpawnVariableGet(Graph, GetArrayOptionVariableName(Index)), CasePairs[Index].Key);
+		bSucceeded &= Connect(SpawnVariableGet(Graph, GetConditionVariableName(Index)), CasePairs[Index].Value);
+	}
+
+	FGraphNodeCreator<UK2Node_VariableSet> NodeCreator(*Graph);
+	UK2Node_VariableSet* ResultSet = NodeCreator.CreateNode(false);
+	ResultSet->VariableReference.SetSelfMember(ResultArrayVariableName);
+	NodeCreator.Finalize();
+	bSucceeded &= Connect(EntryThenPin, ResultSet->GetExecPin());
+	bSucceeded &=
+		Connect(MultiConditionalSelect->GetReturnValuePin(), ResultSet->FindPinChecked(ResultArrayVariableName, EGPD_Input));
+
+	return bSucceeded;
+}
+
+bool BuildLiteralConditionFunctionGraph(
+	UBlueprint* Blueprint, const FTestFunctionGraph& Function, ETestNodeType NodeType, const TArray<FString>& Conditions)
+{
+	UEdGraph* Graph = Function.Graph;
+	UEdGraphPin* EntryThenPin = Function.Entry->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+	bool bSucceeded = true;
+
+	auto ConnectCondition = [&](int32 Index, UEdGraphPin* CondPin) {
+		if (Conditions[Index].IsEmpty())
+		{
+			bSucceeded &= Connect(SpawnVariableGet(Graph, GetConditionVariableName(Index)), CondPin);
+		}
+		else
+		{
+			GetDefault<UEdGraphSchema_K2>()->TrySetDefaultValue(*CondPin, Conditions[Index]);
+		}
+	};
+
+	switch (NodeType)
+	{
+		case ETestNodeType::MultiBranch:
+		case ETestNodeType::ConditionalSequence:
+		{
+			UK2Node_CasePairedPinsNode* Node = nullptr;
+			UEdGraphPin* DefaultExecPin = nullptr;
+			if (NodeType == ETestNodeType::MultiBranch)
+			{
+				UK2Node_MultiBranch* MultiBranch = SpawnTestNode<UK2Node_MultiBranch>(Graph);
+				DefaultExecPin = MultiBranch->GetDefaultExecPin();
+				Node = MultiBranch;
+			}
+			else
+			{
+				UK2Node_ConditionalSequence* ConditionalSequence = SpawnTestNode<UK2Node_ConditionalSequence>(Graph);
+				DefaultExecPin = ConditionalSequence->GetDefaultExecPin();
+				Node = ConditionalSequence;
+			}
+			for (int32 Index = 0; Index < Conditions.Num(); ++Index)
+			{
+				Node->AddCasePinLast();
+			}
+
+			bSucceeded &= Connect(EntryThenPin, Node->GetExecPin());
+			TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+			for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+			{
+				ConnectCondition(Index, CasePairs[Index].Key);
+				bSucceeded &= Connect(CasePairs[Index].Value, SpawnResultVariableSet(Graph, Index)->GetExecPin());
+			}
+			if (NodeType == ETestNodeType::MultiBranch)
+			{
+				bSucceeded &= Connect(DefaultExecPin, SpawnResultVariableSet(Graph, -1)->GetExecPin());
+			}
+			break;
+		}
+		case ETestNodeType::MultiConditionalSelect:
+		{
+			UK2Node_MultiConditionalSelect* MultiConditionalSelect = SpawnTestNode<UK2Node_MultiConditionalSelect>(Graph);
+			for (int32 Index = MultiConditionalSelect->GetCasePinCount(); Index < Conditions.Num(); ++Index)
+			{
+				MultiConditionalSelect->AddCasePinLast();
+			}
+
+			// Wildcard pins are resolved to int by the first connection.
+			bSucceeded &= Connect(SpawnVariableGet(Graph, DefaultValueVariableName), MultiConditionalSelect->GetDefaultOptionPin());
+			TArray<CasePinPair> CasePairs = MultiConditionalSelect->GetCasePinPairs();
+			for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+			{
+				GetDefault<UEdGraphSchema_K2>()->TrySetDefaultValue(*CasePairs[Index].Key, FString::FromInt(Index));
+				ConnectCondition(Index, CasePairs[Index].Value);
+			}
+
+			UK2Node_VariableSet* ResultSet = SpawnResultVariableSet(Graph, 0);
+			bSucceeded &= Connect(EntryThenPin, ResultSet->GetExecPin());
+			bSucceeded &=
+				Connect(MultiConditionalSelect->GetReturnValuePin(), ResultSet->FindPinChecked(ResultVariableName, EGPD_Input));
+			break;
+		}
+		default:
+			return false;
+	}
+
+	return bSucceeded;
+}
+
+bool BuildConditionalSequenceSnapshotFunctionGraph(UBlueprint* Blueprint, const FTestFunctionGraph& Function, int32 CaseCount,
+	bool bSnapshotConditions, bool bShareCondition)
+{
+	UEdGraph* Graph = Function.Graph;
+	UEdGraphPin* EntryThenPin = Function.Entry->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+	bool bSucceeded = true;
+
+	UK2Node_ConditionalSequence* ConditionalSequence = SpawnTestNode<UK2Node_ConditionalSequence>(Graph);
+	ConditionalSequence->bSnapshotConditions = bSnapshotConditions;
+	for (int32 Index = 0; Index < CaseCount; ++Index)
+	{
+		ConditionalSequence->AddCasePinLast();
+	}
+
+	bSucceeded &= Connect(EntryThenPin, ConditionalSequence->GetExecPin());
+	TArray<CasePinPair> CasePairs = ConditionalSequence->GetCasePinPairs();
+	UK2Node_CallFunction* LessNode = nullptr;
+	for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+	{
+		if ((LessNode == nullptr) || !bShareCondition)
+		{
+			FGraphNodeCreator<UK2Node_CallFunction> NodeCreator(*Graph);
+			LessNode = NodeCreator.CreateNode(false);
+			LessNode->SetFromFunction(UKismetMathLibrary::StaticClass()->FindFunctionByName(TEXT("Less_IntInt")));
+			NodeCreator.Finalize();
+			GetDefault<UEdGraphSchema_K2>()->TrySetDefaultValue(*LessNode->FindPinChecked(TEXT("B")), TEXT("0"));
+
+			bSucceeded &= Connect(SpawnVariableGet(Graph, ResultVariableName), LessNode->FindPin(TEXT("A")));
+		}
+		bSucceeded &= Connect(LessNode->GetReturnValuePin(), CasePairs[Index].Key);
+		bSucceeded &= Connect(CasePairs[Index].Value, SpawnResultVariableSet(Graph, Index)->GetExecPin());
+	}
+
+	return bSucceeded;
+}
+
+bool BuildMultiBranchOnBitmaskFunctionGraph(UBlueprint* Blueprint, const FTestFunctionGraph& Function, const TArray<int32>& Bits)
+{
+	UEdGraph* Graph = Function.Graph;
+	UEdGraphPin* EntryThenPin = Function.Entry->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+	bool bSucceeded = true;
+
+	UK2Node_MultiBranchOnBitmask* MultiBranchOnBitmask = SpawnTestNode<UK2Node_MultiBranchOnBitmask>(Graph);
+	for (int32 Index = 0; Index < Bits.Num(); ++Index)
+	{
+		MultiBranchOnBitmask->AddCasePinLast();
+	}
+
+	// Wildcard pin is resolved to int by the connection.
+	bSucceeded &= Connect(EntryThenPin, MultiBranchOnBitmask->GetExecPin());
+	bSucceeded &= Connect(SpawnVariableGet(Graph, SelectionVariableName), MultiBranchOnBitmask->GetMaskPin());
+	TArray<CasePinPair> CasePairs = MultiBranchOnBitmask->GetCasePinPairs();
+	for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+	{
+		GetDefault<UEdGraphSchema_K2>()->TrySetDefaultValue(*CasePairs[Index].Key, FString::FromInt(Bits[Index]));
+		bSucceeded &= Connect(CasePairs[Index].Value, SpawnResultVariableSet(Graph, Index)->GetExecPin());
+	}
+	bSucceeded &= Connect(MultiBranchOnBitmask->GetDefaultExecPin(), SpawnResultVariableSet(Graph, -1)->GetExecPin());
+
+	return bSucceeded;
+}
+
+bool BuildMultiBranchOnNameFunctionGraph(UBlueprint* Blueprint, const FTestFunctionGraph& Function, const TArray<FString>& Keys)
+{
+	UEdGraph* Graph = Function.Graph;
+	UEdGraphPin* EntryThenPin = Function.Entry->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+	bool bSucceeded = true;
+
+	UK2Node_MultiBranchOnName* MultiBranchOnName = SpawnTestNode<UK2Node_MultiBranchOnName>(Graph);
+	for (int32 Index = 0; Index < Keys.Num(); ++Index)
+	{
+		MultiBranchOnName->AddCasePinLast();
+	}
+
+	// Wildcard pin is resolved to name or string by the connection.
+	bSucceeded &= Connect(EntryThenPin, MultiBranchOnName->GetExecPin());
+	bSucceeded &= Connect(SpawnVariableGet(Graph, SelectionVariableName), MultiBranchOnName->GetSelectionPin());
+	TArray<CasePinPair> CasePairs = MultiBranchOnName->GetCasePinPairs();
+	for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+	{
+		GetDefault<UEdGraphSchema_K2>()->TrySetDefaultValue(*CasePairs[Index].Key, Keys[Index]);
+		bSucceeded &= Connect(CasePairs[Index].Value, SpawnResultVariableSet(Graph, Index)->GetExecPin());
+	}
+	bSucceeded &= Connect(MultiBranchOnName->GetDefaultExecPin(), SpawnResultVariableSet(Graph, -1)->GetExecPin());
+
+	return bSucceeded;
+}
+
+static UK2Node_CallFunction* SpawnCallFunction(UEdGraph* Graph, UClass* FunctionClass, const FName& FunctionName)
+{
+	FGraphNodeCreator<UK2Node_CallFunction> NodeCreator(*Graph);
+	UK2Node_CallFunction* Node = NodeCreator.CreateNode(false);
+	Node->SetFromFunction(FunctionClass->FindFunctionByName(FunctionName));
+	NodeCreator.Finalize();
+
+	return Node;
+}
+
+static UK2Node_CallFunction* SpawnCountCall(UEdGraph* Graph, int32 Key)
+{
+	UK2Node_CallFunction* Node = SpawnCallFunction(Graph, UFunctionalTestThreadSafeLibrary::StaticClass(),
+		GET_FUNCTION_NAME_CHECKED(UFunctionalTestThreadSafeLibrary, CountCall));
+	GetDefault<UEdGraphSchema_K2>()->TrySetDefaultValue(*Node->FindPinChecked(TEXT("Key")), FString::FromInt(Key));
+
+	return Node;
+}
+
+bool BuildParallelConditionalSequenceFunctionGraph(
+	UBlueprint* Blueprint, const FTestFunctionGraph& Function, const TArray<ETestCaseFunction>& CaseFunctions)
+{
+	UEdGraph* Graph = Function.Graph;
+	UEdGraphPin* EntryThenPin = Function.Entry->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+	bool bSucceeded = true;
+
+	for (int32 Index = 0; Index < CaseFunctions.Num(); ++Index)
+	{
+		FTestFunctionGraph CaseFunction = AddTestFunctionGraph(Blueprint, GetCaseFunctionName(Index));
+		if (CaseFunction.Entry == nullptr)
+		{
+			return false;
+		}
+		CaseFunction.Entry->MetaData.bThreadSafe = CaseFunctions[Index] != ETestCaseFunction::NotThreadSafe;
+
+		UK2Node* CaseNode = nullptr;
+		switch (CaseFunctions[Index])
+		{
+			case ETestCaseFunction::ThreadSafe:
+				CaseNode = SpawnCountCall(CaseFunction.Graph, Index);
+				break;
+			case ETestCaseFunction::NotThreadSafe:
+			case ETestCaseFunction::ThreadSafeWritingMember:
+				CaseNode = SpawnIntVariableSet(CaseFunction.Graph, GetCaseFunctionHitVariableName(Index), 1);
+				break;
+			case ETestCaseFunction::ThreadSafeCallingNotThreadSafe:
+				CaseNode = SpawnCallFunction(CaseFunction.Graph, UKismetSystemLibrary::StaticClass(),
+					GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, CollectGarbage));
+				break;
+			case ETestCaseFunction::ThreadSafeWithParameter:
+				CaseFunction.Entry->CreateUserDefinedPin(
+					TEXT("Parameter"), MakeTestPinType(UEdGraphSchema_K2::PC_Int), EGPD_Output);
+				CaseNode = SpawnCountCall(CaseFunction.Graph, Index);
+				break;
+		}
+		bSucceeded &= Connect(CaseFunction.Entry->FindPinChecked(UEdGraphSchema_K2::PN_Then), CaseNode->GetExecPin());
+	}
+
+	UK2Node_ParallelConditionalSequence* ParallelConditionalSequence = SpawnTestNode<UK2Node_ParallelConditionalSequence>(Graph);
+	for (int32 Index = 0; Index < CaseFunctions.Num(); ++Index)
+	{
+		ParallelConditionalSequence->AddCasePinLast();
+	}
+
+	bSucceeded &= Connect(EntryThenPin, ParallelConditionalSequence->GetExecPin());
+	TArray<CasePinPair> CasePairs = ParallelConditionalSequence->GetCasePinPairs();
+	for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+	{
+		bSucceeded &= Connect(SpawnVariableGet(Graph, GetConditionVariableName(Index)), CasePairs[Index].Key);
+		CasePairs[Index].Value->DefaultValue = GetCaseFunctionName(Index).ToString();
+	}
+	bSucceeded &= Connect(
+		ParallelConditionalSequence->GetDefaultExecPin(), SpawnResultVariableSet(Graph, CasePairs.Num())->GetExecPin());
+
+	return bSucceeded;
+}
+
+bool BuildCountCallFunctionOverrideGraph(UBlueprint* Blueprint, const FName& FunctionName, int32 Key)
+{
+	UEdGraph* Graph =
+		FBlueprintEditorUtils::CreateNewGraph(Blueprint, FunctionName, UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
+	FBlueprintEditorUtils::AddFunctionGraph<UClass>(Blueprint, Graph, false, Blueprint->ParentClass);
+
+	TArray<UK2Node_FunctionEntry*> Entries;
+	Graph->GetNodesOfClass(Entries);
+	if (Entries.Num() != 1)
+	{
+		return false;
+	}
+	Entries[0]->MetaData.bThreadSafe = true;
+
+	return Connect(Entries[0]->FindPinChecked(UEdGraphSchema_K2::PN_Then), SpawnCountCall(Graph, Key)->GetExecPin());
+}
+
+static bool BuildMultiBranchOnChangeGraph(
+	UEdGraph* Graph, UEdGraphPin* ThenPin, int32 CaseCount, const TArray<FName>& WatchedFields)
+{
+	bool bSucceeded = true;
+
+	UK2Node_MultiBranchOnChange* MultiBranchOnChange = SpawnTestNode<UK2Node_MultiBranchOnChange>(Graph);
+	MultiBranchOnChange->WatchedFields = WatchedFields;
+	for (int32 Index = 0; Index < CaseCount; ++Index)
+	{
+		MultiBranchOnChange->AddCasePinLast();
+	}
+
+	bSucceeded &= Connect(ThenPin, MultiBranchOnChange->GetExecPin());
+	TArray<CasePinPair> CasePairs = MultiBranchOnChange->GetCasePinPairs();
+	for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+	{
+		bSucceeded &= Connect(SpawnVariableGet(Graph, GetConditionVariableName(Index)), CasePairs[Index].Key);
+		bSucceeded &= Connect(CasePairs[Index].Value, SpawnResultVariableSet(Graph, Index)->GetExecPin());
+	}
+	bSucceeded &=
+		Connect(MultiBranchOnChange->GetDefaultExecPin(), SpawnResultVariableSet(Graph, CasePairs.Num())->GetExecPin());
+
+	return bSucceeded;
+}
+
+bool BuildMultiBranchOnChangeEventGraph(
+	UBlueprint* Blueprint, const FName& EventName, int32 CaseCount, const TArray<FName>& WatchedFields)
+{
+	UEdGraph* Graph = FBlueprintEditorUtils::FindEventGraph(Blueprint);
+	if (Graph == nullptr)
+	{
+		return false;
+	}
+
+	FGraphNodeCreator<UK2Node_CustomEvent> NodeCreator(*Graph);
+	UK2Node_CustomEvent* CustomEvent = NodeCreator.CreateNode(false);
+	CustomEvent->CustomFunctionName = EventName;
+	NodeCreator.Finalize();
+
+	return BuildMultiBranchOnChangeGraph(
+		Graph, CustomEvent->FindPinChecked(UEdGraphSchema_K2::PN_Then), CaseCount, WatchedFields);
+}
+
+bool BuildMultiBranchOnChangeFunctionGraph(
+	UBlueprint* Blueprint, const FTestFunctionGraph& Function, int32 CaseCount, const TArray<FName>& WatchedFields)
+{
+	return BuildMultiBranchOnChangeGraph(
+		Function.Graph, Function.Entry->FindPinChecked(UEdGraphSchema_K2::PN_Then), CaseCount, WatchedFields);
+}
+
+bool BuildMultiBranchOnValueChainFunctionGraph(
+	UBlueprint* Blueprint, const FTestFunctionGraph& Function, int32 NodeCount, int32 CaseCount)
+{
+	UEdGraph* Graph = Function.Graph;
+	UEdGraphPin* PrevDefaultExecPin = Function.Entry->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+	bool bSucceeded = true;
+
+	for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex)
+	{
+		UK2Node_MultiBranchOnValue* MultiBranchOnValue = SpawnTestNode<UK2Node_MultiBranchOnValue>(Graph);
+		for (int32 Index = 0; Index < CaseCount; ++Index)
+		{
+			MultiBranchOnValue->AddCasePinLast();
+		}
+
+		bSucceeded &= Connect(PrevDefaultExecPin, MultiBranchOnValue->GetExecPin());
+		bSucceeded &= Connect(SpawnVariableGet(Graph, SelectionVariableName), MultiBranchOnValue->GetSelectionPin());
+		TArray<CasePinPair> CasePairs = MultiBranchOnValue->GetCasePinPairs();
+		for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+		{
+			const int32 Key = NodeIndex * CaseCount + Index;
+			GetDefault<UEdGraphSchema_K2>()->TrySetDefaultValue(*CasePairs[Index].Key, FString::FromInt(Key));
+			bSucceeded &= Connect(CasePairs[Index].Value, SpawnResultVariableSet(Graph, Key)->GetExecPin());
+		}
+
+		PrevDefaultExecPin = MultiBranchOnValue->GetDefaultExecPin();
+	}
+
+	return bSucceeded;
+}
+
+bool BuildVanillaFunctionGraph(UBlueprint* Blueprint, const FTestFunctionGraph& Function, ETestNodeType NodeType, int32 CaseCount)
+{
+	UEdGraph* Graph = Function.Graph;
+	UEdGraphPin* EntryThenPin = Function.Entry->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+	bool bSucceeded = true;
+
+	switch (NodeType)
+	{
+		case ETestNodeType::MultiBranch:
+		{
+			// Branch chain connected with Else pin.
+			UEdGraphPin* PrevElsePin = EntryThenPin;
+			for (int32 Index = 0; Index < CaseCount; ++Index)
+			{
+				UK2Node_IfThenElse* Branch = SpawnTestNode<UK2Node_IfThenElse>(Graph);
+				bSucceeded &= Connect(PrevElsePin, Branch->GetExecPin());
+				bSucceeded &= Connect(SpawnVariableGet(Graph, GetConditionVariableName(Index)), Branch->GetConditionPin());
+				bSucceeded &= Connect(Branch->GetThenPin(), SpawnResultVariableSet(Graph, Index)->GetExecPin());
+				PrevElsePin = Branch->GetElsePin();
+			}
+			break;
+		}
+		case ETestNodeType::ConditionalSequence:
+		{
+			// Sequence whose outputs are connected to Branch.
+			UK2Node_ExecutionSequence* Sequence = SpawnTestNode<UK2Node_ExecutionSequence>(Graph);
+			for (int32 Index = 2; Index < CaseCount; ++Index)
+			{
+				Sequence->AddInputPin();
+			}
+
+			bSucceeded &= Connect(EntryThenPin, Sequence->GetExecPin());
+			for (int32 Index = 0; Index < CaseCount; ++Index)
+			{
+				UK2Node_IfThenElse* Branch = SpawnTestNode<UK2Node_IfThenElse>(Graph);
+				bSucceeded &= Connect(Sequence->GetThenPinGivenIndex(Index), Branch->GetExecPin());
+				bSucceeded &= Connect(SpawnVariableGet(Graph, GetConditionVariableName(Index)), Branch->GetConditionPin());
+				bSucceeded &= Connect(Branch->GetThenPin(), SpawnResultVariableSet(Graph, Index)->GetExecPin());
+			}
+			break;
+		}
+		case ETestNodeType::MultiConditionalSelect:
+		{
+			// Nested Select whose index is the condition, from the last case to the first case.
+			UEdGraphPin* PrevReturnValuePin = SpawnVariableGet(Graph, DefaultValueVariableName);
+			for (int32 Index = CaseCount - 1; Index >= 0; --Index)
+			{
+				UK2Node_Select* Select = SpawnTestNode<UK2Node_Select>(Graph);
+				bSucceeded &= Connect(SpawnVariableGet(Graph, GetConditionVariableName(Index)), Select->GetIndexPin());
+
+				TArray<UEdGraphPin*> OptionPins;
+				Select->GetOptionPins(OptionPins);
+				bSucceeded &= OptionPins.Num() == 2;
+				if (OptionPins.Num() != 2)
+				{
+					break;
+				}
+				bSucceeded &= Connect(PrevReturnValuePin, OptionPins[0]);
+				GetDefault<UEdGraphSchema_K2>()->TrySetDefaultValue(*OptionPins[1], FString::FromInt(Index));
+
+				PrevReturnValuePin = Select->GetReturnValuePin();
+			}
+
+			UK2Node_VariableSet* ResultSet = SpawnResultVariableSet(Graph, 0);
+			bSucceeded &= Connect(EntryThenPin, ResultSet->GetExecPin());
+			bSucceeded &= Connect(PrevReturnValuePin, ResultSet->FindPinChecked(ResultVariableName, EGPD_Input));
+			break;
+		}
+		case ETestNodeType::MultiBranchOnValue:
+		{
+			UK2Node_SwitchInteger* Switch = SpawnTestNode<UK2Node_SwitchInteger>(Graph);
+			for (int32 Index = 0; Index < CaseCount; ++Index)
+			{
+				Switch->AddPinToSwitchNode();
+			}
+
+			bSucceeded &= Connect(EntryThenPin, Switch->GetExecPin());
+			bSucceeded &= Connect(SpawnVariableGet(Graph, SelectionVariableName), Switch->GetSelectionPin());
+			for (int32 Index = 0; Index < CaseCount; ++Index)
+			{
+				UEdGraphPin* CasePin = Switch->FindPin(FString::FromInt(Index), EGPD_Output);
+				bSucceeded &= Connect(CasePin, SpawnResultVariableSet(Graph, Index)->GetExecPin());
+			}
+			bSucceeded &= Connect(Switch->GetDefaultPin(), SpawnResultVariableSet(Graph, -1)->GetExecPin());
+			break;
+		}
+		case ETestNodeType::MultiBranchOnBitmask:
+		{
+			// Branch chain connected with Else pin, whose conditions are "(Selection & (1 << Bit)) != 0".
+			UEdGraphPin* PrevElsePin = EntryThenPin;
+			for (int32 Index = 0; Index < CaseCount; ++Index)
+			{
+				UK2Node_CallFunction* AndNode = SpawnCallFunction(
+					Graph, UKismetMathLibrary::StaticClass(), GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, And_IntInt));
+				bSucceeded &= Connect(SpawnVariableGet(Graph, SelectionVariableName), AndNode->FindPin(TEXT("A")));
+				GetDefault<UEdGraphSchema_K2>()->TrySetDefaultValue(
+					*AndNode->FindPinChecked(TEXT("B")), FString::FromInt(static_cast<int32>(1u << GetBenchmarkCaseBit(Index))));
+				UK2Node_CallFunction* NotEqualNode = SpawnCallFunction(
+					Graph, UKismetMathLibrary::StaticClass(), GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, NotEqual_IntInt));
+				bSucceeded &= Connect(AndNode->GetReturnValuePin(), NotEqualNode->FindPin(TEXT("A")));
+
+				UK2Node_IfThenElse* Branch = SpawnTestNode<UK2Node_IfThenElse>(Graph);
+				bSucceeded &= Connect(PrevElsePin, Branch->GetExecPin());
+				bSucceeded &= Connect(NotEqualNode->GetReturnValuePin(), Branch->GetConditionPin());
+				bSucceeded &= Connect(Branch->GetThenPin(), SpawnResultVariableSet(Graph, Index)->GetExecPin());
+				PrevElsePin = Branch->GetElsePin();
+			}
+			bSucceeded &= Connect(PrevElsePin, SpawnResultVariableSet(Graph, -1)->GetExecPin());
+			break;
+		}
+		case ETestNodeType::MultiBranchOnName:
+		{
+			UK2Node_SwitchName* Switch = SpawnTestNode<UK2Node_SwitchName>(Graph);
+			for (int32 Index = 0; Index < CaseCount; ++Index)
+			{
+				Switch->PinNames.Add(GetBenchmarkCaseKey(Index));
+			}
+			Switch->ReconstructNode();
+
+			bSucceeded &= Connect(EntryThenPin, Switch->GetExecPin());
+			bSucceeded &= Connect(SpawnVariableGet(Graph, SelectionVariableName), Switch->GetSelectionPin());
+			for (int32 Index = 0; Index < CaseCount; ++Index)
+			{
+				UEdGraphPin* CasePin = Switch->FindPin(GetBenchmarkCaseKey(Index), EGPD_Output);
+				bSucceeded &= Connect(CasePin, SpawnResultVariableSet(Graph, Index)->GetExecPin());
+			}
+			bSucceeded &= Connect(Switch->GetDefaultPin(), SpawnResultVariableSet(Graph, -1)->GetExecPin());
+			break;
+		}
+		case ETestNodeType::ParallelConditionalSequence:
+		{
+			// Sequence whose outputs are connected to Branch calling the case, and the last output to the default.
+			UK2Node_ExecutionSequence* Sequence = SpawnTestNode<UK2Node_ExecutionSequence>(Graph);
+			for (int32 Index = 2; Index <= CaseCount; ++Index)
+			{
+				Sequence->AddInputPin();
+			}
+
+			bSucceeded &= Connect(EntryThenPin, Sequence->GetExecPin());
+			for (int32 Index = 0; Index < CaseCount; ++Index)
+			{
+				UK2Node_IfThenElse* Branch = SpawnTestNode<UK2Node_IfThenElse>(Graph);
+				bSucceeded &= Connect(Sequence->GetThenPinGivenIndex(Index), Branch->GetExecPin());
+				bSucceeded &= Connect(SpawnVariableGet(Graph, GetConditionVariableName(Index)), Branch->GetConditionPin());
+				bSucceeded &= Connect(Branch->GetThenPin(), SpawnCountCall(Graph, Index)->GetExecPin());
+			}
+			bSucceeded &=
+				Connect(Sequence->GetThenPinGivenIndex(CaseCount), SpawnResultVariableSet(Graph, CaseCount)->GetExecPin());
+			break;
+		}
+	}
+
+	return bSucceeded;
+}
+
+UBlueprint* CreateBenchmarkBlueprint(ETestNodeType NodeType, int32 CaseCount, bool bWithVanilla)
+{
+	UBlueprint* Blueprint = CreateTestBlueprint(FString::Printf(TEXT("BP_Bench_%s_%d"), *GetTestNodeTypeName(NodeType), CaseCount));
+	if (Blueprint == nullptr)
+	{
+		return nullptr;
+	}
+
+	FEdGraphPinType BoolPinType;
+	BoolPinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+	FEdGraphPinType IntPinType;
+	IntPinType.PinCategory = UEdGraphSchema_K2::PC_Int;
+
+	for (int32 Index = 0; Index < CaseCount; ++Index)
+	{
+		const bool bIsTrue = Index == CaseCount - 1;
+		FBlueprintEditorUtils::AddMemberVariable(
+			Blueprint, GetConditionVariableName(Index), BoolPinType, bIsTrue ? TEXT("true") : TEXT("false"));
+	}
+	FBlueprintEditorUtils::AddMemberVariable(Blueprint, ResultVariableName, IntPinType);
+	FBlueprintEditorUtils::AddMemberVariable(Blueprint, DefaultValueVariableName, IntPinType, TEXT("-1"));
+	switch (NodeType)
+	{
+		case ETestNodeType::MultiBranchOnBitmask:
+		{
+			// The highest bit which is mapped to a case.
+			const uint32 Mask = 1u << FMath::Min(CaseCount - 1, 31);
+			FBlueprintEditorUtils::AddMemberVariable(
+				Blueprint, SelectionVariableName, IntPinType, FString::FromInt(static_cast<int32>(Mask)));
+			break;
+		}
+		case ETestNodeType::MultiBranchOnName:
+		{
+			FEdGraphPinType NamePinType;
+			NamePinType.PinCategory = UEdGraphSchema_K2::PC_Name;
+			FBlueprintEditorUtils::AddMemberVariable(
+				Blueprint, SelectionVariableName, NamePinType, GetBenchmarkCaseKey(CaseCount - 1).ToString());
+			break;
+		}
+		default:
+			FBlueprintEditorUtils::AddMemberVariable(
+				Blueprint, SelectionVariableName, IntPinType, FString::FromInt(CaseCount - 1));
+			break;
+	}
+
+	FTestFunctionGraph PluginFunction = AddTestFunctionGraph(Blueprint, BenchmarkPluginFunctionName);
+	if ((PluginFunction.Entry == nullptr) || !BuildPluginFunctionGraph(Blueprint, PluginFunction, NodeType, CaseCount))
+	{
+		return nullptr;
+	}
+	if (bWithVanilla)
+	{
+		FTestFunctionGraph VanillaFunction = AddTestFunctionGraph(Blueprint, BenchmarkVanillaFunctionName);
+		if ((VanillaFunction.Entry == nullptr) || !BuildVanillaFunctionGraph(Blueprint, VanillaFunction, NodeType, CaseCount))
+		{
+			return nullptr;
+		}
+	}
+
+	return Blueprint;
+}
+
+UBlueprint* BuildBenchmarkBlueprint(ETestNodeType NodeType, int32 CaseCount)
+{
+	UBlueprint* Blueprint = CreateBenchmarkBlueprint(NodeType, CaseCount);
+	if ((Blueprint == nullptr) || !CompileTestBlueprint(Blueprint))
+	{
+		return nullptr;
+	}
+
+	return Blueprint;
+}
+
+#endif
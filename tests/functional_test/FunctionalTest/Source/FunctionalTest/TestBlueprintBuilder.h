@@ -0,0 +1,226 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITOR
+
+#include "EdGraph/EdGraphPin.h"
+#include "Templates/Function.h"
+#include "UObject/UnrealType.h"
+
+class FAutomationTestBase;
+class FCompilerResultsLog;
+class UBlueprint;
+class UEdGraph;
+class UEdGraphPin;
+class UK2Node_FunctionEntry;
+enum class EMultiBranchOnValueCompareMode : uint8;
+
+enum class ETestNodeType : uint8
+{
+	MultiBranch,
+	ConditionalSequence,
+	MultiConditionalSelect,
+	MultiBranchOnValue,
+	MultiBranchOnBitmask,
+	MultiBranchOnName,
+	ParallelConditionalSequence,
+};
+
+struct FTestFunctionGraph
+{
+	UEdGraph* Graph = nullptr;
+	UK2Node_FunctionEntry* Entry = nullptr;
+};
+
+// Name of the benchmark functions built by BuildBenchmarkBlueprint.
+extern const FName BenchmarkPluginFunctionName;
+extern const FName BenchmarkVanillaFunctionName;
+
+FString GetTestNodeTypeName(ETestNodeType NodeType);
+
+UBlueprint* CreateTestBlueprint(const FString& Name, UClass* ParentClass = UObject::StaticClass());
+FTestFunctionGraph AddTestFunctionGraph(UBlueprint* Blueprint, const FName& FunctionName);
+bool CompileTestBlueprint(UBlueprint* Blueprint, FCompilerResultsLog* OutResults = nullptr);
+
+// Name of the bool variable which the case Index reads the condition from.
+FName GetConditionVariableName(int32 CaseIndex);
+
+// Name of the int variable which Multi-Branch on Value branches on.
+extern const FName SelectionVariableName;
+
+// Name of the int variable which the case executions write to.
+extern const FName ResultVariableName;
+
+// Name of the int variable which Multi-Conditional Select returns if no condition is true.
+extern const FName DefaultValueVariableName;
+
+// Member variable which the test Blueprint is created with.
+struct FTestMemberVariable
+{
+	FName Name;
+	FEdGraphPinType PinType;
+	FString DefaultValue;
+};
+
+FEdGraphPinType MakeTestPinType(const FName& PinCategory, EPinContainerType ContainerType = EPinContainerType::None);
+
+// Member variables GetName(Index) of the pin type for CaseCount cases (ex. "Cond_<Index>").
+TArray<FTestMemberVariable> MakeCaseMemberVariables(int32 CaseCount, FName (*GetName)(int32), const FEdGraphPinType& PinType);
+
+// Same as CreateTestBlueprint, but the member variables are added.
+UBlueprint* CreateTestBlueprintWithMembers(
+	const FString& Name, const TArray<FTestMemberVariable>& Members, UClass* ParentClass = UObject::StaticClass());
+
+// Object of the compiled test Blueprint, which calls the test function and accesses the member variables.
+struct FTestBlueprintInstance
+{
+	UObject* Object = nullptr;
+	UFunction* Function = nullptr;
+
+	// Return the property of the member variable, whose existence is checked by InstantiateTestBlueprint.
+	template <typename PropertyType>
+	PropertyType* GetMemberProperty(const FName& Name) const
+	{
+		return CastFieldChecked<PropertyType>(FindFProperty<FProperty>(Object->GetClass(), Name));
+	}
+
+	// Set the bit Index of the bits to "Cond_<Index>" for CaseCount cases.
+	void SetConditions(int32 CaseCount, int32 Bits) const;
+	// Set the value to "Selection", which is the int, name or string variable.
+	void SetSelection(int32 Selection) const;
+	void SetSelection(const FString& Selection) const;
+	int32 GetResult() const;
+	void SetResult(int32 Result) const;
+	void Call() const;
+};
+
+// Instantiate the generated class of the compiled Blueprint, and find the test function.
+// Return false and add the error to the test if the generated class does not have the function or any of the members.
+bool InstantiateTestBlueprint(FAutomationTestBase* AutomationTest, UBlueprint* Blueprint, const FName& FunctionName,
+	const TArray<FTestMemberVariable>& Members, FTestBlueprintInstance& OutInstance);
+
+// Dispatch test of the node, which calls the test function for each input and compares "Result" with the expected one.
+struct FTestDispatchTable
+{
+	FString BlueprintName;
+	TArray<FTestMemberVariable> Members;
+	// Build the test function graph with the node, whose case executions set the case index to "Result".
+	TFunction<bool(UBlueprint* Blueprint, const FTestFunctionGraph& Function)> BuildFunctionGraph;
+	// Set the input Index to the instance, and return its description for the test message.
+	int32 InputCount = 0;
+	TFunction<FString(const FTestBlueprintInstance& Instance, int32 InputIndex)> SetInput;
+	// Return the expected "Result" for the input Index (ex. the case index, or -1 if the default execution is taken).
+	TFunction<int32(int32 InputIndex)> GetExpectedResult;
+	// "Result" set before each call, which remains if no execution sets it.
+	int32 InitialResult = -2;
+	// Number of the compiles before the calls (ex. 2 to check that nothing of the previous compile is referred).
+	int32 CompileCount = 1;
+};
+
+// Create the Blueprint, build and compile the test function of the table, and check the result for each input.
+// The compiler results are added to OutResults and the compiled Blueprint is set to OutBlueprint if they are not nullptr.
+// Return false if the Blueprint fails to be built, compiled or instantiated.
+bool RunTestDispatchTable(FAutomationTestBase* AutomationTest, const FTestDispatchTable& Table,
+	FCompilerResultsLog* OutResults = nullptr, UBlueprint** OutBlueprint = nullptr);
+
+// Build the function graph which uses the plugin node with CaseCount cases.
+// Conditions are read from the bool variables "Cond_<Index>" and the case executions set the int variable "Result".
+// Multi-Branch on Bitmask maps the case Index to the bit Index % 32 of "Selection", Multi-Branch on Name maps it to the key
+// "Case_<Index>", and Parallel Conditional Sequence calls the thread safe case functions "CaseFunction_<Index>".
+bool BuildPluginFunctionGraph(UBlueprint* Blueprint, const FTestFunctionGraph& Function, ETestNodeType NodeType, int32 CaseCount);
+
+// Build the function graph which uses Multi-Branch on Value with the case keys.
+// The value is read from the int variable "Selection" and the case executions set the case index to "Result".
+bool BuildMultiBranchOnValueFunctionGraph(UBlueprint* Blueprint, const FTestFunctionGraph& Function,
+	EMultiBranchOnValueCompareMode CompareMode, const TArray<int32>& Keys);
+
+// Same as BuildPluginFunctionGraph for Multi-Branch, Conditional Sequence and Multi-Conditional Select, but the case Index
+// has the literal condition Conditions[Index] ("true" or "false") instead of "Cond_<Index>" if it is not empty.
+// Multi-Conditional Select reads the default from the int variable "DefaultValue".
+bool BuildLiteralConditionFunctionGraph(
+	UBlueprint* Blueprint, const FTestFunctionGraph& Function, ETestNodeType NodeType, const TArray<FString>& Conditions);
+
+// Name of the array variable which Multi-Conditional Select reads the option Index from.
+FName GetArrayOptionVariableName(int32 CaseIndex);
+
+// Name of the array variables which Multi-Conditional Select reads the default from and the selected option is set to.
+extern const FName DefaultArrayVariableName;
+extern const FName ResultArrayVariableName;
+
+// Build the function graph which uses Multi-Conditional Select on the arrays "ArrayOption_<Index>" and "DefaultArray".
+// Conditions are read from "Cond_<Index>", and the selected array is set to "ResultArray".
+// If bElementWise is true, the node is on element-wise mode and "Cond_<Index>" must be the bool arrays.
+bool BuildMultiConditionalSelectArrayFunctionGraph(
+	UBlueprint* Blueprint, const FTestFunctionGraph& Function, int32 CaseCount, bool bElementWise = false);
+
+// Build the function graph which uses Conditional Sequence whose conditions are all "Result < 0" (pure node).
+// Each case execution sets the case index to "Result", so the later conditions become false unless they are snapshotted.
+// If bShareCondition is true, all conditions are connected to the same pure node.
+bool BuildConditionalSequenceSnapshotFunctionGraph(UBlueprint* Blueprint, const FTestFunctionGraph& Function, int32 CaseCount,
+	bool bSnapshotConditions, bool bShareCondition = false);
+
+// Build the function graph which uses Multi-Branch on Bitmask with the case bits.
+// The mask is read from the int variable "Selection" and the case executions set the case index to "Result".
+bool BuildMultiBranchOnBitmaskFunctionGraph(UBlueprint* Blueprint, const FTestFunctionGraph& Function, const TArray<int32>& Bits);
+
+// Build the function graph which uses Multi-Branch on Name with the case keys.
+// The value is read from the name or string variable "Selection" and the case executions set the case index to "Result".
+bool BuildMultiBranchOnNameFunctionGraph(UBlueprint* Blueprint, const FTestFunctionGraph& Function, const TArray<FString>& Keys);
+
+// Name of the function which the case Index of Parallel Conditional Sequence calls.
+FName GetCaseFunctionName(int32 CaseIndex);
+
+// Name of the int variable which the case function Index sets to 1.
+FName GetCaseFunctionHitVariableName(int32 CaseIndex);
+
+enum class ETestCaseFunction : uint8
+{
+	// Marked as thread safe, and calls UFunctionalTestThreadSafeLibrary::CountCall with the case index.
+	ThreadSafe,
+	// Not marked as thread safe, and sets 1 to "Hit_<Index>".
+	NotThreadSafe,
+	// Marked as thread safe, but sets 1 to "Hit_<Index>" (must fail to compile).
+	ThreadSafeWritingMember,
+	// Marked as thread safe, but calls the function which is not thread safe (must fail to compile).
+	ThreadSafeCallingNotThreadSafe,
+	// Marked as thread safe, and calls UFunctionalTestThreadSafeLibrary::CountCall, but has a parameter (must fail to compile).
+	ThreadSafeWithParameter,
+};
+
+// Build the function graph which uses Parallel Conditional Sequence, and its case functions "CaseFunction_<Index>".
+// Conditions are read from "Cond_<Index>", and the default execution sets the number of the cases to "Result".
+bool BuildParallelConditionalSequenceFunctionGraph(
+	UBlueprint* Blueprint, const FTestFunctionGraph& Function, const TArray<ETestCaseFunction>& CaseFunctions);
+
+// Build the function graph which overrides the function of the parent Blueprint, and calls
+// UFunctionalTestThreadSafeLibrary::CountCall with the key. The override is marked as thread safe.
+bool BuildCountCallFunctionOverrideGraph(UBlueprint* Blueprint, const FName& FunctionName, int32 Key);
+
+// Build the custom event EventName on the event graph, which uses Multi-Branch on Change with CaseCount cases watching the
+// fields of self. Conditions are read from "Cond_<Index>", the case executions set the case index to "Result", and the default
+// execution sets the number of the cases to "Result".
+bool BuildMultiBranchOnChangeEventGraph(
+	UBlueprint* Blueprint, const FName& EventName, int32 CaseCount, const TArray<FName>& WatchedFields);
+
+// Same as BuildMultiBranchOnChangeEventGraph, but on the function graph (which must fail to compile).
+bool BuildMultiBranchOnChangeFunctionGraph(
+	UBlueprint* Blueprint, const FTestFunctionGraph& Function, int32 CaseCount, const TArray<FName>& WatchedFields);
+
+// Build the function graph which chains NodeCount Multi-Branch on Value nodes by their default execution pins.
+bool BuildMultiBranchOnValueChainFunctionGraph(
+	UBlueprint* Blueprint, const FTestFunctionGraph& Function, int32 NodeCount, int32 CaseCount);
+
+// Build the function graph which realizes the same logic with the vanilla Branch / Sequence / Select / Switch nodes.
+// Parallel Conditional Sequence is realized with Sequence and Branch on the calling thread.
+bool BuildVanillaFunctionGraph(UBlueprint* Blueprint, const FTestFunctionGraph& Function, ETestNodeType NodeType, int32 CaseCount);
+
+// Build the Blueprint which has both the plugin and the vanilla benchmark functions without compiling it.
+// Only the last condition is true (or the value matches the last case), which is the worst case for the dispatch.
+// If bWithVanilla is false, only the plugin function is built.
+UBlueprint* CreateBenchmarkBlueprint(ETestNodeType NodeType, int32 CaseCount, bool bWithVanilla = true);
+
+// Same as CreateBenchmarkBlueprint, but the Blueprint is compiled.
+UBlueprint* BuildBenchmarkBlueprint(ETestNodeType NodeType, int32 CaseCount);
+
+#endif